@@ -162,6 +162,8 @@ namespace
             const auto result = cache.get(key.mAgentHalfExtents, key.mTilePosition, key.mRecastMesh, key.mOffMeshConnections);
             benchmark::DoNotOptimize(result);
         }
+
+        state.SetItemsProcessed(state.iterations());
     }
 
     constexpr auto getFromFilledCache_1m_100hit = getFromFilledCache<1 * 1024 * 1024, 100>;
@@ -190,6 +192,8 @@ namespace
             const auto result = cache.set(key.mAgentHalfExtents, key.mTilePosition, key.mRecastMesh, key.mOffMeshConnections, NavMeshData());
             benchmark::DoNotOptimize(result);
         }
+
+        state.SetItemsProcessed(state.iterations());
     }
 
     constexpr auto setToBoundedNonEmptyCache_1m = setToBoundedNonEmptyCache<1 * 1024 * 1024>;
@@ -0,0 +1,319 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/compiler/streamerrorhandler.hpp>
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Local scripts in the style of the vanilla ones, limited to the parts of the language that
+    // do not need the game's extensions: state flags, timers, counters and branch chains
+    const char* const corpus[] = {
+        R"(Begin DoorTimerScript
+            short doOnce
+            short state
+            float timer
+            if ( doOnce == 0 )
+                set doOnce to 1
+                set timer to 0
+            endif
+            set timer to ( timer + 0.016 )
+            if ( state == 0 )
+                if ( timer > 5 )
+                    set state to 1
+                    set timer to 0
+                endif
+            elseif ( state == 1 )
+                if ( timer > 2.5 )
+                    set state to 0
+                endif
+            endif
+        End)",
+
+        R"(Begin QuestStageScript
+            short stage
+            short lastStage
+            long counter
+            if ( stage == lastStage )
+                set counter to ( counter + 1 )
+                return
+            endif
+            if ( stage < 10 )
+                set lastStage to 10
+            elseif ( stage < 20 )
+                set lastStage to 20
+            elseif ( stage < 30 )
+                set lastStage to 30
+            elseif ( stage < 40 )
+                set lastStage to 40
+            else
+                set lastStage to 100
+            endif
+            set stage to ( stage + 1 )
+            if ( stage > 100 )
+                set stage to 0
+            endif
+        End)",
+
+        R"(Begin DistanceCheckScript
+            float x
+            float y
+            float z
+            float distance
+            short inRange
+            set x to ( x + 1.5 )
+            set y to ( y - 0.5 )
+            set z to ( z * 1.01 )
+            set distance to ( ( x * x ) + ( y * y ) + ( z * z ) )
+            if ( distance > 1000000 )
+                set x to 0
+                set y to 0
+                set z to 1
+            endif
+            if ( distance < 512 * 512 )
+                set inRange to 1
+            else
+                set inRange to 0
+            endif
+        End)",
+
+        R"(Begin LoopScript
+            short index
+            long total
+            set index to 0
+            set total to 0
+            while ( index < 25 )
+                set total to ( total + ( index * 3 ) - 1 )
+                if ( total > 500 )
+                    set total to ( total / 2 )
+                endif
+                set index to ( index + 1 )
+            endwhile
+        End)",
+
+        R"(Begin FlagScript
+            short a
+            short b
+            short c
+            short result
+            set a to ( a + 1 )
+            if ( a > 3 )
+                set a to 0
+                set b to ( b + 1 )
+            endif
+            if ( b > 3 )
+                set b to 0
+                set c to ( c + 1 )
+            endif
+            set result to 0
+            if ( a == 1 )
+                if ( b == 2 )
+                    set result to 1
+                endif
+            elseif ( a == 2 )
+                set result to 2
+            elseif ( c == 3 )
+                set result to 2
+            endif
+        End)",
+    };
+
+    class CompilerContext : public Compiler::Context
+    {
+        public:
+            bool canDeclareLocals() const override { return true; }
+            char getGlobalType(const std::string&) const override { return ' '; }
+            std::pair<char, bool> getMemberType(const std::string&, const std::string&) const override
+            {
+                return std::make_pair(' ', false);
+            }
+            bool isId(const std::string&) const override { return false; }
+            bool isJournalId(const std::string&) const override { return false; }
+    };
+
+    class InterpreterContext : public Interpreter::Context
+    {
+            std::vector<int> mShorts;
+            std::vector<int> mLongs;
+            std::vector<float> mFloats;
+
+        public:
+            InterpreterContext(const Compiler::Locals& locals)
+                : mShorts(locals.get('s').size())
+                , mLongs(locals.get('l').size())
+                , mFloats(locals.get('f').size())
+            {
+            }
+
+            int getLocalShort(int index) const override { return mShorts[index]; }
+            int getLocalLong(int index) const override { return mLongs[index]; }
+            float getLocalFloat(int index) const override { return mFloats[index]; }
+            void setLocalShort(int index, int value) override { mShorts[index] = value; }
+            void setLocalLong(int index, int value) override { mLongs[index] = value; }
+            void setLocalFloat(int index, float value) override { mFloats[index] = value; }
+
+            void messageBox(const std::string&, const std::vector<std::string>&) override {}
+            void report(const std::string&) override {}
+
+            int getGlobalShort(const std::string&) const override { return 0; }
+            int getGlobalLong(const std::string&) const override { return 0; }
+            float getGlobalFloat(const std::string&) const override { return 0; }
+            void setGlobalShort(const std::string&, int) override {}
+            void setGlobalLong(const std::string&, int) override {}
+            void setGlobalFloat(const std::string&, float) override {}
+            std::vector<std::string> getGlobals() const override { return {}; }
+            char getGlobalType(const std::string&) const override { return ' '; }
+
+            std::string getActionBinding(const std::string&) const override { return {}; }
+            std::string getActorName() const override { return {}; }
+            std::string getNPCRace() const override { return {}; }
+            std::string getNPCClass() const override { return {}; }
+            std::string getNPCFaction() const override { return {}; }
+            std::string getNPCRank() const override { return {}; }
+            std::string getPCName() const override { return {}; }
+            std::string getPCRace() const override { return {}; }
+            std::string getPCClass() const override { return {}; }
+            std::string getPCRank() const override { return {}; }
+            std::string getPCNextRank() const override { return {}; }
+            int getPCBounty() const override { return 0; }
+            std::string getCurrentCellName() const override { return {}; }
+
+            int getMemberShort(const std::string&, const std::string&, bool) const override { return 0; }
+            int getMemberLong(const std::string&, const std::string&, bool) const override { return 0; }
+            float getMemberFloat(const std::string&, const std::string&, bool) const override { return 0; }
+            void setMemberShort(const std::string&, const std::string&, int, bool) override {}
+            void setMemberLong(const std::string&, const std::string&, int, bool) override {}
+            void setMemberFloat(const std::string&, const std::string&, float, bool) override {}
+
+            unsigned short getContextType() const override { return SCRIPT_LOCAL; }
+            std::string getCurrentScriptName() const override { return {}; }
+            void trackContextType(unsigned short) override {}
+            void trackCurrentScriptName(const std::string&) override {}
+    };
+
+    struct CompiledScript
+    {
+        std::vector<Interpreter::Type_Code> mByteCode;
+        std::vector<Interpreter::DecodedInstruction> mDecoded;
+        InterpreterContext mContext;
+
+        CompiledScript(std::vector<Interpreter::Type_Code>&& byteCode, const Compiler::Locals& locals)
+            : mByteCode(std::move(byteCode))
+            , mContext(locals)
+        {
+        }
+    };
+
+    struct Corpus
+    {
+        Interpreter::Interpreter mInterpreter;
+        std::vector<CompiledScript> mScripts;
+
+        Corpus()
+        {
+            Interpreter::installOpcodes(mInterpreter);
+
+            CompilerContext compilerContext;
+            Compiler::StreamErrorHandler errorHandler;
+            Compiler::FileParser parser(errorHandler, compilerContext);
+
+            mScripts.reserve(std::size(corpus));
+
+            for (const char* source : corpus)
+            {
+                parser.reset();
+                errorHandler.reset();
+
+                std::istringstream input(source);
+                Compiler::Scanner scanner(errorHandler, input, nullptr);
+                scanner.scan(parser);
+
+                if (!errorHandler.isGood())
+                    throw std::runtime_error("Failed to compile benchmark script");
+
+                std::vector<Interpreter::Type_Code> code;
+                parser.getCode(code);
+                mScripts.emplace_back(std::move(code), parser.getLocals());
+
+                CompiledScript& script = mScripts.back();
+                mInterpreter.decode(script.mByteCode.data(), static_cast<int>(script.mByteCode.size()),
+                    script.mDecoded);
+            }
+        }
+
+        std::size_t getInstructionCount() const
+        {
+            std::size_t result = 0;
+            for (const CompiledScript& script : mScripts)
+                result += script.mDecoded.size();
+            return result;
+        }
+    };
+
+    Corpus& getCorpus()
+    {
+        static Corpus corpus;
+        return corpus;
+    }
+
+    void runByteCode(benchmark::State& state)
+    {
+        Corpus& corpus = getCorpus();
+
+        for (auto _ : state)
+        {
+            for (CompiledScript& script : corpus.mScripts)
+                corpus.mInterpreter.run(script.mByteCode.data(), static_cast<int>(script.mByteCode.size()),
+                    script.mContext);
+        }
+
+        state.SetItemsProcessed(state.iterations() * corpus.mScripts.size());
+    }
+
+    void runDecoded(benchmark::State& state)
+    {
+        Corpus& corpus = getCorpus();
+
+        for (auto _ : state)
+        {
+            for (CompiledScript& script : corpus.mScripts)
+                corpus.mInterpreter.run(script.mByteCode.data(), static_cast<int>(script.mByteCode.size()),
+                    script.mDecoded, script.mContext);
+        }
+
+        state.SetItemsProcessed(state.iterations() * corpus.mScripts.size());
+    }
+
+    void decode(benchmark::State& state)
+    {
+        Corpus& corpus = getCorpus();
+        std::vector<Interpreter::DecodedInstruction> decoded;
+
+        for (auto _ : state)
+        {
+            for (const CompiledScript& script : corpus.mScripts)
+            {
+                corpus.mInterpreter.decode(script.mByteCode.data(), static_cast<int>(script.mByteCode.size()),
+                    decoded);
+                benchmark::DoNotOptimize(decoded.data());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * corpus.getInstructionCount());
+    }
+} // namespace
+
+BENCHMARK(runByteCode);
+BENCHMARK(runDecoded);
+BENCHMARK(decode);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/spatialgrid.hpp>
+
+#include <osg/Vec3f>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Same cell size as MWMechanics::Actors uses
+    constexpr float cellSize = 512;
+
+    // Actors spread over a few exterior cells, the way a busy town looks to Actors::update
+    std::vector<osg::Vec3f> generateCrowd(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-3 * 8192.f, 3 * 8192.f);
+        std::uniform_real_distribution<float> height(-100.f, 1000.f);
+        std::vector<osg::Vec3f> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.emplace_back(distribution(random) / 4, distribution(random) / 4, height(random));
+        return result;
+    }
+
+    // Every actor asks for its neighbours, as the collision avoidance and combat checks do
+    void bruteForce(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> crowd = generateCrowd(static_cast<std::size_t>(state.range(0)));
+        const float radius = static_cast<float>(state.range(1));
+        std::vector<int> found;
+
+        for (auto _ : state)
+        {
+            for (const osg::Vec3f& position : crowd)
+            {
+                found.clear();
+                for (std::size_t i = 0; i < crowd.size(); ++i)
+                    if ((crowd[i] - position).length2() <= radius * radius)
+                        found.push_back(static_cast<int>(i));
+                benchmark::DoNotOptimize(found.data());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * crowd.size());
+    }
+
+    void spatialGrid(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> crowd = generateCrowd(static_cast<std::size_t>(state.range(0)));
+        const float radius = static_cast<float>(state.range(1));
+        Misc::SpatialGrid<int> grid(cellSize);
+        std::vector<int> found;
+
+        for (auto _ : state)
+        {
+            // The grid is rebuilt once per update
+            grid.clear();
+            for (std::size_t i = 0; i < crowd.size(); ++i)
+                grid.add(crowd[i], static_cast<int>(i));
+
+            for (const osg::Vec3f& position : crowd)
+            {
+                found.clear();
+                grid.forEachInRange(position, radius, [&] (int value) { found.push_back(value); });
+                benchmark::DoNotOptimize(found.data());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * crowd.size());
+    }
+
+    void queryArguments(benchmark::internal::Benchmark* benchmark)
+    {
+        for (int count : {50, 200, 800})
+            for (int radius : {200, 1024, 7168})
+                benchmark->Args({count, radius});
+    }
+} // namespace
+
+BENCHMARK(bruteForce)->Apply(queryArguments);
+BENCHMARK(spatialGrid)->Apply(queryArguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw-mp/Script/LangLua/LuaFFI.hpp>
+
+#include <LuaBridge.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr unsigned int actorCount = 200;
+
+    struct Position
+    {
+        double mX;
+        double mY;
+        double mZ;
+    };
+
+    std::vector<Position> positions(actorCount, Position {1, 2, 3});
+
+    // Stand-ins with the same shape as the actor functions scripts call in loops over actor lists
+    unsigned int GetActorListSize() noexcept
+    {
+        return static_cast<unsigned int>(positions.size());
+    }
+
+    double GetActorPosX(unsigned int index) noexcept
+    {
+        return positions[index].mX;
+    }
+
+    double GetActorPosY(unsigned int index) noexcept
+    {
+        return positions[index].mY;
+    }
+
+    double GetActorPosZ(unsigned int index) noexcept
+    {
+        return positions[index].mZ;
+    }
+
+    void SetActorPosition(unsigned int index, double x, double y, double z) noexcept
+    {
+        positions[index] = Position {x, y, z};
+    }
+
+    // Same marshalling as the wrapper<I> functions generated by LangLua
+    int GetActorListSizeWrapper(lua_State* lua) noexcept
+    {
+        luabridge::Stack<unsigned int>::push(lua, GetActorListSize());
+        return 1;
+    }
+
+    template <double (*function)(unsigned int) noexcept>
+    int GetActorPosWrapper(lua_State* lua) noexcept
+    {
+        luabridge::Stack<double>::push(lua, function(luabridge::Stack<unsigned int>::get(lua, 1)));
+        return 1;
+    }
+
+    int SetActorPositionWrapper(lua_State* lua) noexcept
+    {
+        SetActorPosition(luabridge::Stack<unsigned int>::get(lua, 1), luabridge::Stack<double>::get(lua, 2),
+            luabridge::Stack<double>::get(lua, 3), luabridge::Stack<double>::get(lua, 4));
+        return 0;
+    }
+
+    const char* const script = R"(
+        return function(iterations)
+            for _ = 1, iterations do
+                for index = 0, tes3mp.GetActorListSize() - 1 do
+                    local x = tes3mp.GetActorPosX(index)
+                    local y = tes3mp.GetActorPosY(index)
+                    local z = tes3mp.GetActorPosZ(index)
+                    tes3mp.SetActorPosition(index, x + 1, y, z - 1)
+                end
+            end
+        end
+    )";
+
+    struct LuaState
+    {
+        lua_State* mLua;
+
+        explicit LuaState(bool ffi)
+            : mLua(luaL_newstate())
+        {
+            luaL_openlibs(mLua);
+
+            luabridge::getGlobalNamespace(mLua)
+                .beginNamespace("tes3mp")
+                    .addCFunction("GetActorListSize", GetActorListSizeWrapper)
+                    .addCFunction("GetActorPosX", GetActorPosWrapper<GetActorPosX>)
+                    .addCFunction("GetActorPosY", GetActorPosWrapper<GetActorPosY>)
+                    .addCFunction("GetActorPosZ", GetActorPosWrapper<GetActorPosZ>)
+                    .addCFunction("SetActorPosition", SetActorPositionWrapper)
+                .endNamespace();
+
+            if (ffi)
+            {
+                const std::vector<LuaFFIBinding> bindings {
+                    {"GetActorListSize", 'i', "", reinterpret_cast<void*>(GetActorListSize)},
+                    {"GetActorPosX", 'f', "i", reinterpret_cast<void*>(GetActorPosX)},
+                    {"GetActorPosY", 'f', "i", reinterpret_cast<void*>(GetActorPosY)},
+                    {"GetActorPosZ", 'f', "i", reinterpret_cast<void*>(GetActorPosZ)},
+                    {"SetActorPosition", 'v', "ifff", reinterpret_cast<void*>(SetActorPosition)},
+                };
+
+                lua_getglobal(mLua, "tes3mp");
+                const unsigned int exported = LuaFFI::Export(mLua, bindings);
+                lua_pop(mLua, 1);
+
+                if (exported != bindings.size())
+                    throw std::runtime_error("Failed to export FFI bindings, is this LuaJIT?");
+            }
+
+            if (luaL_loadstring(mLua, script) != 0 || lua_pcall(mLua, 0, 1, 0) != 0)
+                throw std::runtime_error(lua_tostring(mLua, -1));
+
+            lua_setglobal(mLua, "run");
+        }
+
+        ~LuaState()
+        {
+            lua_close(mLua);
+        }
+
+        void run(int iterations)
+        {
+            lua_getglobal(mLua, "run");
+            lua_pushinteger(mLua, iterations);
+            if (lua_pcall(mLua, 1, 0, 0) != 0)
+                throw std::runtime_error(lua_tostring(mLua, -1));
+        }
+    };
+
+    void callActorFunctions(benchmark::State& state, bool ffi)
+    {
+        LuaState lua(ffi);
+        const int iterations = static_cast<int>(state.range(0));
+
+        for (auto _ : state)
+            lua.run(iterations);
+
+        // Four calls per actor
+        state.SetItemsProcessed(state.iterations() * iterations * actorCount * 4);
+    }
+
+    void callActorFunctionsLuaCFunction(benchmark::State& state)
+    {
+        callActorFunctions(state, false);
+    }
+
+    void callActorFunctionsFFI(benchmark::State& state)
+    {
+        callActorFunctions(state, true);
+    }
+} // namespace
+
+BENCHMARK(callActorFunctionsLuaCFunction)->Arg(1)->Arg(100);
+BENCHMARK(callActorFunctionsFFI)->Arg(1)->Arg(100);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,561 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+#include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+
+#include <boost/core/demangle.hpp>
+
+#include <BitStream.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <typeinfo>
+
+namespace
+{
+    using namespace mwmp;
+
+    constexpr std::size_t inventorySize = 1000;
+    constexpr std::size_t spellbookSize = 300;
+    constexpr std::size_t journalSize = 500;
+    constexpr std::size_t actorListSize = 200;
+    constexpr std::size_t objectListSize = 200;
+    constexpr std::size_t containerSize = 100;
+    constexpr std::size_t mapTileCount = 64;
+    constexpr std::size_t dynamicRecordCount = 300;
+
+    template <typename Random>
+    std::string generateRefId(Random& random)
+    {
+        static const char* const prefixes[] = {"misc_", "ingred_", "p_", "iron_", "steel_", "ebony_", "daedric_",
+                                               "common_", "expensive_", "exquisite_", "bk_", "sc_", "gold_"};
+        std::uniform_int_distribution<std::size_t> prefix(0, std::size(prefixes) - 1);
+        std::uniform_int_distribution<int> suffix(0, 99999);
+        return prefixes[prefix(random)] + std::string("item_") + std::to_string(suffix(random));
+    }
+
+    template <typename Random>
+    ESM::Position generatePosition(Random& random)
+    {
+        std::uniform_real_distribution<float> distribution(-100000.f, 100000.f);
+        ESM::Position position;
+        std::generate(std::begin(position.pos), std::end(position.pos), [&] { return distribution(random); });
+        std::generate(std::begin(position.rot), std::end(position.rot), [&] { return distribution(random) / 100000.f; });
+        return position;
+    }
+
+    template <typename Random>
+    Item generateItem(Random& random)
+    {
+        std::uniform_int_distribution<int> count(1, 50);
+        Item item;
+        item.refId = generateRefId(random);
+        item.count = count(random);
+        item.charge = -1;
+        item.enchantmentCharge = -1;
+        return item;
+    }
+
+    template <typename Random>
+    ContainerItem generateContainerItem(Random& random)
+    {
+        const Item item = generateItem(random);
+        ContainerItem containerItem;
+        containerItem.refId = item.refId;
+        containerItem.count = item.count;
+        containerItem.charge = item.charge;
+        containerItem.enchantmentCharge = item.enchantmentCharge;
+        containerItem.actionCount = item.count;
+        return containerItem;
+    }
+
+    ESM::Cell makeCell()
+    {
+        ESM::Cell cell;
+        cell.mName = "Balmora, Guild of Mages";
+        cell.mData.mFlags = ESM::Cell::Interior;
+        return cell;
+    }
+
+    Target makeTarget()
+    {
+        Target target;
+        target.isPlayer = false;
+        target.refId = "balmora_guard";
+        target.refNum = 1234;
+        target.mpNum = 0;
+        return target;
+    }
+
+    template <typename Random>
+    ActiveSpell generateActiveSpell(Random& random)
+    {
+        ActiveSpell activeSpell;
+        activeSpell.id = generateRefId(random);
+        activeSpell.isStackingSpell = false;
+        activeSpell.timestampDay = 16;
+        activeSpell.timestampHour = 9.5;
+        activeSpell.caster = makeTarget();
+        activeSpell.params.mDisplayName = activeSpell.id;
+        activeSpell.params.mCasterActorId = -1;
+        activeSpell.params.mEffects.resize(3);
+        for (auto& effect : activeSpell.params.mEffects)
+        {
+            effect.mEffectId = 79;
+            effect.mArg = -1;
+            effect.mMagnitude = 10;
+            effect.mDuration = 60;
+            effect.mTimeLeft = 30;
+            effect.mEffectIndex = 0;
+        }
+        return activeSpell;
+    }
+
+    template <typename Random>
+    void generatePlayer(BasePlayer& player, Random& random)
+    {
+        player.exchangeFullInfo = false;
+        player.position = generatePosition(random);
+        player.direction = generatePosition(random);
+        player.previousCellPosition = generatePosition(random);
+        player.momentum = generatePosition(random);
+        player.cell = makeCell();
+        player.markCell = makeCell();
+        player.markPosition = generatePosition(random);
+        player.npc.mName = "Nerevarine";
+        player.npc.mRace = "dark elf";
+        player.npc.mHair = "b_n_dark elf_m_hair01";
+        player.npc.mHead = "b_n_dark elf_m_head01";
+        player.birthsign = "the lady";
+        player.chatMessage = "Well met, outlander. The Mages Guild is on the west bank.";
+        player.guiMessageBox.type = BasePlayer::GUIMessageBox::ListBox;
+        player.guiMessageBox.label = "Choose an option";
+        player.guiMessageBox.data = "First\nSecond\nThird";
+        player.miscellaneousChangeType = MISCELLANEOUS_CHANGE_TYPE::MARK_LOCATION;
+        player.isChangingRegion = false;
+        player.deathState = 0;
+        player.drawState = 1;
+        player.resurrectType = RESURRECT_TYPE::REGULAR;
+        player.attack.type = Attack::MELEE;
+        player.attack.target = makeTarget();
+        player.cast.type = Cast::REGULAR;
+        player.cast.target = makeTarget();
+        player.killer = makeTarget();
+        player.usedItem = generateItem(random);
+        player.usingItemMagic = false;
+        player.jailDays = 3;
+
+        player.inventoryChanges.action = InventoryChanges::SET;
+        std::generate_n(std::back_inserter(player.inventoryChanges.items), inventorySize, [&] { return generateItem(random); });
+
+        player.spellbookChanges.action = SpellbookChanges::SET;
+        player.spellbookChanges.spells.resize(spellbookSize);
+        for (auto& spell : player.spellbookChanges.spells)
+            spell.mId = generateRefId(random);
+
+        player.spellsActiveChanges.action = SpellsActiveChanges::SET;
+        std::generate_n(std::back_inserter(player.spellsActiveChanges.activeSpells), 30, [&] { return generateActiveSpell(random); });
+
+        player.journalChanges.resize(journalSize);
+        for (auto& journalItem : player.journalChanges)
+        {
+            journalItem.type = JournalItem::ENTRY;
+            journalItem.quest = generateRefId(random);
+            journalItem.index = 10;
+            journalItem.actorRefId = "caius cosades";
+            journalItem.hasTimestamp = false;
+        }
+
+        player.topicChanges.resize(journalSize);
+        for (auto& topic : player.topicChanges)
+            topic.topicId = generateRefId(random);
+
+        player.bookChanges.resize(100);
+        for (auto& book : player.bookChanges)
+            book.bookId = generateRefId(random);
+
+        player.factionChanges.action = FactionChanges::RANK;
+        player.factionChanges.factions.resize(20);
+        for (auto& faction : player.factionChanges.factions)
+        {
+            faction.factionId = generateRefId(random);
+            faction.rank = 3;
+            faction.reputation = 10;
+            faction.isExpelled = false;
+        }
+
+        player.quickKeyChanges.resize(9);
+        for (unsigned short slot = 0; slot < player.quickKeyChanges.size(); ++slot)
+        {
+            player.quickKeyChanges[slot].slot = slot;
+            player.quickKeyChanges[slot].type = QuickKey::ITEM;
+            player.quickKeyChanges[slot].itemId = generateRefId(random);
+        }
+
+        player.cooldownChanges.resize(20);
+        for (auto& cooldown : player.cooldownChanges)
+        {
+            cooldown.id = generateRefId(random);
+            cooldown.startTimestampDay = 16;
+            cooldown.startTimestampHour = 9.5;
+        }
+
+        player.cellStateChanges.resize(9);
+        for (auto& cellState : player.cellStateChanges)
+        {
+            cellState.cell = makeCell();
+            cellState.type = CellState::LOAD;
+        }
+
+        for (auto& equipmentItem : player.equipmentItems)
+            equipmentItem = generateItem(random);
+
+        for (int i = 0; i < 19; ++i)
+            player.equipmentIndexChanges.push_back(i);
+        for (uint8_t i = 0; i < 8; ++i)
+            player.attributeIndexChanges.push_back(i);
+        for (uint8_t i = 0; i < 27; ++i)
+            player.skillIndexChanges.push_back(i);
+        for (uint8_t i = 0; i < 3; ++i)
+            player.statsDynamicIndexChanges.push_back(i);
+    }
+
+    template <typename Random>
+    BaseActor generateActor(std::size_t index, Random& random)
+    {
+        BaseActor actor;
+        actor.refId = generateRefId(random);
+        actor.refNum = static_cast<unsigned int>(index + 1);
+        actor.mpNum = 0;
+        actor.position = generatePosition(random);
+        actor.direction = generatePosition(random);
+        actor.cell = makeCell();
+        actor.movementFlags = 0;
+        actor.drawState = 0;
+        actor.isFlying = false;
+        actor.sound = "Voice\\d\\m\\Hlo_DM001.mp3";
+        for (auto& dynamic : actor.creatureStats.mDynamic)
+        {
+            dynamic.mBase = 100;
+            dynamic.mMod = 0;
+            dynamic.mCurrent = 75;
+        }
+        actor.creatureStats.mDead = false;
+        actor.creatureStats.mDeathAnimationFinished = false;
+        actor.animation.groupname = "idle2";
+        actor.animation.mode = 0;
+        actor.animation.count = 1;
+        actor.animation.persist = false;
+        actor.deathState = 0;
+        actor.attack.type = Attack::MELEE;
+        actor.attack.target = makeTarget();
+        actor.cast.type = Cast::REGULAR;
+        actor.cast.target = makeTarget();
+        actor.killer = makeTarget();
+        actor.isFollowerCellChange = false;
+        actor.hasAiTarget = true;
+        actor.aiTarget = makeTarget();
+        actor.aiAction = BaseActorList::WANDER;
+        actor.aiDistance = 512;
+        actor.aiDuration = 5;
+        actor.aiShouldRepeat = true;
+        actor.aiCoordinates = generatePosition(random);
+        for (auto& equipmentItem : actor.equipmentItems)
+            equipmentItem = generateItem(random);
+        actor.spellsActiveChanges.action = SpellsActiveChanges::SET;
+        std::generate_n(std::back_inserter(actor.spellsActiveChanges.activeSpells), 3, [&] { return generateActiveSpell(random); });
+        return actor;
+    }
+
+    template <typename Random>
+    void generateActorList(BaseActorList& actorList, Random& random)
+    {
+        actorList.cell = makeCell();
+        actorList.action = BaseActorList::SET;
+        actorList.isValid = true;
+        for (std::size_t i = 0; i < actorListSize; ++i)
+            actorList.baseActors.push_back(generateActor(i, random));
+        actorList.count = static_cast<unsigned int>(actorList.baseActors.size());
+    }
+
+    template <typename Random>
+    BaseObject generateObject(std::size_t index, Random& random)
+    {
+        BaseObject object;
+        object.refId = generateRefId(random);
+        object.refNum = static_cast<unsigned int>(index + 1);
+        object.mpNum = 0;
+        object.count = 1;
+        object.charge = -1;
+        object.enchantmentCharge = -1;
+        object.goldValue = 1;
+        object.position = generatePosition(random);
+        object.objectState = true;
+        object.lockLevel = 50;
+        object.scale = 1;
+        object.dialogueChoiceType = DialogueChoiceType::TOPIC;
+        object.topicId = "latest rumors";
+        object.soundId = "Door Stone Open";
+        object.volume = 1;
+        object.pitch = 1;
+        object.goldPool = 1000;
+        object.lastGoldRestockHour = 9;
+        object.lastGoldRestockDay = 16;
+        object.doorState = 1;
+        object.teleportState = true;
+        object.destinationCell = makeCell();
+        object.destinationPosition = generatePosition(random);
+        object.animGroup = "idle";
+        object.animMode = 0;
+        object.isDisarmed = false;
+        object.droppedByPlayer = false;
+        object.activatingActor = makeTarget();
+        object.hittingActor = makeTarget();
+        object.hitAttack.type = Attack::MELEE;
+        object.hitAttack.target = makeTarget();
+        object.isSummon = false;
+        object.master = makeTarget();
+        object.hasContainer = true;
+        object.isPlayer = false;
+
+        object.clientLocals.resize(4);
+        for (int i = 0; i < 4; ++i)
+        {
+            object.clientLocals[i].internalIndex = i;
+            object.clientLocals[i].variableType = VARIABLE_TYPE::SHORT;
+            object.clientLocals[i].intValue = i;
+        }
+
+        std::generate_n(std::back_inserter(object.containerItems), containerSize, [&] { return generateContainerItem(random); });
+        object.containerItemCount = static_cast<unsigned int>(object.containerItems.size());
+        return object;
+    }
+
+    template <typename Random>
+    void generateObjectList(BaseObjectList& objectList, Random& random)
+    {
+        objectList.cell = makeCell();
+        objectList.packetOrigin = CLIENT_GAMEPLAY;
+        objectList.action = BaseObjectList::SET;
+        objectList.containerSubAction = BaseObjectList::NONE;
+        objectList.consoleCommand = "player->additem gold_001 100";
+        objectList.isValid = true;
+        for (std::size_t i = 0; i < objectListSize; ++i)
+            objectList.baseObjects.push_back(generateObject(i, random));
+        objectList.baseObjectCount = static_cast<unsigned int>(objectList.baseObjects.size());
+    }
+
+    template <typename Random>
+    void generateWorldstate(BaseWorldstate& worldstate, Random& random)
+    {
+        std::uniform_int_distribution<int> byte(0, 255);
+
+        worldstate.time.hour = 9.5;
+        worldstate.time.day = 16;
+        worldstate.time.month = 7;
+        worldstate.time.year = 427;
+        worldstate.time.daysPassed = 1;
+        worldstate.time.timeScale = 30;
+
+        worldstate.hasPlayerCollision = true;
+        worldstate.hasActorCollision = true;
+        worldstate.hasPlacedObjectCollision = false;
+        worldstate.useActorCollisionForPlacedObjects = false;
+        worldstate.authorityRegion = "west gash region";
+        worldstate.forceWeather = false;
+        worldstate.weather.region = "west gash region";
+        worldstate.weather.currentWeather = 1;
+        worldstate.weather.nextWeather = 2;
+        worldstate.weather.queuedWeather = 0;
+        worldstate.weather.transitionFactor = 0.5;
+        worldstate.isValid = true;
+
+        worldstate.mapTiles.resize(mapTileCount);
+        for (std::size_t i = 0; i < mapTileCount; ++i)
+        {
+            auto& mapTile = worldstate.mapTiles[i];
+            mapTile.x = static_cast<int>(i % 8);
+            mapTile.y = static_cast<int>(i / 8);
+            mapTile.imageData.resize(maxImageDataSize);
+            std::generate(mapTile.imageData.begin(), mapTile.imageData.end(), [&] { return static_cast<char>(byte(random)); });
+        }
+
+        worldstate.killChanges.resize(500);
+        for (auto& kill : worldstate.killChanges)
+        {
+            kill.refId = generateRefId(random);
+            kill.number = 3;
+        }
+
+        for (int i = 0; i < 100; ++i)
+        {
+            worldstate.enforcedCollisionRefIds.push_back(generateRefId(random));
+            worldstate.destinationOverrides[generateRefId(random)] = "Balmora, Guild of Mages";
+            worldstate.synchronizedClientScriptIds.push_back(generateRefId(random));
+            worldstate.synchronizedClientGlobalIds.push_back(generateRefId(random));
+        }
+
+        worldstate.clientGlobals.resize(100);
+        for (auto& clientGlobal : worldstate.clientGlobals)
+        {
+            clientGlobal.id = generateRefId(random);
+            clientGlobal.variableType = VARIABLE_TYPE::FLOAT;
+            clientGlobal.floatValue = 0.5f;
+        }
+
+        worldstate.cellsToReset.assign(50, makeCell());
+
+        worldstate.recordsType = RECORD_TYPE::SPELL;
+        worldstate.spellRecords.resize(dynamicRecordCount);
+        for (auto& record : worldstate.spellRecords)
+        {
+            record.data.mId = "$custom_spell_" + generateRefId(random);
+            record.data.mName = "Custom Spell";
+            record.data.mData.mType = ESM::Spell::ST_Spell;
+            record.data.mData.mCost = 25;
+            record.data.mData.mFlags = 0;
+            record.data.mEffects.mList.resize(4);
+            for (auto& effect : record.data.mEffects.mList)
+            {
+                effect.mEffectID = 14;
+                effect.mSkill = -1;
+                effect.mAttribute = -1;
+                effect.mRange = 2;
+                effect.mArea = 5;
+                effect.mDuration = 10;
+                effect.mMagnMin = 5;
+                effect.mMagnMax = 20;
+            }
+        }
+        worldstate.recordsCount = static_cast<unsigned int>(worldstate.spellRecords.size());
+    }
+
+    std::string getPacketName(const BasePacket& packet)
+    {
+        std::string name = boost::core::demangle(typeid(packet).name());
+        const std::string prefix = "mwmp::";
+        if (name.compare(0, prefix.size(), prefix) == 0)
+            name.erase(0, prefix.size());
+        return name;
+    }
+
+    // Moves the read pointer past the packet ID and GUID header, the same way the networking code
+    // does before handing the stream over to Read()
+    void skipHeader(RakNet::BitStream& bitStream)
+    {
+        bitStream.ResetReadPointer();
+        bitStream.IgnoreBytes(BasePacket::headerSize());
+    }
+
+    template <typename PacketT>
+    void encode(benchmark::State& state, PacketT* packet, const std::function<void(PacketT*)>& bind)
+    {
+        RakNet::BitStream bitStream;
+        bind(packet);
+
+        while (state.KeepRunning())
+        {
+            bitStream.Reset();
+            packet->Packet(&bitStream, true);
+            benchmark::DoNotOptimize(bitStream.GetData());
+        }
+
+        state.SetBytesProcessed(state.iterations() * bitStream.GetNumberOfBytesUsed());
+        state.counters["bytes"] = bitStream.GetNumberOfBytesUsed();
+    }
+
+    template <typename PacketT>
+    void decode(benchmark::State& state, PacketT* packet, const std::function<void(PacketT*)>& bind,
+        const std::function<void(PacketT*)>& bindTarget)
+    {
+        RakNet::BitStream bitStream;
+        bind(packet);
+        packet->Packet(&bitStream, true);
+        bindTarget(packet);
+
+        while (state.KeepRunning())
+        {
+            skipHeader(bitStream);
+            packet->Packet(&bitStream, false);
+            benchmark::DoNotOptimize(packet->isPacketValid());
+        }
+
+        state.SetBytesProcessed(state.iterations() * bitStream.GetNumberOfBytesUsed());
+        state.counters["bytes"] = bitStream.GetNumberOfBytesUsed();
+    }
+
+    template <typename ControllerT, typename PacketT>
+    void registerPackets(const std::string& family, const std::shared_ptr<ControllerT>& controller,
+        const std::function<void(PacketT*)>& bind, const std::function<void(PacketT*)>& bindTarget)
+    {
+        for (unsigned id = 0; id <= std::numeric_limits<RakNet::MessageID>::max(); ++id)
+        {
+            if (!controller->ContainsPacket(static_cast<RakNet::MessageID>(id)))
+                continue;
+
+            PacketT* packet = controller->GetPacket(static_cast<RakNet::MessageID>(id));
+            const std::string name = family + "/" + getPacketName(*packet);
+
+            benchmark::RegisterBenchmark(("encode/" + name).c_str(), [controller, packet, bind] (benchmark::State& state) {
+                encode(state, packet, bind);
+            });
+            benchmark::RegisterBenchmark(("decode/" + name).c_str(), [controller, packet, bind, bindTarget] (benchmark::State& state) {
+                decode(state, packet, bind, bindTarget);
+            });
+        }
+    }
+
+    void registerBenchmarks()
+    {
+        std::minstd_rand random;
+
+        auto player = std::make_shared<BasePlayer>(RakNet::RakNetGUID(1));
+        generatePlayer(*player, random);
+        auto playerTarget = std::make_shared<BasePlayer>(RakNet::RakNetGUID(1));
+        generatePlayer(*playerTarget, random);
+        registerPackets<PlayerPacketController, PlayerPacket>("PlayerPacket",
+            std::make_shared<PlayerPacketController>(nullptr),
+            [player] (PlayerPacket* packet) { packet->setPlayer(player.get()); },
+            [playerTarget] (PlayerPacket* packet) { packet->setPlayer(playerTarget.get()); });
+
+        auto actorList = std::make_shared<BaseActorList>();
+        generateActorList(*actorList, random);
+        auto actorListTarget = std::make_shared<BaseActorList>();
+        registerPackets<ActorPacketController, ActorPacket>("ActorPacket",
+            std::make_shared<ActorPacketController>(nullptr),
+            [actorList] (ActorPacket* packet) { packet->setActorList(actorList.get()); },
+            [actorListTarget] (ActorPacket* packet) { packet->setActorList(actorListTarget.get()); });
+
+        auto objectList = std::make_shared<BaseObjectList>(RakNet::RakNetGUID(1));
+        generateObjectList(*objectList, random);
+        auto objectListTarget = std::make_shared<BaseObjectList>(RakNet::RakNetGUID(1));
+        registerPackets<ObjectPacketController, ObjectPacket>("ObjectPacket",
+            std::make_shared<ObjectPacketController>(nullptr),
+            [objectList] (ObjectPacket* packet) { packet->setObjectList(objectList.get()); },
+            [objectListTarget] (ObjectPacket* packet) { packet->setObjectList(objectListTarget.get()); });
+
+        auto worldstate = std::make_shared<BaseWorldstate>();
+        generateWorldstate(*worldstate, random);
+        auto worldstateTarget = std::make_shared<BaseWorldstate>();
+        registerPackets<WorldstatePacketController, WorldstatePacket>("WorldstatePacket",
+            std::make_shared<WorldstatePacketController>(nullptr),
+            [worldstate] (WorldstatePacket* packet) { packet->setWorldstate(worldstate.get()); },
+            [worldstateTarget] (WorldstatePacket* packet) { packet->setWorldstate(worldstateTarget.get()); });
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    registerBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
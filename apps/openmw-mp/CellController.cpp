@@ -1,6 +1,7 @@
 #include "CellController.hpp"
 
 #include <iostream>
+#include <components/misc/hash.hpp>
 #include "Cell.hpp"
 #include "Player.hpp"
 #include "Script/Script.hpp"
@@ -124,6 +125,8 @@ void CellController::removeCell(Cell *cell)
             Script::Call<Script::CallbackIdentity("OnCellDeletion")>(cell->getShortDescription().c_str());
             LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from CellController", cell->getShortDescription().c_str());
 
+            containerRevisions.erase(cell->getShortDescription());
+
             delete *it;
             it = cells.erase(it);
         }
@@ -189,3 +192,86 @@ void CellController::update(Player *player)
         removeCell(cell);
     }
 }
+
+std::string CellController::getContainerKey(const mwmp::BaseObject &object)
+{
+    return std::to_string(object.refNum) + "-" + std::to_string(object.mpNum);
+}
+
+unsigned int CellController::getContainerRevision(const ESM::Cell &esmCell, const mwmp::BaseObject &object) const
+{
+    auto cellIt = containerRevisions.find(esmCell.getShortDescription());
+
+    if (cellIt == containerRevisions.end())
+        return 0;
+
+    auto it = cellIt->second.find(getContainerKey(object));
+
+    if (it == cellIt->second.end())
+        return 0;
+
+    return it->second.revision;
+}
+
+unsigned int CellController::updateContainerRevision(const ESM::Cell &esmCell, const mwmp::BaseObject &object,
+    unsigned char action)
+{
+    auto hashItem = [](const mwmp::ContainerItem &item, int count, std::uint64_t seed)
+    {
+        seed = Misc::hashFnv1a(item.refId.data(), item.refId.size(), seed);
+        seed = Misc::hashFnv1a(&count, sizeof(count), seed);
+        seed = Misc::hashFnv1a(&item.charge, sizeof(item.charge), seed);
+        seed = Misc::hashFnv1a(&item.enchantmentCharge, sizeof(item.enchantmentCharge), seed);
+        return Misc::hashFnv1a(item.soul.data(), item.soul.size() + 1, seed);
+    };
+
+    std::unordered_map<std::string, ContainerRevision> &cellRevisions = containerRevisions[esmCell.getShortDescription()];
+    const std::string key = getContainerKey(object);
+    auto it = cellRevisions.find(key);
+
+    std::uint64_t contentsHash;
+
+    if (action == mwmp::BaseObjectList::SET)
+    {
+        // The entire contents are replaced, so they can be compared with the previous ones directly
+        contentsHash = Misc::hashFnv1a(&action, sizeof(action));
+
+        for (const auto &item : object.containerItems)
+            contentsHash = hashItem(item, item.count, contentsHash);
+    }
+    else
+    {
+        // Adding or removing nothing leaves the contents as they were
+        if (object.containerItems.empty())
+            return it != cellRevisions.end() ? it->second.revision : 0;
+
+        contentsHash = it != cellRevisions.end() ? it->second.contentsHash : 0;
+        contentsHash = Misc::hashFnv1a(&action, sizeof(action), contentsHash);
+
+        for (const auto &item : object.containerItems)
+            contentsHash = hashItem(item, action == mwmp::BaseObjectList::REMOVE ? item.actionCount : item.count,
+                contentsHash);
+    }
+
+    if (it == cellRevisions.end())
+        it = cellRevisions.emplace(key, ContainerRevision {0, 0}).first;
+    else if (it->second.contentsHash == contentsHash)
+        return it->second.revision;
+
+    it->second.revision = ++lastContainerRevision;
+    it->second.contentsHash = contentsHash;
+    return it->second.revision;
+}
+
+void CellController::removeContainerRevision(const ESM::Cell &esmCell, const mwmp::BaseObject &object)
+{
+    auto cellIt = containerRevisions.find(esmCell.getShortDescription());
+
+    if (cellIt == containerRevisions.end())
+        return;
+
+    cellIt->second.erase(getContainerKey(object));
+
+    if (cellIt->second.empty())
+        containerRevisions.erase(cellIt);
+}
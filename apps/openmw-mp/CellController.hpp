@@ -1,8 +1,10 @@
 #ifndef OPENMW_SERVERCELLCONTROLLER_HPP
 #define OPENMW_SERVERCELLCONTROLLER_HPP
 
+#include <cstdint>
 #include <deque>
 #include <string>
+#include <unordered_map>
 #include <components/esm/records.hpp>
 #include <components/openmw-mp/Base/BaseObject.hpp>
 #include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
@@ -38,9 +40,29 @@ public:
 
     void update(Player *player);
 
+    unsigned int getContainerRevision(const ESM::Cell &esmCell, const mwmp::BaseObject &object) const;
+    unsigned int updateContainerRevision(const ESM::Cell &esmCell, const mwmp::BaseObject &object, unsigned char action);
+    void removeContainerRevision(const ESM::Cell &esmCell, const mwmp::BaseObject &object);
+
 private:
+    struct ContainerRevision
+    {
+        unsigned int revision;
+        std::uint64_t contentsHash;
+    };
+
+    static std::string getContainerKey(const mwmp::BaseObject &object);
+
     static CellController *sThis;
     TContainer cells;
+
+    // Revisions of container contents sent by the server, grouped by the short descriptions of
+    // their cells so they can be dropped together with them
+    std::unordered_map<std::string, std::unordered_map<std::string, ContainerRevision>> containerRevisions;
+
+    // Revisions are taken from a single counter so that a container whose revision was dropped
+    // can never be given a revision that a client still holds from before
+    unsigned int lastContainerRevision = 0;
 };
 
 #endif //OPENMW_SERVERCELLCONTROLLER_HPP
@@ -12,6 +12,9 @@
 #include <iostream>
 #include <Script/Script.hpp>
 #include <Script/API/TimerAPI.hpp>
+#if defined(ENABLE_LUA)
+#include <Script/API/IsolatedScriptAPI.hpp>
+#endif
 #include <chrono>
 #include <thread>
 #include <csignal>
@@ -569,10 +572,16 @@ int Networking::mainLoop()
             }
         }
         TimerAPI::Tick();
+#if defined(ENABLE_LUA)
+        IsolatedScriptAPI::Tick();
+#endif
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
     TimerAPI::Terminate();
+#if defined(ENABLE_LUA)
+    IsolatedScriptAPI::Terminate();
+#endif
     return exitCode;
 }
 
@@ -0,0 +1,452 @@
+#include "IsolatedScriptAPI.hpp"
+
+#include <cstdio>
+
+#include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Utils.hpp>
+
+#include <Script/LangLua/LangLua.hpp>
+#include <Script/Script.hpp>
+#include <Player.hpp>
+#include <Cell.hpp>
+
+using namespace mwmp;
+
+std::vector<std::unique_ptr<IsolatedScript>> IsolatedScriptAPI::scripts;
+std::shared_ptr<const WorldSnapshot> IsolatedScriptAPI::snapshot;
+unsigned long long IsolatedScriptAPI::tick = 0;
+unsigned long long IsolatedScriptAPI::snapshotTick = 0;
+
+static const char *registryKey = "tes3mp_isolated_script";
+
+// Errors raised with error() can be any Lua value, and lua_tostring returns nullptr for most of them
+static std::string getErrorMessage(lua_State *lua)
+{
+    const char *error = lua_tostring(lua, -1);
+    return error != nullptr ? error : std::string("(error object is a ") + luaL_typename(lua, -1) + " value)";
+}
+
+IsolatedScript::IsolatedScript(const std::string &name, const std::string &path) : name(name), stopping(false)
+{
+    // Only use LangLua for its state setup with the shared package paths, because LoadProgram
+    // would register the regular script functions, which must stay on the network thread
+    LangLua lang;
+    lua = lang.lua;
+
+    lua_pushlightuserdata(lua, this);
+    lua_setfield(lua, LUA_REGISTRYINDEX, registryKey);
+
+    luabridge::getGlobalNamespace(lua)
+        .beginNamespace("tes3mp")
+            .addCFunction("SendMessage", &IsolatedScript::SendMessage)
+            .addCFunction("LogMessage", &IsolatedScript::LogMessage)
+            .addCFunction("GetPlayerIds", &IsolatedScript::GetPlayerIds)
+            .addCFunction("GetPlayerSnapshot", &IsolatedScript::GetPlayerSnapshot)
+            .addCFunction("GetCellSnapshot", &IsolatedScript::GetCellSnapshot)
+        .endNamespace();
+
+    if (luaL_loadfile(lua, path.c_str()) != 0 || lua_pcall(lua, 0, 0, 0) != 0)
+    {
+        std::string error = getErrorMessage(lua);
+        lua_close(lua);
+        throw std::runtime_error("Isolated script " + name + " failed to load: " + error);
+    }
+
+    worker = std::thread(&IsolatedScript::Run, this);
+}
+
+IsolatedScript::~IsolatedScript()
+{
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        stopping = true;
+    }
+    inboxCondition.notify_one();
+
+    if (worker.joinable())
+        worker.join();
+
+    lua_close(lua);
+}
+
+const std::string &IsolatedScript::GetName() const
+{
+    return name;
+}
+
+void IsolatedScript::Post(Message &&message)
+{
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        inbox.push_back(std::move(message));
+    }
+    inboxCondition.notify_one();
+}
+
+void IsolatedScript::TakeOutgoing(std::vector<OutgoingMessage> &out)
+{
+    std::lock_guard<std::mutex> lock(outboxMutex);
+    out.insert(out.end(), std::make_move_iterator(outbox.begin()), std::make_move_iterator(outbox.end()));
+    outbox.clear();
+}
+
+void IsolatedScript::Run()
+{
+    while (true)
+    {
+        Message message;
+        {
+            std::unique_lock<std::mutex> lock(inboxMutex);
+            inboxCondition.wait(lock, [this] { return stopping || !inbox.empty(); });
+
+            if (stopping)
+                break;
+
+            message = std::move(inbox.front());
+            inbox.pop_front();
+        }
+
+        snapshot = IsolatedScriptAPI::GetSnapshot();
+        Handle(message);
+    }
+}
+
+void IsolatedScript::Handle(const Message &message)
+{
+    int argCount = 0;
+
+    if (message.type == Message::CALLBACK)
+    {
+        lua_getglobal(lua, message.name.c_str());
+
+        if (!lua_isfunction(lua, -1))
+        {
+            lua_pop(lua, 1);
+            return;
+        }
+
+        for (size_t i = 0; i < message.types.size() && i < message.args.size(); ++i)
+        {
+            const boost::any &arg = message.args[i];
+
+            switch (message.types[i])
+            {
+                case 's':
+                    lua_pushstring(lua, boost::any_cast<std::string>(arg).c_str());
+                    break;
+                case 'b':
+                    lua_pushboolean(lua, boost::any_cast<bool>(arg));
+                    break;
+                default:
+                    lua_pushnumber(lua, boost::any_cast<double>(arg));
+                    break;
+            }
+            ++argCount;
+        }
+    }
+    else
+    {
+        lua_getglobal(lua, "OnCoreMessage");
+
+        if (!lua_isfunction(lua, -1))
+        {
+            lua_pop(lua, 1);
+            return;
+        }
+
+        lua_pushstring(lua, message.name.c_str());
+        lua_pushstring(lua, boost::any_cast<std::string>(message.args.at(0)).c_str());
+        argCount = 2;
+    }
+
+    if (lua_pcall(lua, argCount, 0, 0) != 0)
+    {
+        OutgoingMessage error;
+        error.type = OutgoingMessage::LOG;
+        error.logLevel = TimedLog::LOG_ERROR;
+        error.data = "Error in " + message.name + ": " + getErrorMessage(lua);
+        lua_pop(lua, 1);
+
+        PostOutgoing(std::move(error));
+    }
+}
+
+void IsolatedScript::PostOutgoing(OutgoingMessage &&message)
+{
+    std::lock_guard<std::mutex> lock(outboxMutex);
+    outbox.push_back(std::move(message));
+}
+
+IsolatedScript *IsolatedScript::FromLua(lua_State *lua)
+{
+    lua_getfield(lua, LUA_REGISTRYINDEX, registryKey);
+    auto script = static_cast<IsolatedScript *>(lua_touserdata(lua, -1));
+    lua_pop(lua, 1);
+    return script;
+}
+
+int IsolatedScript::SendMessage(lua_State *lua) noexcept
+{
+    OutgoingMessage message;
+    message.type = OutgoingMessage::SCRIPT_MESSAGE;
+    message.logLevel = 0;
+    message.name = luaL_checkstring(lua, 1);
+    message.data = luaL_optstring(lua, 2, "");
+
+    FromLua(lua)->PostOutgoing(std::move(message));
+    return 0;
+}
+
+int IsolatedScript::LogMessage(lua_State *lua) noexcept
+{
+    OutgoingMessage message;
+    message.type = OutgoingMessage::LOG;
+    message.logLevel = (int) luaL_checkinteger(lua, 1);
+    message.data = luaL_checkstring(lua, 2);
+
+    FromLua(lua)->PostOutgoing(std::move(message));
+    return 0;
+}
+
+int IsolatedScript::GetPlayerIds(lua_State *lua) noexcept
+{
+    IsolatedScript *script = FromLua(lua);
+
+    lua_newtable(lua);
+
+    if (!script->snapshot)
+        return 1;
+
+    int index = 1;
+    for (const auto &player : script->snapshot->players)
+    {
+        lua_pushinteger(lua, player.first);
+        lua_rawseti(lua, -2, index++);
+    }
+
+    return 1;
+}
+
+int IsolatedScript::GetPlayerSnapshot(lua_State *lua) noexcept
+{
+    IsolatedScript *script = FromLua(lua);
+    auto pid = (unsigned short) luaL_checkinteger(lua, 1);
+
+    if (!script->snapshot)
+    {
+        lua_pushnil(lua);
+        return 1;
+    }
+
+    auto it = script->snapshot->players.find(pid);
+
+    if (it == script->snapshot->players.end())
+    {
+        lua_pushnil(lua);
+        return 1;
+    }
+
+    const PlayerSnapshot &player = it->second;
+
+    auto setNumber = [lua](const char *key, double value) {
+        lua_pushnumber(lua, value);
+        lua_setfield(lua, -2, key);
+    };
+
+    lua_newtable(lua);
+
+    lua_pushinteger(lua, player.pid);
+    lua_setfield(lua, -2, "pid");
+    lua_pushstring(lua, player.name.c_str());
+    lua_setfield(lua, -2, "name");
+    lua_pushstring(lua, player.cellDescription.c_str());
+    lua_setfield(lua, -2, "cell");
+    lua_pushboolean(lua, player.isLoggedIn);
+    lua_setfield(lua, -2, "isLoggedIn");
+
+    setNumber("posX", player.position[0]);
+    setNumber("posY", player.position[1]);
+    setNumber("posZ", player.position[2]);
+    setNumber("rotX", player.rotation[0]);
+    setNumber("rotY", player.rotation[1]);
+    setNumber("rotZ", player.rotation[2]);
+    setNumber("level", player.level);
+    setNumber("healthBase", player.healthBase);
+    setNumber("healthCurrent", player.healthCurrent);
+    setNumber("magickaBase", player.magickaBase);
+    setNumber("magickaCurrent", player.magickaCurrent);
+    setNumber("fatigueBase", player.fatigueBase);
+    setNumber("fatigueCurrent", player.fatigueCurrent);
+
+    return 1;
+}
+
+int IsolatedScript::GetCellSnapshot(lua_State *lua) noexcept
+{
+    IsolatedScript *script = FromLua(lua);
+    std::string description = luaL_checkstring(lua, 1);
+
+    if (!script->snapshot)
+    {
+        lua_pushnil(lua);
+        return 1;
+    }
+
+    auto it = script->snapshot->cells.find(description);
+
+    if (it == script->snapshot->cells.end())
+    {
+        lua_pushnil(lua);
+        return 1;
+    }
+
+    const CellSnapshot &cell = it->second;
+
+    lua_newtable(lua);
+
+    lua_pushstring(lua, cell.description.c_str());
+    lua_setfield(lua, -2, "description");
+    lua_pushinteger(lua, cell.authorityPid);
+    lua_setfield(lua, -2, "authorityPid");
+    lua_pushinteger(lua, cell.actorCount);
+    lua_setfield(lua, -2, "actorCount");
+
+    lua_newtable(lua);
+    int index = 1;
+    for (unsigned short pid : cell.pids)
+    {
+        lua_pushinteger(lua, pid);
+        lua_rawseti(lua, -2, index++);
+    }
+    lua_setfield(lua, -2, "pids");
+
+    return 1;
+}
+
+void IsolatedScriptAPI::LoadScript(const char *script, const char *base)
+{
+    char path[4096];
+    snprintf(path, sizeof(path), Utils::convertPath("%s/%s/%s").c_str(), base, "scripts", script);
+    scripts.emplace_back(new IsolatedScript(script, path));
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Loaded isolated script %s", script);
+}
+
+bool IsolatedScriptAPI::SendMessage(const char *script, const char *name, const char *data)
+{
+    for (auto &isolatedScript : scripts)
+    {
+        if (isolatedScript->GetName() != script)
+            continue;
+
+        IsolatedScript::Message message;
+        message.type = IsolatedScript::Message::CORE_MESSAGE;
+        message.name = name;
+        message.args = {std::string(data)};
+
+        if (snapshotTick != tick)
+            UpdateSnapshot();
+
+        isolatedScript->Post(std::move(message));
+        return true;
+    }
+
+    return false;
+}
+
+std::shared_ptr<const WorldSnapshot> IsolatedScriptAPI::GetSnapshot()
+{
+    return std::atomic_load(&snapshot);
+}
+
+unsigned int IsolatedScriptAPI::Dispatch(IsolatedScript::Message &&message)
+{
+    if (snapshotTick != tick)
+        UpdateSnapshot();
+
+    for (size_t i = 0; i + 1 < scripts.size(); ++i)
+        scripts[i]->Post(IsolatedScript::Message(message));
+
+    scripts.back()->Post(std::move(message));
+
+    return (unsigned int) scripts.size();
+}
+
+void IsolatedScriptAPI::UpdateSnapshot()
+{
+    auto newSnapshot = std::make_shared<WorldSnapshot>();
+
+    for (auto &entry : *Players::getPlayers())
+    {
+        Player *player = entry.second;
+
+        PlayerSnapshot &playerSnapshot = newSnapshot->players[player->getId()];
+        playerSnapshot.pid = player->getId();
+        playerSnapshot.name = player->npc.mName;
+        playerSnapshot.cellDescription = player->cell.getShortDescription();
+        playerSnapshot.level = player->creatureStats.mLevel;
+        playerSnapshot.healthBase = player->creatureStats.mDynamic[0].mBase;
+        playerSnapshot.healthCurrent = player->creatureStats.mDynamic[0].mCurrent;
+        playerSnapshot.magickaBase = player->creatureStats.mDynamic[1].mBase;
+        playerSnapshot.magickaCurrent = player->creatureStats.mDynamic[1].mCurrent;
+        playerSnapshot.fatigueBase = player->creatureStats.mDynamic[2].mBase;
+        playerSnapshot.fatigueCurrent = player->creatureStats.mDynamic[2].mCurrent;
+        playerSnapshot.isLoggedIn = player->getLoadState() == Player::POSTLOADED;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            playerSnapshot.position[i] = player->position.pos[i];
+            playerSnapshot.rotation[i] = player->position.rot[i];
+        }
+
+        for (Cell *cell : *player->getCells())
+        {
+            std::string description = cell->getShortDescription();
+
+            auto inserted = newSnapshot->cells.emplace(description, CellSnapshot());
+            CellSnapshot &cellSnapshot = inserted.first->second;
+            cellSnapshot.pids.push_back(player->getId());
+
+            if (!inserted.second)
+                continue;
+
+            Player *authority = Players::getPlayer(*cell->getAuthority());
+
+            cellSnapshot.description = description;
+            cellSnapshot.authorityPid = authority != nullptr ? authority->getId() : -1;
+            cellSnapshot.actorCount = (unsigned int) cell->getActorList()->baseActors.size();
+        }
+    }
+
+    std::atomic_store(&snapshot, std::shared_ptr<const WorldSnapshot>(std::move(newSnapshot)));
+    snapshotTick = tick;
+}
+
+void IsolatedScriptAPI::Tick()
+{
+    ++tick;
+
+    std::vector<IsolatedScript::OutgoingMessage> outgoing;
+
+    for (auto &script : scripts)
+    {
+        script->TakeOutgoing(outgoing);
+
+        for (auto &message : outgoing)
+        {
+            if (message.type == IsolatedScript::OutgoingMessage::LOG)
+                LOG_MESSAGE_SIMPLE(message.logLevel, "[%s]: %s", script->GetName().c_str(), message.data.c_str());
+            else
+                Script::Call<Script::CallbackIdentity("OnIsolatedScriptMessage")>(script->GetName().c_str(),
+                    message.name.c_str(), message.data.c_str());
+        }
+
+        outgoing.clear();
+    }
+}
+
+void IsolatedScriptAPI::Terminate()
+{
+    scripts.clear();
+    snapshot.reset();
+}
@@ -0,0 +1,174 @@
+#ifndef OPENMW_ISOLATEDSCRIPTAPI_HPP
+#define OPENMW_ISOLATEDSCRIPTAPI_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/any.hpp>
+
+struct lua_State;
+
+namespace mwmp
+{
+    // Read-only copies of server state that isolated scripts can query from their worker threads,
+    // rebuilt by the network thread at most once per tick while events are being dispatched
+    struct PlayerSnapshot
+    {
+        unsigned short pid;
+        std::string name;
+        std::string cellDescription;
+        float position[3];
+        float rotation[3];
+        int level;
+        float healthBase, healthCurrent;
+        float magickaBase, magickaCurrent;
+        float fatigueBase, fatigueCurrent;
+        bool isLoggedIn;
+    };
+
+    struct CellSnapshot
+    {
+        std::string description;
+        std::vector<unsigned short> pids;
+        int authorityPid; // -1 if there is no authority
+        unsigned int actorCount;
+    };
+
+    struct WorldSnapshot
+    {
+        std::unordered_map<unsigned short, PlayerSnapshot> players;
+        std::unordered_map<std::string, CellSnapshot> cells;
+    };
+
+    class IsolatedScript
+    {
+    public:
+        struct Message
+        {
+            enum TYPE
+            {
+                CALLBACK = 0,
+                CORE_MESSAGE
+            };
+
+            int type;
+            std::string name;
+            std::string types; // Only for callbacks, in the same format as callback definitions
+            std::vector<boost::any> args;
+        };
+
+        struct OutgoingMessage
+        {
+            enum TYPE
+            {
+                SCRIPT_MESSAGE = 0,
+                LOG
+            };
+
+            int type;
+            int logLevel;
+            std::string name;
+            std::string data;
+        };
+
+        IsolatedScript(const std::string &name, const std::string &path);
+        ~IsolatedScript();
+
+        IsolatedScript(const IsolatedScript&) = delete;
+        IsolatedScript& operator=(const IsolatedScript&) = delete;
+
+        const std::string &GetName() const;
+
+        void Post(Message &&message);
+        void TakeOutgoing(std::vector<OutgoingMessage> &out);
+
+        static int SendMessage(lua_State *lua) noexcept;
+        static int LogMessage(lua_State *lua) noexcept;
+        static int GetPlayerIds(lua_State *lua) noexcept;
+        static int GetPlayerSnapshot(lua_State *lua) noexcept;
+        static int GetCellSnapshot(lua_State *lua) noexcept;
+
+    private:
+        void Run();
+        void Handle(const Message &message);
+        void PostOutgoing(OutgoingMessage &&message);
+
+        static IsolatedScript *FromLua(lua_State *lua);
+
+        std::string name;
+        lua_State *lua;
+
+        std::shared_ptr<const WorldSnapshot> snapshot; // Only touched by the worker thread
+
+        std::mutex inboxMutex;
+        std::condition_variable inboxCondition;
+        std::deque<Message> inbox;
+        bool stopping;
+
+        std::mutex outboxMutex;
+        std::vector<OutgoingMessage> outbox;
+
+        std::thread worker;
+    };
+
+    class IsolatedScriptAPI
+    {
+    public:
+        static void LoadScript(const char *script, const char *base);
+
+        template<typename... Args>
+        static unsigned int QueueCallback(const char *name, const char *types, Args&&... args)
+        {
+            if (scripts.empty())
+                return 0;
+
+            IsolatedScript::Message message;
+            message.type = IsolatedScript::Message::CALLBACK;
+            message.name = name;
+            message.types = types;
+            message.args = {ToArg(std::forward<Args>(args))...};
+
+            return Dispatch(std::move(message));
+        }
+
+        static bool SendMessage(const char *script, const char *name, const char *data);
+
+        static std::shared_ptr<const WorldSnapshot> GetSnapshot();
+
+        static void Tick();
+        static void Terminate();
+
+    private:
+        static unsigned int Dispatch(IsolatedScript::Message &&message);
+        static void UpdateSnapshot();
+
+        static boost::any ToArg(const char *value)
+        {
+            return std::string(value != nullptr ? value : "");
+        }
+
+        static boost::any ToArg(bool value)
+        {
+            return value;
+        }
+
+        template<typename T>
+        static typename std::enable_if<std::is_arithmetic<T>::value, boost::any>::type ToArg(T value)
+        {
+            return static_cast<double>(value);
+        }
+
+        static std::vector<std::unique_ptr<IsolatedScript>> scripts;
+        static std::shared_ptr<const WorldSnapshot> snapshot;
+        static unsigned long long tick, snapshotTick;
+    };
+}
+
+#endif //OPENMW_ISOLATEDSCRIPTAPI_HPP
@@ -698,6 +698,16 @@ void ActorFunctions::SendActorCellChange(bool sendToOtherVisitors, bool skipAtta
 }
 
 
+const BaseActorList *ActorFunctions::GetReadActorList() noexcept
+{
+    return readActorList;
+}
+
+void ActorFunctions::AddActorData(const BaseActor &actor) noexcept
+{
+    writeActorList.baseActors.push_back(actor);
+}
+
 // All methods below are deprecated versions of methods from above
 
 void ActorFunctions::ReadLastActorList() noexcept
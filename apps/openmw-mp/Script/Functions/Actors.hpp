@@ -129,6 +129,12 @@
     {"GetActorKillerRefNumIndex",              ActorFunctions::GetActorKillerRefNumIndex},\
     {"SetActorRefNumIndex",                    ActorFunctions::SetActorRefNumIndex}
 
+namespace mwmp
+{
+    class BaseActor;
+    class BaseActorList;
+}
+
 class ActorFunctions
 {
 public:
@@ -1022,6 +1028,23 @@ public:
     */
     static void SendActorCellChange(bool sendToOtherVisitors, bool skipAttachedPlayer) noexcept;
 
+    /**
+    * \brief Get the actor list being read, for script languages that can read all of its actors
+    *        in a single call.
+    *
+    * \return The actor list being read, or nullptr if there is none.
+    */
+    static const mwmp::BaseActorList *GetReadActorList() noexcept;
+
+    /**
+    * \brief Add a copy of an actor to the server's currently stored actor list, for script
+    *        languages that can build all of the actors of a list in a single call.
+    *
+    * \param actor The actor.
+    * \return void
+    */
+    static void AddActorData(const mwmp::BaseActor &actor) noexcept;
+
 
     // All methods below are deprecated versions of methods from above
 
@@ -1,6 +1,7 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/openmw-mp/Base/BaseObject.hpp>
 
+#include <apps/openmw-mp/CellController.hpp>
 #include <apps/openmw-mp/Networking.hpp>
 #include <apps/openmw-mp/Player.hpp>
 #include <apps/openmw-mp/Utils.hpp>
@@ -420,6 +421,24 @@ int ObjectFunctions::GetContainerItemActionCount(unsigned int objectIndex, unsig
         .containerItems.at(itemIndex).actionCount;
 }
 
+unsigned int ObjectFunctions::GetObjectContainerRevision(unsigned int index) noexcept
+{
+    return readObjectList->baseObjects.at(index).containerRevision;
+}
+
+bool ObjectFunctions::IsObjectContainerRevisionCurrent(unsigned int index) noexcept
+{
+    const BaseObject &baseObject = readObjectList->baseObjects.at(index);
+
+    if (baseObject.containerRevision == 0)
+        return true;
+
+    unsigned int currentRevision = CellController::get()->getContainerRevision(readObjectList->cell, baseObject);
+
+    // A container without a revision has not been sent by the server since its cell was unloaded
+    return currentRevision == 0 || baseObject.containerRevision == currentRevision;
+}
+
 bool ObjectFunctions::DoesObjectHaveContainer(unsigned int index) noexcept
 {
     return readObjectList->baseObjects.at(index).hasContainer;
@@ -747,6 +766,9 @@ void ObjectFunctions::SendObjectSpawn(bool sendToOtherPlayers, bool skipAttached
 
 void ObjectFunctions::SendObjectDelete(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
 {
+    for (const auto &baseObject : writeObjectList.baseObjects)
+        CellController::get()->removeContainerRevision(writeObjectList.cell, baseObject);
+
     mwmp::ObjectPacket *packet = mwmp::Networking::get().getObjectPacketController()->GetPacket(ID_OBJECT_DELETE);
     packet->setObjectList(&writeObjectList);
     
@@ -890,6 +912,22 @@ void ObjectFunctions::SendDoorDestination(bool sendToOtherPlayers, bool skipAtta
 
 void ObjectFunctions::SendContainer(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
 {
+    bool hasNewRevision = false;
+
+    if (writeObjectList.action != BaseObjectList::REQUEST)
+    {
+        for (auto &&baseObject : writeObjectList.baseObjects)
+        {
+            unsigned int revision = CellController::get()->updateContainerRevision(writeObjectList.cell, baseObject,
+                writeObjectList.action);
+
+            if (revision != baseObject.containerRevision)
+                hasNewRevision = true;
+
+            baseObject.containerRevision = revision;
+        }
+    }
+
     mwmp::ObjectPacket *packet = mwmp::Networking::get().getObjectPacketController()->GetPacket(ID_CONTAINER);
     packet->setObjectList(&writeObjectList);
 
@@ -897,6 +935,22 @@ void ObjectFunctions::SendContainer(bool sendToOtherPlayers, bool skipAttachedPl
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    // The attached player already has these contents, usually because it sent them, but it still
+    // needs the new revisions to base its next changes on, so send them in an ADD without items
+    if (skipAttachedPlayer && hasNewRevision)
+    {
+        BaseObjectList revisionObjectList = writeObjectList;
+        revisionObjectList.action = BaseObjectList::ADD;
+        revisionObjectList.containerSubAction = BaseObjectList::NONE;
+
+        for (auto &&baseObject : revisionObjectList.baseObjects)
+            baseObject.containerItems.clear();
+
+        packet->setObjectList(&revisionObjectList);
+        packet->Send(false);
+        packet->setObjectList(&writeObjectList);
+    }
 }
 
 void ObjectFunctions::SendVideoPlay(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -933,6 +987,16 @@ void ObjectFunctions::SendConsoleCommand(bool sendToOtherPlayers, bool skipAttac
 }
 
 
+const BaseObjectList *ObjectFunctions::GetReadObjectList() noexcept
+{
+    return readObjectList;
+}
+
+void ObjectFunctions::AddObjectData(const BaseObject &object) noexcept
+{
+    writeObjectList.baseObjects.push_back(object);
+}
+
 // All methods below are deprecated versions of methods from above
 
 void ObjectFunctions::ReadLastObjectList() noexcept
@@ -88,6 +88,9 @@
     {"GetContainerItemSoul",                  ObjectFunctions::GetContainerItemSoul},\
     {"GetContainerItemActionCount",           ObjectFunctions::GetContainerItemActionCount},\
     \
+    {"GetObjectContainerRevision",            ObjectFunctions::GetObjectContainerRevision},\
+    {"IsObjectContainerRevisionCurrent",      ObjectFunctions::IsObjectContainerRevisionCurrent},\
+    \
     {"DoesObjectHaveContainer",               ObjectFunctions::DoesObjectHaveContainer},\
     {"IsObjectDroppedByPlayer",               ObjectFunctions::IsObjectDroppedByPlayer},\
     \
@@ -186,6 +189,12 @@
     {"SetObjectRefNumIndex",                  ObjectFunctions::SetObjectRefNumIndex},\
     {"AddWorldObject",                        ObjectFunctions::AddWorldObject}
 
+namespace mwmp
+{
+    struct BaseObject;
+    class BaseObjectList;
+}
+
 class ObjectFunctions
 {
 public:
@@ -837,6 +846,31 @@ public:
     */
     static int GetContainerItemActionCount(unsigned int objectIndex, unsigned int itemIndex) noexcept;
 
+    /**
+    * \brief Get the container revision that the container changes of the object at a certain
+    *        index in the read object list were based on.
+    *
+    * Note: A revision of 0 means the sender did not have a versioned copy of the container.
+    *
+    * \param index The index of the object.
+    * \return The container revision.
+    */
+    static unsigned int GetObjectContainerRevision(unsigned int index) noexcept;
+
+    /**
+    * \brief Check whether the container changes of the object at a certain index in the read
+    *        object list were based on the latest container revision sent by the server.
+    *
+    * Changes based on an older revision were made against contents that have since been
+    * replaced, so they should be answered with the full current contents instead of being
+    * applied. Containers the server has no revision for, such as ones in cells that were
+    * unloaded since, are always current.
+    *
+    * \param index The index of the object.
+    * \return Whether the container revision is current.
+    */
+    static bool IsObjectContainerRevisionCurrent(unsigned int index) noexcept;
+
     /**
     * \brief Check whether the object at a certain index in the read object list has a container.
     * 
@@ -1497,6 +1531,11 @@ public:
     /**
     * \brief Send a Container packet.
     *
+    * Unless the object list's action is REQUEST, every container in it is stamped with its
+    * container revision, which clients then base their own container changes on. The revision
+    * only advances when the contents actually change, and if the attached player is skipped, it
+    * is still sent the new revisions without the items.
+    *
     * \param sendToOtherPlayers Whether this packet should be sent to players other than the
     *                           player attached to the packet (false by default).
     * \param skipAttachedPlayer Whether the packet should skip being sent to the player attached
@@ -1538,6 +1577,23 @@ public:
     */
     static void SendConsoleCommand(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept;
 
+    /**
+    * \brief Get the object list being read, for script languages that can read all of its
+    *        objects in a single call.
+    *
+    * \return The object list being read, or nullptr if there is none.
+    */
+    static const mwmp::BaseObjectList *GetReadObjectList() noexcept;
+
+    /**
+    * \brief Add a copy of an object to the server's currently stored object list, for script
+    *        languages that can build all of the objects of a list in a single call.
+    *
+    * \param object The object.
+    * \return void
+    */
+    static void AddObjectData(const mwmp::BaseObject &object) noexcept;
+
 
     // All methods below are deprecated versions of methods from above
 
@@ -2,6 +2,9 @@
 #include "LangLua.hpp"
 #include <Script/Script.hpp>
 #include <Script/Types.hpp>
+#if defined(ENABLE_LUA_FFI)
+#include "LuaFFI.hpp"
+#endif
 
 std::set<std::string> LangLua::packagePath;
 std::set<std::string> LangLua::packageCPath;
@@ -182,8 +185,35 @@ void LangLua::LoadProgram(const char *filename)
     for (unsigned i = 0; i < functions_n; i++)
         tes3mp.addCFunction(functions_[i].name, functions_[i].func);
 
+    tes3mp.addCFunction("GetActorListData", LangLua::GetActorListData);
+    tes3mp.addCFunction("GetObjectListData", LangLua::GetObjectListData);
+    tes3mp.addCFunction("AddActors", LangLua::AddActors);
+    tes3mp.addCFunction("AddObjects", LangLua::AddObjects);
+
     tes3mp.endNamespace();
 
+#if defined(ENABLE_LUA_FFI)
+    /*
+        Start of tes3mp addition
+
+        Under LuaJIT, replace the wrappers of plain-data functions with FFI function pointers
+        under the same names
+    */
+    std::vector<LuaFFIBinding> bindings;
+    for (const auto &function : ScriptFunctions::functions)
+    {
+        if (LuaFFI::IsEligible(function.name, function.func.ret, function.func.types))
+            bindings.push_back({function.name, function.func.ret, function.func.types, function.func.addr});
+    }
+
+    lua_getglobal(lua, "tes3mp");
+    LuaFFI::Export(lua, bindings);
+    lua_pop(lua, 1);
+    /*
+        End of tes3mp addition
+    */
+#endif
+
     if ((err = lua_pcall(lua, 0, 0, 0)) != 0) // Run once script for load in memory.
         throw std::runtime_error("Lua script " + std::string(filename) + " error (" + std::to_string(err) + "): \"" +
                             std::string(lua_tostring(lua, -1)) + "\"");
@@ -36,6 +36,68 @@ public:
     static int CreateTimer(lua_State *lua) noexcept;
     static int CreateTimerEx(lua_State *lua);
 
+    /**
+    * \brief Get every actor of the actor list being read as an array of tables, in a single call.
+    *
+    * Each table has the fields of the per-index actor getters: cell, refId, refNum, mpNum, posX/Y/Z,
+    * rotX/Y/Z, healthBase/Current/Modified and the same for magicka and fatigue, equipment (keyed by
+    * slot, each with refId, count, charge and enchantmentCharge), hasPlayerKiller, killerPid,
+    * killerRefId, killerRefNum, killerMpNum, killerName, deathState, spellsActiveAction,
+    * spellsActive (each with id, displayName, stackingState, the caster fields named like the killer
+    * ones and effects with id, arg, magnitude, duration and timeLeft), hasPosition and
+    * hasStatsDynamic.
+    *
+    * Animation, attack, cast and movement data are not included, as no per-index getter exposes them.
+    *
+    * \param table An optional table returned by an earlier call, refilled in place.
+    * \return The array of actor tables.
+    */
+    static int GetActorListData(lua_State *lua) noexcept;
+
+    /**
+    * \brief Get every object of the object list being read as an array of tables, in a single call.
+    *
+    * Each table has the fields of the per-index object getters: isPlayer, pid, refId, refNum, mpNum,
+    * count, charge, enchantmentCharge, soul, goldValue, scale, soundId, state, doorState, lockLevel,
+    * dialogueChoiceType, dialogueChoiceTopic, goldPool, lastGoldRestockHour, lastGoldRestockDay,
+    * hasPlayerActivating and the activatingPid/RefId/RefNum/MpNum/Name fields, hitSuccess, hitDamage,
+    * hitBlock, hitKnockdown, the hitting fields named like the activating ones, summonState,
+    * summonEffectId, summonSpellId, summonDuration, the summoner fields named like the activating
+    * ones, posX/Y/Z, rotX/Y/Z, videoFilename, clientLocals (each with internalIndex, variableType,
+    * intValue and floatValue), containerItems (each with refId, count, charge, enchantmentCharge,
+    * soul and actionCount), containerRevision, isContainerRevisionCurrent, droppedByPlayer and
+    * hasContainer.
+    *
+    * \param table An optional table returned by an earlier call, refilled in place.
+    * \return The array of object tables.
+    */
+    static int GetObjectListData(lua_State *lua) noexcept;
+
+    /**
+    * \brief Add an array of actor tables to the actor list being written, in a single call.
+    *
+    * Tables use the field names of GetActorListData for the values the per-index actor setters take,
+    * plus sound, deathInstant, aiAction, aiTargetPid or aiTargetRefNum and aiTargetMpNum, aiPosX/Y/Z,
+    * aiDistance, aiDuration and aiShouldRepeat. Missing fields keep the defaults AddActor uses.
+    *
+    * \param actors The array of actor tables.
+    * \return void
+    */
+    static int AddActors(lua_State *lua) noexcept;
+
+    /**
+    * \brief Add an array of object tables to the object list being written, in a single call.
+    *
+    * Tables use the field names of GetObjectListData for the values the per-index object setters
+    * take, with pid making the object a player like SetPlayerAsObject, plus volume, pitch,
+    * disarmState, doorTeleportState, doorDestinationCell, doorDestinationPosX/Y/Z and
+    * doorDestinationRotX/Z. Missing fields keep the defaults AddObject uses.
+    *
+    * \param objects The array of object tables.
+    * \return void
+    */
+    static int AddObjects(lua_State *lua) noexcept;
+
     virtual void LoadProgram(const char *filename) override;
     virtual int FreeProgram() override;
     virtual bool IsCallbackPresent(const char *name) override;
@@ -0,0 +1,118 @@
+#include "LuaFFI.hpp"
+
+#include <cstring>
+
+static const char *getCType(char type)
+{
+    switch (type)
+    {
+        case 'v':
+            return "void";
+        case 'b':
+            return "bool";
+        case 'i':
+            return "unsigned int";
+        case 'q':
+            return "int";
+        case 'f':
+            return "double";
+        default:
+            return nullptr;
+    }
+}
+
+bool LuaFFI::IsEligible(const char *name, char ret, const char *types)
+{
+    // Getters and setters only touch packet data, while anything else might trigger an event
+    // that calls back into Lua, which is not allowed from inside an FFI call
+    static const char *prefixes[] = {"Get", "Set", "Is", "Has", "Does"};
+
+    bool hasPrefix = false;
+    for (const char *prefix : prefixes)
+    {
+        if (strncmp(name, prefix, strlen(prefix)) == 0)
+        {
+            hasPrefix = true;
+            break;
+        }
+    }
+
+    if (!hasPrefix)
+        return false;
+
+    // Strings and 64-bit integers are left out because FFI would hand them to scripts
+    // as cdata instead of the Lua strings and numbers they get now
+    return !GetCDeclaration(ret, types).empty();
+}
+
+std::string LuaFFI::GetCDeclaration(char ret, const char *types)
+{
+    const char *retType = getCType(ret);
+
+    if (retType == nullptr)
+        return "";
+
+    std::string declaration = std::string(retType) + " (*)(";
+
+    for (size_t i = 0; types[i] != '\0'; ++i)
+    {
+        const char *argType = getCType(types[i]);
+
+        // FFI converts a number argument to bool with 0 being false, while the lua_CFunction wrappers
+        // use lua_toboolean where only nil and false are, so bool arguments keep going through the wrappers
+        if (argType == nullptr || types[i] == 'v' || types[i] == 'b')
+            return "";
+
+        if (i != 0)
+            declaration += ", ";
+        declaration += argType;
+    }
+
+    return declaration + ")";
+}
+
+unsigned int LuaFFI::Export(lua_State *lua, const std::vector<LuaFFIBinding> &bindings)
+{
+    int table = lua_gettop(lua);
+
+    lua_getglobal(lua, "require");
+    lua_pushstring(lua, "ffi");
+
+    if (lua_pcall(lua, 1, 1, 0) != 0 || !lua_istable(lua, -1))
+    {
+        lua_settop(lua, table);
+        return 0;
+    }
+
+    lua_getfield(lua, -1, "cast");
+    int cast = lua_gettop(lua);
+
+    unsigned int count = 0;
+
+    for (const auto &binding : bindings)
+    {
+        std::string declaration = GetCDeclaration(binding.ret, binding.types);
+
+        if (declaration.empty())
+            continue;
+
+        lua_pushvalue(lua, cast);
+        lua_pushstring(lua, declaration.c_str());
+        lua_pushlightuserdata(lua, binding.addr);
+
+        if (lua_pcall(lua, 2, 1, 0) != 0)
+        {
+            lua_pop(lua, 1);
+            continue;
+        }
+
+        // Namespace tables have metamethods that reject assignments, so set the field directly
+        lua_pushstring(lua, binding.name);
+        lua_insert(lua, -2);
+        lua_rawset(lua, table);
+        ++count;
+    }
+
+    lua_settop(lua, table);
+    return count;
+}
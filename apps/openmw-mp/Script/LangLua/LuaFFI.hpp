@@ -0,0 +1,38 @@
+#ifndef OPENMW_LUAFFI_HPP
+#define OPENMW_LUAFFI_HPP
+
+#include "lua.hpp"
+
+#include <string>
+#include <vector>
+
+struct LuaFFIBinding
+{
+    const char *name;
+    char ret;
+    const char *types;
+    void *addr;
+};
+
+/*
+    Exports script functions to LuaJIT as FFI function pointers, letting the JIT compile calls
+    to them inline instead of going through a lua_CFunction wrapper
+
+    Only functions that are both plain-data and safe to call from compiled traces are eligible,
+    which means numeric arguments, numeric or boolean return values, and no way of reentering the
+    Lua state that called them
+*/
+class LuaFFI
+{
+public:
+    static bool IsEligible(const char *name, char ret, const char *types);
+
+    // Returns an empty string if the type cannot be represented
+    static std::string GetCDeclaration(char ret, const char *types);
+
+    // Replaces the functions of the same names inside the table at the top of the stack,
+    // returning how many were replaced or 0 if this is not LuaJIT
+    static unsigned int Export(lua_State *lua, const std::vector<LuaFFIBinding> &bindings);
+};
+
+#endif //OPENMW_LUAFFI_HPP
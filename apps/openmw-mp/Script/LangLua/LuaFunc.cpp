@@ -1,7 +1,16 @@
+#include <cctype>
 #include <iostream>
 #include "LangLua.hpp"
 #include <Script/API/TimerAPI.hpp>
 #include <Script/API/PublicFnAPI.hpp>
+#include <Script/Functions/Actors.hpp>
+#include <Script/Functions/Objects.hpp>
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+
+#include <apps/openmw-mp/Player.hpp>
+#include <apps/openmw-mp/Utils.hpp>
 
 inline std::vector<boost::any> DefToVec(lua_State *lua, std::string types, int args_begin, int args_n)
 {
@@ -174,3 +183,670 @@ int LangLua::CreateTimerEx(lua_State *lua)
     luabridge::push(lua, id);
     return 1;
 }
+
+/*
+    Bulk accessors that read or build a whole actor or object list in a single call, instead of
+    crossing into C++ once for every field of every index
+*/
+
+static void setField(lua_State *lua, const char *key, double value)
+{
+    lua_pushnumber(lua, value);
+    lua_setfield(lua, -2, key);
+}
+
+static void setField(lua_State *lua, const char *key, const std::string &value)
+{
+    lua_pushlstring(lua, value.c_str(), value.size());
+    lua_setfield(lua, -2, key);
+}
+
+static void setField(lua_State *lua, const char *key, bool value)
+{
+    lua_pushboolean(lua, value);
+    lua_setfield(lua, -2, key);
+}
+
+static double getField(lua_State *lua, const char *key, double defaultValue)
+{
+    lua_getfield(lua, -1, key);
+    double value = lua_isnumber(lua, -1) ? lua_tonumber(lua, -1) : defaultValue;
+    lua_pop(lua, 1);
+    return value;
+}
+
+static std::string getField(lua_State *lua, const char *key, const std::string &defaultValue)
+{
+    lua_getfield(lua, -1, key);
+    std::string value = lua_isstring(lua, -1) ? lua_tostring(lua, -1) : defaultValue;
+    lua_pop(lua, 1);
+    return value;
+}
+
+static bool getField(lua_State *lua, const char *key, bool defaultValue)
+{
+    lua_getfield(lua, -1, key);
+    bool value = lua_isboolean(lua, -1) ? lua_toboolean(lua, -1) != 0 : defaultValue;
+    lua_pop(lua, 1);
+    return value;
+}
+
+static bool hasField(lua_State *lua, const char *key)
+{
+    lua_getfield(lua, -1, key);
+    bool value = !lua_isnil(lua, -1);
+    lua_pop(lua, 1);
+    return value;
+}
+
+// Removes the array entries after the first size ones from the table at the top of the stack
+static void trimArray(lua_State *lua, size_t size)
+{
+    for (size_t i = size + 1; ; ++i)
+    {
+        lua_rawgeti(lua, -1, (int) i);
+        bool isNil = lua_isnil(lua, -1);
+        lua_pop(lua, 1);
+
+        if (isNil)
+            break;
+
+        lua_pushnil(lua);
+        lua_rawseti(lua, -2, (int) i);
+    }
+}
+
+// Leaves the result table on the stack, reusing the one passed as the first argument if there is one
+static void beginListData(lua_State *lua, size_t size)
+{
+    if (lua_istable(lua, 1))
+    {
+        lua_settop(lua, 1);
+
+        // Drop entries left over from a longer list
+        trimArray(lua, size);
+    }
+    else
+    {
+        lua_settop(lua, 0);
+        lua_createtable(lua, (int) size, 0);
+    }
+}
+
+// Pushes the table under an integer key of the table at the top of the stack, reusing the existing one if there is one
+static void beginEntry(lua_State *lua, int key, int fieldCount)
+{
+    lua_rawgeti(lua, -1, key);
+
+    if (!lua_istable(lua, -1))
+    {
+        lua_pop(lua, 1);
+        lua_createtable(lua, 0, fieldCount);
+        lua_pushvalue(lua, -1);
+        lua_rawseti(lua, -3, key);
+    }
+}
+
+// Pushes the array under a field of the table at the top of the stack, reusing and trimming the existing one if
+// there is one
+static void beginArrayField(lua_State *lua, const char *key, size_t size)
+{
+    lua_getfield(lua, -1, key);
+
+    if (lua_istable(lua, -1))
+        trimArray(lua, size);
+    else
+    {
+        lua_pop(lua, 1);
+        lua_createtable(lua, (int) size, 0);
+        lua_pushvalue(lua, -1);
+        lua_setfield(lua, -3, key);
+    }
+}
+
+// Pushes the array under a field of the table at the top of the stack and returns its size, or returns 0 and
+// pushes nothing if there is no such array or it is empty
+static size_t getArrayField(lua_State *lua, const char *key)
+{
+    lua_getfield(lua, -1, key);
+
+    size_t size = lua_istable(lua, -1) ? lua_objlen(lua, -1) : 0;
+
+    if (size == 0)
+        lua_pop(lua, 1);
+
+    return size;
+}
+
+// Same fields as the per-index DoesXHavePlayerY, GetXYPid, GetXYRefId, GetXYRefNum, GetXYMpNum and GetXYName functions
+static void setTargetFields(lua_State *lua, const std::string &prefix, const mwmp::Target &target)
+{
+    std::string capitalizedPrefix = prefix;
+    capitalizedPrefix[0] = (char) toupper(capitalizedPrefix[0]);
+
+    setField(lua, ("hasPlayer" + capitalizedPrefix).c_str(), target.isPlayer);
+
+    Player *player = target.isPlayer ? Players::getPlayer(target.guid) : nullptr;
+    setField(lua, (prefix + "Pid").c_str(), player != nullptr ? (double) player->getId() : -1.0);
+
+    setField(lua, (prefix + "RefId").c_str(), target.refId);
+    setField(lua, (prefix + "RefNum").c_str(), (double) target.refNum);
+    setField(lua, (prefix + "MpNum").c_str(), (double) target.mpNum);
+    setField(lua, (prefix + "Name").c_str(), target.name);
+}
+
+// Sets the target from a prefixPid field if there is one, or from prefixRefNum and prefixMpNum fields otherwise,
+// returning whether any of them were found
+static bool getTargetFields(lua_State *lua, const std::string &prefix, mwmp::Target &target)
+{
+    std::string pidKey = prefix + "Pid";
+
+    if (hasField(lua, pidKey.c_str()))
+    {
+        Player *player = Players::getPlayer((unsigned short) getField(lua, pidKey.c_str(), 0.0));
+
+        if (player == nullptr)
+            return false;
+
+        target.isPlayer = true;
+        target.guid = player->guid;
+        return true;
+    }
+
+    std::string refNumKey = prefix + "RefNum";
+    std::string mpNumKey = prefix + "MpNum";
+
+    if (!hasField(lua, refNumKey.c_str()) && !hasField(lua, mpNumKey.c_str()))
+        return false;
+
+    target.isPlayer = false;
+    target.refNum = (unsigned int) getField(lua, refNumKey.c_str(), (double) target.refNum);
+    target.mpNum = (unsigned int) getField(lua, mpNumKey.c_str(), (double) target.mpNum);
+    return true;
+}
+
+static const char *dynamicStatNames[3] = {"health", "magicka", "fatigue"};
+
+int LangLua::GetActorListData(lua_State *lua) noexcept
+{
+    const mwmp::BaseActorList *actorList = ActorFunctions::GetReadActorList();
+    size_t size = actorList != nullptr ? actorList->baseActors.size() : 0;
+
+    beginListData(lua, size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const mwmp::BaseActor &actor = actorList->baseActors[i];
+
+        beginEntry(lua, (int) i + 1, 36);
+
+        setField(lua, "cell", actor.cell.getShortDescription());
+        setField(lua, "refId", actor.refId);
+        setField(lua, "refNum", (double) actor.refNum);
+        setField(lua, "mpNum", (double) actor.mpNum);
+
+        setField(lua, "posX", (double) actor.position.pos[0]);
+        setField(lua, "posY", (double) actor.position.pos[1]);
+        setField(lua, "posZ", (double) actor.position.pos[2]);
+        setField(lua, "rotX", (double) actor.position.rot[0]);
+        setField(lua, "rotY", (double) actor.position.rot[1]);
+        setField(lua, "rotZ", (double) actor.position.rot[2]);
+
+        for (int stat = 0; stat < 3; ++stat)
+        {
+            std::string name = dynamicStatNames[stat];
+            setField(lua, (name + "Base").c_str(), (double) actor.creatureStats.mDynamic[stat].mBase);
+            setField(lua, (name + "Current").c_str(), (double) actor.creatureStats.mDynamic[stat].mCurrent);
+            setField(lua, (name + "Modified").c_str(), (double) actor.creatureStats.mDynamic[stat].mMod);
+        }
+
+        // Keyed by slot, like the per-index equipment functions
+        lua_getfield(lua, -1, "equipment");
+        if (!lua_istable(lua, -1))
+        {
+            lua_pop(lua, 1);
+            lua_createtable(lua, 0, 19);
+            lua_pushvalue(lua, -1);
+            lua_setfield(lua, -3, "equipment");
+        }
+
+        for (int slot = 0; slot < 19; ++slot)
+        {
+            const mwmp::Item &item = actor.equipmentItems[slot];
+
+            beginEntry(lua, slot, 4);
+            setField(lua, "refId", item.refId);
+            setField(lua, "count", (double) item.count);
+            setField(lua, "charge", (double) item.charge);
+            setField(lua, "enchantmentCharge", (double) item.enchantmentCharge);
+            lua_pop(lua, 1);
+        }
+
+        lua_pop(lua, 1);
+
+        setTargetFields(lua, "killer", actor.killer);
+        setField(lua, "deathState", (double) actor.deathState);
+
+        setField(lua, "spellsActiveAction", (double) actor.spellsActiveChanges.action);
+
+        const std::vector<mwmp::ActiveSpell> &activeSpells = actor.spellsActiveChanges.activeSpells;
+        beginArrayField(lua, "spellsActive", activeSpells.size());
+
+        for (size_t spellIndex = 0; spellIndex < activeSpells.size(); ++spellIndex)
+        {
+            const mwmp::ActiveSpell &spell = activeSpells[spellIndex];
+
+            beginEntry(lua, (int) spellIndex + 1, 10);
+            setField(lua, "id", spell.id);
+            setField(lua, "displayName", spell.params.mDisplayName);
+            setField(lua, "stackingState", spell.isStackingSpell);
+            setTargetFields(lua, "caster", spell.caster);
+
+            const std::vector<ESM::ActiveEffect> &effects = spell.params.mEffects;
+            beginArrayField(lua, "effects", effects.size());
+
+            for (size_t effectIndex = 0; effectIndex < effects.size(); ++effectIndex)
+            {
+                const ESM::ActiveEffect &effect = effects[effectIndex];
+
+                beginEntry(lua, (int) effectIndex + 1, 5);
+                setField(lua, "id", (double) effect.mEffectId);
+                setField(lua, "arg", (double) effect.mArg);
+                setField(lua, "magnitude", (double) effect.mMagnitude);
+                setField(lua, "duration", (double) effect.mDuration);
+                setField(lua, "timeLeft", (double) effect.mTimeLeft);
+                lua_pop(lua, 1);
+            }
+
+            lua_pop(lua, 2);
+        }
+
+        lua_pop(lua, 1);
+
+        setField(lua, "hasPosition", actor.hasPositionData);
+        setField(lua, "hasStatsDynamic", actor.hasStatsDynamicData);
+
+        lua_pop(lua, 1);
+    }
+
+    return 1;
+}
+
+int LangLua::GetObjectListData(lua_State *lua) noexcept
+{
+    const mwmp::BaseObjectList *objectList = ObjectFunctions::GetReadObjectList();
+    size_t size = objectList != nullptr ? objectList->baseObjects.size() : 0;
+
+    beginListData(lua, size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const mwmp::BaseObject &object = objectList->baseObjects[i];
+
+        beginEntry(lua, (int) i + 1, 64);
+
+        setField(lua, "isPlayer", object.isPlayer);
+
+        if (object.isPlayer)
+        {
+            Player *player = Players::getPlayer(object.guid);
+            setField(lua, "pid", player != nullptr ? (double) player->getId() : -1.0);
+        }
+        else
+            setField(lua, "pid", -1.0);
+
+        setField(lua, "refId", object.refId);
+        setField(lua, "refNum", (double) object.refNum);
+        setField(lua, "mpNum", (double) object.mpNum);
+        setField(lua, "count", (double) object.count);
+        setField(lua, "charge", (double) object.charge);
+        setField(lua, "enchantmentCharge", object.enchantmentCharge);
+        setField(lua, "soul", object.soul);
+        setField(lua, "goldValue", (double) object.goldValue);
+        setField(lua, "scale", (double) object.scale);
+        setField(lua, "soundId", object.soundId);
+        setField(lua, "state", object.objectState);
+        setField(lua, "doorState", (double) object.doorState);
+        setField(lua, "lockLevel", (double) object.lockLevel);
+        setField(lua, "dialogueChoiceType", (double) object.dialogueChoiceType);
+        setField(lua, "dialogueChoiceTopic", object.topicId);
+        setField(lua, "goldPool", (double) object.goldPool);
+        setField(lua, "lastGoldRestockHour", (double) object.lastGoldRestockHour);
+        setField(lua, "lastGoldRestockDay", (double) object.lastGoldRestockDay);
+
+        setTargetFields(lua, "activating", object.activatingActor);
+
+        setField(lua, "hitSuccess", object.hitAttack.success);
+        setField(lua, "hitDamage", (double) object.hitAttack.damage);
+        setField(lua, "hitBlock", object.hitAttack.block);
+        setField(lua, "hitKnockdown", object.hitAttack.knockdown);
+        setTargetFields(lua, "hitting", object.hittingActor);
+
+        setField(lua, "summonState", object.isSummon);
+        setField(lua, "summonEffectId", (double) object.summonEffectId);
+        setField(lua, "summonSpellId", object.summonSpellId);
+        setField(lua, "summonDuration", (double) object.summonDuration);
+        setTargetFields(lua, "summoner", object.master);
+
+        setField(lua, "posX", (double) object.position.pos[0]);
+        setField(lua, "posY", (double) object.position.pos[1]);
+        setField(lua, "posZ", (double) object.position.pos[2]);
+        setField(lua, "rotX", (double) object.position.rot[0]);
+        setField(lua, "rotY", (double) object.position.rot[1]);
+        setField(lua, "rotZ", (double) object.position.rot[2]);
+
+        setField(lua, "videoFilename", object.videoFilename);
+
+        beginArrayField(lua, "clientLocals", object.clientLocals.size());
+
+        for (size_t localIndex = 0; localIndex < object.clientLocals.size(); ++localIndex)
+        {
+            const mwmp::ClientVariable &clientLocal = object.clientLocals[localIndex];
+
+            beginEntry(lua, (int) localIndex + 1, 4);
+            setField(lua, "internalIndex", (double) clientLocal.internalIndex);
+            setField(lua, "variableType", (double) clientLocal.variableType);
+            setField(lua, "intValue", (double) clientLocal.intValue);
+            setField(lua, "floatValue", (double) clientLocal.floatValue);
+            lua_pop(lua, 1);
+        }
+
+        lua_pop(lua, 1);
+
+        beginArrayField(lua, "containerItems", object.containerItems.size());
+
+        for (size_t itemIndex = 0; itemIndex < object.containerItems.size(); ++itemIndex)
+        {
+            const mwmp::ContainerItem &item = object.containerItems[itemIndex];
+
+            beginEntry(lua, (int) itemIndex + 1, 6);
+            setField(lua, "refId", item.refId);
+            setField(lua, "count", (double) item.count);
+            setField(lua, "charge", (double) item.charge);
+            setField(lua, "enchantmentCharge", item.enchantmentCharge);
+            setField(lua, "soul", item.soul);
+            setField(lua, "actionCount", (double) item.actionCount);
+            lua_pop(lua, 1);
+        }
+
+        lua_pop(lua, 1);
+
+        setField(lua, "containerRevision", (double) object.containerRevision);
+        setField(lua, "isContainerRevisionCurrent", ObjectFunctions::IsObjectContainerRevisionCurrent((unsigned int) i));
+        setField(lua, "droppedByPlayer", object.droppedByPlayer);
+        setField(lua, "hasContainer", object.hasContainer);
+
+        lua_pop(lua, 1);
+    }
+
+    return 1;
+}
+
+int LangLua::AddActors(lua_State *lua) noexcept
+{
+    if (!lua_istable(lua, 1))
+        return 0;
+
+    // Same defaults as the actors the per-index functions start from
+    static const mwmp::BaseActor emptyActor = {};
+
+    size_t size = lua_objlen(lua, 1);
+
+    for (size_t i = 1; i <= size; ++i)
+    {
+        lua_rawgeti(lua, 1, (int) i);
+
+        if (!lua_istable(lua, -1))
+        {
+            lua_pop(lua, 1);
+            continue;
+        }
+
+        mwmp::BaseActor actor = emptyActor;
+
+        std::string cellDescription = getField(lua, "cell", std::string());
+        if (!cellDescription.empty())
+            actor.cell = Utils::getCellFromDescription(cellDescription);
+
+        actor.refId = getField(lua, "refId", std::string());
+        actor.refNum = (unsigned int) getField(lua, "refNum", 0.0);
+        actor.mpNum = (unsigned int) getField(lua, "mpNum", 0.0);
+
+        actor.position.pos[0] = (float) getField(lua, "posX", 0.0);
+        actor.position.pos[1] = (float) getField(lua, "posY", 0.0);
+        actor.position.pos[2] = (float) getField(lua, "posZ", 0.0);
+        actor.position.rot[0] = (float) getField(lua, "rotX", 0.0);
+        actor.position.rot[1] = (float) getField(lua, "rotY", 0.0);
+        actor.position.rot[2] = (float) getField(lua, "rotZ", 0.0);
+
+        for (int stat = 0; stat < 3; ++stat)
+        {
+            std::string name = dynamicStatNames[stat];
+            actor.creatureStats.mDynamic[stat].mBase = (float) getField(lua, (name + "Base").c_str(), 0.0);
+            actor.creatureStats.mDynamic[stat].mCurrent = (float) getField(lua, (name + "Current").c_str(), 0.0);
+            actor.creatureStats.mDynamic[stat].mMod = (float) getField(lua, (name + "Modified").c_str(), 0.0);
+        }
+
+        // Keyed by slot, slots without an entry keep their default like with EquipActorItem
+        lua_getfield(lua, -1, "equipment");
+        if (lua_istable(lua, -1))
+        {
+            for (int slot = 0; slot < 19; ++slot)
+            {
+                lua_rawgeti(lua, -1, slot);
+
+                if (lua_istable(lua, -1))
+                {
+                    mwmp::Item &item = actor.equipmentItems[slot];
+                    item.refId = getField(lua, "refId", std::string());
+                    item.count = (int) getField(lua, "count", 0.0);
+                    item.charge = (int) getField(lua, "charge", -1.0);
+                    item.enchantmentCharge = (float) getField(lua, "enchantmentCharge", -1.0);
+                }
+
+                lua_pop(lua, 1);
+            }
+        }
+        lua_pop(lua, 1);
+
+        actor.sound = getField(lua, "sound", std::string());
+        actor.deathState = (char) getField(lua, "deathState", 0.0);
+        actor.isInstantDeath = getField(lua, "deathInstant", false);
+
+        actor.aiAction = (unsigned int) getField(lua, "aiAction", (double) actor.aiAction);
+        actor.hasAiTarget = getTargetFields(lua, "aiTarget", actor.aiTarget);
+        actor.aiCoordinates.pos[0] = (float) getField(lua, "aiPosX", (double) actor.aiCoordinates.pos[0]);
+        actor.aiCoordinates.pos[1] = (float) getField(lua, "aiPosY", (double) actor.aiCoordinates.pos[1]);
+        actor.aiCoordinates.pos[2] = (float) getField(lua, "aiPosZ", (double) actor.aiCoordinates.pos[2]);
+        actor.aiDistance = (unsigned int) getField(lua, "aiDistance", (double) actor.aiDistance);
+        actor.aiDuration = (unsigned int) getField(lua, "aiDuration", (double) actor.aiDuration);
+        actor.aiShouldRepeat = getField(lua, "aiShouldRepeat", actor.aiShouldRepeat);
+
+        actor.spellsActiveChanges.action = (int) getField(lua, "spellsActiveAction",
+            (double) actor.spellsActiveChanges.action);
+
+        size_t spellCount = getArrayField(lua, "spellsActive");
+        for (size_t spellIndex = 1; spellIndex <= spellCount; ++spellIndex)
+        {
+            lua_rawgeti(lua, -1, (int) spellIndex);
+
+            if (lua_istable(lua, -1))
+            {
+                mwmp::ActiveSpell spell;
+                spell.id = getField(lua, "id", std::string());
+                spell.params.mDisplayName = getField(lua, "displayName", std::string());
+                spell.isStackingSpell = getField(lua, "stackingState", false);
+
+                size_t effectCount = getArrayField(lua, "effects");
+                for (size_t effectIndex = 1; effectIndex <= effectCount; ++effectIndex)
+                {
+                    lua_rawgeti(lua, -1, (int) effectIndex);
+
+                    if (lua_istable(lua, -1))
+                    {
+                        ESM::ActiveEffect effect;
+                        effect.mEffectId = (int) getField(lua, "id", 0.0);
+                        effect.mArg = (int) getField(lua, "arg", 0.0);
+                        effect.mMagnitude = (float) getField(lua, "magnitude", 0.0);
+                        effect.mDuration = (float) getField(lua, "duration", 0.0);
+                        effect.mTimeLeft = (float) getField(lua, "timeLeft", 0.0);
+                        spell.params.mEffects.push_back(effect);
+                    }
+
+                    lua_pop(lua, 1);
+                }
+                if (effectCount > 0)
+                    lua_pop(lua, 1);
+
+                actor.spellsActiveChanges.activeSpells.push_back(spell);
+            }
+
+            lua_pop(lua, 1);
+        }
+        if (spellCount > 0)
+            lua_pop(lua, 1);
+
+        ActorFunctions::AddActorData(actor);
+
+        lua_pop(lua, 1);
+    }
+
+    return 0;
+}
+
+int LangLua::AddObjects(lua_State *lua) noexcept
+{
+    if (!lua_istable(lua, 1))
+        return 0;
+
+    // Same defaults as the objects and container items the per-index functions start from
+    static const mwmp::BaseObject emptyObject = {};
+    static const mwmp::ContainerItem emptyContainerItem = {};
+
+    size_t size = lua_objlen(lua, 1);
+
+    for (size_t i = 1; i <= size; ++i)
+    {
+        lua_rawgeti(lua, 1, (int) i);
+
+        if (!lua_istable(lua, -1))
+        {
+            lua_pop(lua, 1);
+            continue;
+        }
+
+        mwmp::BaseObject object = emptyObject;
+
+        if (hasField(lua, "pid"))
+        {
+            Player *player = Players::getPlayer((unsigned short) getField(lua, "pid", 0.0));
+
+            if (player != nullptr)
+            {
+                object.guid = player->guid;
+                object.isPlayer = true;
+            }
+        }
+
+        object.refId = getField(lua, "refId", std::string());
+        object.refNum = (unsigned int) getField(lua, "refNum", 0.0);
+        object.mpNum = (unsigned int) getField(lua, "mpNum", 0.0);
+        object.count = (int) getField(lua, "count", 0.0);
+        object.charge = (int) getField(lua, "charge", 0.0);
+        object.enchantmentCharge = getField(lua, "enchantmentCharge", 0.0);
+        object.soul = getField(lua, "soul", std::string());
+        object.goldValue = (int) getField(lua, "goldValue", 0.0);
+        object.scale = (float) getField(lua, "scale", 0.0);
+        object.objectState = getField(lua, "state", false);
+        object.doorState = (int) getField(lua, "doorState", 0.0);
+        object.lockLevel = (int) getField(lua, "lockLevel", 0.0);
+        object.dialogueChoiceType = (unsigned char) getField(lua, "dialogueChoiceType", 0.0);
+        object.topicId = getField(lua, "dialogueChoiceTopic", std::string());
+        object.goldPool = (unsigned int) getField(lua, "goldPool", 0.0);
+        object.lastGoldRestockHour = (float) getField(lua, "lastGoldRestockHour", 0.0);
+        object.lastGoldRestockDay = (int) getField(lua, "lastGoldRestockDay", 0.0);
+        object.isDisarmed = getField(lua, "disarmState", false);
+        object.droppedByPlayer = getField(lua, "droppedByPlayer", false);
+
+        object.position.pos[0] = (float) getField(lua, "posX", 0.0);
+        object.position.pos[1] = (float) getField(lua, "posY", 0.0);
+        object.position.pos[2] = (float) getField(lua, "posZ", 0.0);
+        object.position.rot[0] = (float) getField(lua, "rotX", 0.0);
+        object.position.rot[1] = (float) getField(lua, "rotY", 0.0);
+        object.position.rot[2] = (float) getField(lua, "rotZ", 0.0);
+
+        object.soundId = getField(lua, "soundId", std::string());
+        object.volume = (float) getField(lua, "volume", 0.0);
+        object.pitch = (float) getField(lua, "pitch", 0.0);
+
+        object.isSummon = getField(lua, "summonState", false);
+        object.summonEffectId = (int) getField(lua, "summonEffectId", 0.0);
+        object.summonSpellId = getField(lua, "summonSpellId", std::string());
+        object.summonDuration = (float) getField(lua, "summonDuration", 0.0);
+        getTargetFields(lua, "summoner", object.master);
+        getTargetFields(lua, "activating", object.activatingActor);
+
+        object.teleportState = getField(lua, "doorTeleportState", false);
+        std::string destinationCell = getField(lua, "doorDestinationCell", std::string());
+        if (!destinationCell.empty())
+            object.destinationCell = Utils::getCellFromDescription(destinationCell);
+        object.destinationPosition.pos[0] = (float) getField(lua, "doorDestinationPosX", 0.0);
+        object.destinationPosition.pos[1] = (float) getField(lua, "doorDestinationPosY", 0.0);
+        object.destinationPosition.pos[2] = (float) getField(lua, "doorDestinationPosZ", 0.0);
+        object.destinationPosition.rot[0] = (float) getField(lua, "doorDestinationRotX", 0.0);
+        object.destinationPosition.rot[2] = (float) getField(lua, "doorDestinationRotZ", 0.0);
+
+        size_t localCount = getArrayField(lua, "clientLocals");
+        for (size_t localIndex = 1; localIndex <= localCount; ++localIndex)
+        {
+            lua_rawgeti(lua, -1, (int) localIndex);
+
+            if (lua_istable(lua, -1))
+            {
+                mwmp::ClientVariable clientLocal;
+                clientLocal.internalIndex = (int) getField(lua, "internalIndex", 0.0);
+                clientLocal.variableType = (char) getField(lua, "variableType", (double) mwmp::VARIABLE_TYPE::INT);
+
+                // Like AddClientLocalFloat and AddClientLocalInteger, only the value of the variable type is kept
+                if (clientLocal.variableType == mwmp::VARIABLE_TYPE::FLOAT)
+                    clientLocal.floatValue = (float) getField(lua, "floatValue", 0.0);
+                else
+                    clientLocal.intValue = (int) getField(lua, "intValue", 0.0);
+
+                object.clientLocals.push_back(clientLocal);
+            }
+
+            lua_pop(lua, 1);
+        }
+        if (localCount > 0)
+            lua_pop(lua, 1);
+
+        size_t itemCount = getArrayField(lua, "containerItems");
+        for (size_t itemIndex = 1; itemIndex <= itemCount; ++itemIndex)
+        {
+            lua_rawgeti(lua, -1, (int) itemIndex);
+
+            if (lua_istable(lua, -1))
+            {
+                mwmp::ContainerItem item = emptyContainerItem;
+                item.refId = getField(lua, "refId", std::string());
+                item.count = (int) getField(lua, "count", 0.0);
+                item.charge = (int) getField(lua, "charge", 0.0);
+                item.enchantmentCharge = getField(lua, "enchantmentCharge", 0.0);
+                item.soul = getField(lua, "soul", std::string());
+                item.actionCount = (int) getField(lua, "actionCount", 0.0);
+                object.containerItems.push_back(item);
+            }
+
+            lua_pop(lua, 1);
+        }
+        if (itemCount > 0)
+            lua_pop(lua, 1);
+
+        ObjectFunctions::AddObjectData(object);
+
+        lua_pop(lua, 1);
+    }
+
+    return 0;
+}
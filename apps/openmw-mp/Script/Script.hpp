@@ -13,6 +13,10 @@
 
 #include "Networking.hpp"
 
+#if defined (ENABLE_LUA)
+#include "API/IsolatedScriptAPI.hpp"
+#endif
+
 class Script : private ScriptFunctions
 {
     // http://imgur.com/hU0N4EH
@@ -111,6 +115,19 @@ public:
             ++count;
         }
 
+#if defined (ENABLE_LUA)
+        /*
+            Start of tes3mp addition
+
+            Isolated scripts get a copy of every event on their own threads, without being able to
+            return anything back to the caller
+        */
+        count += mwmp::IsolatedScriptAPI::QueueCallback(data.name, data.callback.types, args...);
+        /*
+            End of tes3mp addition
+        */
+#endif
+
         return count;
     }
 };
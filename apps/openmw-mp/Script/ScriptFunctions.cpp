@@ -1,5 +1,8 @@
 #include "ScriptFunctions.hpp"
 #include "API/PublicFnAPI.hpp"
+#if defined(ENABLE_LUA)
+#include "API/IsolatedScriptAPI.hpp"
+#endif
 #include <cstdarg>
 #include <iostream>
 #include <apps/openmw-mp/Player.hpp>
@@ -20,6 +23,8 @@ std::vector<ScriptFunctionData> ScriptFunctions::functions{
             {"FreeTimer",           ScriptFunctions::FreeTimer},
             {"IsTimerElapsed",      ScriptFunctions::IsTimerElapsed},
 
+            {"SendIsolatedScriptMessage", ScriptFunctions::SendIsolatedScriptMessage},
+
             ACTORAPI,
             BOOKAPI,
             CELLAPI,
@@ -64,3 +69,12 @@ boost::any ScriptFunctions::CallPublic(const char *name, va_list args) noexcept
 
     return 0;
 }
+
+bool ScriptFunctions::SendIsolatedScriptMessage(const char *script, const char *name, const char *data) noexcept
+{
+#if defined(ENABLE_LUA)
+    return mwmp::IsolatedScriptAPI::SendMessage(script, name, data);
+#else
+    return false;
+#endif
+}
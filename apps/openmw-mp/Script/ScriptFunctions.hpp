@@ -117,6 +117,20 @@ public:
     */
     static bool IsTimerElapsed(int timerId) noexcept;
 
+    /**
+    * \brief Send a message to an isolated script, which will receive it in its OnCoreMessage
+    *        function on its own thread.
+    *
+    * Isolated scripts reply through their own tes3mp.SendMessage function, which triggers
+    * OnIsolatedScriptMessage on the next server tick.
+    *
+    * \param script The filename of the isolated script.
+    * \param name The name of the message.
+    * \param data The data of the message.
+    * \return Whether an isolated script with that filename exists.
+    */
+    static bool SendIsolatedScriptMessage(const char *script, const char *name, const char *data) noexcept;
+
 
     static std::vector<ScriptFunctionData> functions;
 
@@ -188,7 +202,8 @@ public:
             {"OnClientScriptLocal",      Callback<unsigned short, const char*>()},
             {"OnClientScriptGlobal",     Callback<unsigned short>()},
             {"OnMpNumIncrement",         Callback<int>()},
-            {"OnRequestDataFileList",    Callback<>()}
+            {"OnRequestDataFileList",    Callback<>()},
+            {"OnIsolatedScriptMessage",  Callback<const char*, const char*, const char*>()}
     };
 };
 
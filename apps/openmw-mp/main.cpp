@@ -198,6 +198,7 @@ int main(int argc, char *argv[])
     std::string dataDirectory = Utils::convertPath(pluginHome + "/data");
 
     std::vector<std::string> plugins(Utils::split(mgr.getString("plugins", "Plugins"), ','));
+    std::string isolatedPluginList = mgr.getString("isolatedPlugins", "Plugins");
 
     std::string versionInfo = Utils::getVersionInfo("TES3MP dedicated server", TES3MP_VERSION, version.mCommitHash, TES3MP_PROTO_VERSION);
     LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "%s", versionInfo.c_str());
@@ -241,6 +242,14 @@ int main(int argc, char *argv[])
         for (auto plugin : plugins)
             Script::LoadScript(plugin.c_str(), pluginHome.c_str());
 
+#ifdef ENABLE_LUA
+        if (!isolatedPluginList.empty())
+        {
+            for (auto plugin : Utils::split(isolatedPluginList, ','))
+                mwmp::IsolatedScriptAPI::LoadScript(plugin.c_str(), pluginHome.c_str());
+        }
+#endif
+
         switch (peer->Startup((unsigned) players, &sd, 1))
         {
             case RakNet::CRABNET_STARTED:
@@ -6,6 +6,7 @@
 #include <thread>
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <osgViewer/ViewerEventHandlers>
 #include <osgDB/ReadFile>
@@ -16,7 +17,9 @@
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
 
+#include <components/misc/hash.hpp>
 #include <components/misc/rng.hpp>
+#include <components/misc/stringops.hpp>
 
 #include <components/vfs/manager.hpp>
 #include <components/vfs/registerarchives.hpp>
@@ -24,6 +27,7 @@
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 #include <components/sdlutil/imagetosurface.hpp>
 
+#include <components/resource/nifscenecache.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
@@ -56,6 +60,7 @@
 
 #include "mwgui/windowmanagerimp.hpp"
 
+#include "mwscript/bytecodecache.hpp"
 #include "mwscript/scriptmanagerimp.hpp"
 #include "mwscript/interpretercontext.hpp"
 
@@ -85,6 +90,34 @@ namespace
             Log(Debug::Error) << "SDL error: " << SDL_GetError();
     }
 
+    // Compiled scripts depend on the globals and script locals the content files declare, so a change
+    // to any of them has to invalidate the script cache
+    std::uint64_t getContentFingerprint(const Files::Collections& fileCollections,
+        const std::vector<std::string>& contentFiles, std::uint64_t seed)
+    {
+        std::uint64_t hash = seed;
+
+        for (const std::string& file : contentFiles)
+        {
+            std::string name = Misc::StringUtils::lowerCase(file);
+            hash = Misc::hashFnv1a(name.data(), name.size() + 1, hash);
+
+            boost::filesystem::path filename(file);
+            const Files::MultiDirCollection& col = fileCollections.getCollection(filename.extension().string());
+            if (!col.doesExist(file))
+                continue;
+
+            boost::system::error_code ec;
+            const boost::filesystem::path path = col.getPath(file);
+            const std::uint64_t size = boost::filesystem::file_size(path, ec);
+            const std::int64_t time = boost::filesystem::last_write_time(path, ec);
+            hash = Misc::hashFnv1a(&size, sizeof(size), hash);
+            hash = Misc::hashFnv1a(&time, sizeof(time), hash);
+        }
+
+        return hash;
+    }
+
     struct UserStats
     {
         const std::string mLabel;
@@ -447,8 +480,7 @@ bool OMW::Engine::frame(float frametime)
 
             mResourceSystem->reportStats(frameNumber, stats);
 
-            stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
-            stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
+            mWorkQueue->reportStats(frameNumber, *stats);
 
             mEnvironment.reportStats(frameNumber, *stats);
         }
@@ -794,6 +826,15 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
 
     mResourceSystem.reset(new Resource::ResourceSystem(mVFS.get()));
+    if (Settings::Manager::getBool("cache static nif scenes", "Models"))
+    {
+        // Converted scenes depend on the NIF loader of this build, so they are only valid for this build
+        const Version::Version version = Version::getOpenmwVersion(mResDir.string());
+        const std::string build = version.mVersion + version.mCommitHash;
+        const std::uint64_t maxSize = static_cast<std::uint64_t>(std::max(0, Settings::Manager::getInt("nif scene cache size", "Models"))) * 1024 * 1024;
+        mResourceSystem->getSceneManager()->setNifSceneCache(std::make_unique<Resource::NifSceneCache>(
+            mCfgMgr.getCachePath() / "nif", maxSize, Misc::hashFnv1a(build.data(), build.size())));
+    }
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(false); // keep to Off for now to allow better state sharing
     mResourceSystem->getSceneManager()->setFilterSettings(
         Settings::Manager::getString("texture mag filter", "General"),
@@ -870,7 +911,7 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     // Create the world
     mEnvironment.setWorld( new MWWorld::World (mViewer, rootNode, mResourceSystem.get(), mWorkQueue.get(),
         mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder, mActivationDistanceOverride, mCellName,
-        mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string()));
+        mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string(), mCfgMgr.getCachePath().string()));
     mEnvironment.getWorld()->setupPlayer();
 
     window->setStore(mEnvironment.getWorld()->getStore());
@@ -887,8 +928,11 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     mScriptContext = new MWScript::CompilerContext (MWScript::CompilerContext::Type_Full);
     mScriptContext->setExtensions (&mExtensions);
 
-    mEnvironment.setScriptManager (new MWScript::ScriptManager (mEnvironment.getWorld()->getStore(), *mScriptContext, mWarningsMode,
-        mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>()));
+    MWScript::ScriptManager* scriptManager = new MWScript::ScriptManager (mEnvironment.getWorld()->getStore(),
+        *mScriptContext, mWarningsMode, mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>());
+    scriptManager->setByteCodeCache(std::make_unique<MWScript::ByteCodeCache>(mCfgMgr.getCachePath() / "scriptcache.bin",
+        getContentFingerprint(mFileCollections, mContentFiles, mExtensions.getFingerprint())));
+    mEnvironment.setScriptManager (scriptManager);
 
     // Create game mechanics system
     MWMechanics::MechanicsManager* mechanics = new MWMechanics::MechanicsManager;
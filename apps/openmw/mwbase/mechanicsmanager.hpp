@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <memory>
 #include <set>
 #include <stdint.h>
 
@@ -38,6 +39,11 @@ namespace Loading
     class Listener;
 }
 
+namespace MWMechanics
+{
+    struct PendingPath;
+}
+
 namespace MWBase
 {
     /// \brief Interface for game mechanics manager (implemented in MWMechanics)
@@ -304,6 +310,9 @@ namespace MWBase
 
             virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
 
+            virtual void requestPath(const std::shared_ptr<MWMechanics::PendingPath>& path) = 0;
+            ///< Find the path along with the other paths requested before the next AI update
+
             virtual int getGreetingTimer(const MWWorld::Ptr& ptr) const = 0;
             virtual float getAngleToPlayer(const MWWorld::Ptr& ptr) const  = 0;
             virtual MWMechanics::GreetingState getGreetingState(const MWWorld::Ptr& ptr) const = 0;
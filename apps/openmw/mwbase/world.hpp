@@ -595,6 +595,8 @@ namespace MWBase
             virtual void allowVanityMode(bool allow) = 0;
             virtual bool vanityRotateCamera(float * rot) = 0;
             virtual void adjustCameraDistance(float dist) = 0;
+            /// Stores the position and view direction of the camera in the passed arguments
+            virtual void getCameraView(osg::Vec3f& position, osg::Vec3f& direction) const = 0;
             virtual void applyDeferredPreviewRotationToPlayer(float dt) = 0;
             virtual void disableDeferredPreviewRotation() = 0;
 
@@ -1,5 +1,8 @@
 #include "activespells.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include <components/misc/rng.hpp>
 #include <components/misc/stringops.hpp>
 
@@ -32,9 +35,14 @@ namespace MWMechanics
     {
         bool rebuild = false;
 
+        // Until the next effect runs out there is nothing to erase and the time passed is only added up
+        if (duration > 0 && !mSpellsChanged && mPendingDuration + duration < mNextExpiry)
+            mPendingDuration += duration;
         // Erase no longer active spells and effects
-        if (duration > 0)
+        else if (duration > 0)
         {
+            applyPendingDuration();
+
             TContainer::iterator iter (mSpells.begin());
             while (iter!=mSpells.end())
             {
@@ -98,21 +106,55 @@ namespace MWMechanics
                         ++iter;
                 }
             }
+
+            updateNextExpiry();
         }
 
         if (mSpellsChanged)
         {
             mSpellsChanged = false;
             rebuild = true;
+            updateNextExpiry();
         }
 
         if (rebuild)
             rebuildEffects();
     }
 
+    void ActiveSpells::applyPendingDuration() const
+    {
+        if (mPendingDuration == 0)
+            return;
+
+        for (auto& spell : mSpells)
+        {
+            for (ActiveEffect& effect : spell.second.mEffects)
+                effect.mTimeLeft -= mPendingDuration;
+        }
+
+        mPendingDuration = 0;
+        updateNextExpiry();
+    }
+
+    void ActiveSpells::updateNextExpiry() const
+    {
+        mNextExpiry = std::numeric_limits<float>::max();
+
+        for (const auto& spell : mSpells)
+        {
+            // Spells without effects are erased on the next update
+            if (spell.second.mEffects.empty())
+                mNextExpiry = 0;
+
+            for (const ActiveEffect& effect : spell.second.mEffects)
+                mNextExpiry = std::min(mNextExpiry, effect.mTimeLeft);
+        }
+    }
+
     void ActiveSpells::rebuildEffects() const
     {
         mEffects = MagicEffects();
+        mEffectsRevision = makeMagicEffectsRevision();
 
         for (TIterator iter (begin()); iter!=end(); ++iter)
         {
@@ -128,6 +170,9 @@ namespace MWMechanics
 
     ActiveSpells::ActiveSpells()
         : mSpellsChanged (false)
+        , mEffectsRevision (0)
+        , mPendingDuration (0)
+        , mNextExpiry (std::numeric_limits<float>::max())
     {}
 
     const MagicEffects& ActiveSpells::getMagicEffects() const
@@ -136,8 +181,21 @@ namespace MWMechanics
         return mEffects;
     }
 
+    std::size_t ActiveSpells::getMagicEffectsRevision() const
+    {
+        update(0.f);
+        return mEffectsRevision;
+    }
+
+    bool ActiveSpells::hasEffectsExpiringWithin(float duration) const
+    {
+        return mSpellsChanged || mNextExpiry - mPendingDuration < duration;
+    }
+
     ActiveSpells::TIterator ActiveSpells::begin() const
     {
+        // The time left of the effects is read through the iterators
+        applyPendingDuration();
         return mSpells.begin();
     }
 
@@ -193,6 +251,8 @@ namespace MWMechanics
         End of tes3mp change (major)
     */
     {
+        applyPendingDuration();
+
         TContainer::iterator it(mSpells.find(id));
 
         ActiveSpellParams params;
@@ -291,6 +351,8 @@ namespace MWMechanics
 
     void ActiveSpells::removeEffects(const std::string &id)
     {
+        applyPendingDuration();
+
         for (TContainer::iterator spell = mSpells.begin(); spell != mSpells.end(); ++spell)
         {
             if (spell->first == id)
@@ -311,6 +373,8 @@ namespace MWMechanics
     */
     bool ActiveSpells::removeSpellByTimestamp(const std::string& id, MWWorld::TimeStamp timestamp)
     {
+        applyPendingDuration();
+
         for (TContainer::iterator spell = mSpells.begin(); spell != mSpells.end(); ++spell)
         {
             if (spell->first == id)
@@ -332,6 +396,8 @@ namespace MWMechanics
 
     void ActiveSpells::visitEffectSources(EffectSourceVisitor &visitor) const
     {
+        applyPendingDuration();
+
         for (TContainer::const_iterator it = begin(); it != end(); ++it)
         {
             for (std::vector<ActiveEffect>::const_iterator effectIt = it->second.mEffects.begin();
@@ -348,6 +414,8 @@ namespace MWMechanics
 
     void ActiveSpells::purgeAll(float chance, bool spellOnly)
     {
+        applyPendingDuration();
+
         for (TContainer::iterator it = mSpells.begin(); it != mSpells.end(); )
         {
             const std::string spellId = it->first;
@@ -373,6 +441,8 @@ namespace MWMechanics
 
     void ActiveSpells::purgeEffect(short effectId)
     {
+        applyPendingDuration();
+
         for (TContainer::iterator it = mSpells.begin(); it != mSpells.end(); ++it)
         {
             for (std::vector<ActiveEffect>::iterator effectIt = it->second.mEffects.begin();
@@ -389,6 +459,8 @@ namespace MWMechanics
 
     void ActiveSpells::purgeEffect(short effectId, const std::string& sourceId, int effectIndex)
     {
+        applyPendingDuration();
+
         for (TContainer::iterator it = mSpells.begin(); it != mSpells.end(); ++it)
         {
             for (std::vector<ActiveEffect>::iterator effectIt = it->second.mEffects.begin();
@@ -405,6 +477,8 @@ namespace MWMechanics
 
     void ActiveSpells::purge(int casterActorId)
     {
+        applyPendingDuration();
+
         for (TContainer::iterator it = mSpells.begin(); it != mSpells.end(); ++it)
         {
             for (std::vector<ActiveEffect>::iterator effectIt = it->second.mEffects.begin();
@@ -426,6 +500,8 @@ namespace MWMechanics
     */
     void ActiveSpells::purgeEffectByArg(short effectId, int effectArg)
     {
+        applyPendingDuration();
+
         for (TContainer::iterator it = mSpells.begin(); it != mSpells.end(); ++it)
         {
             for (std::vector<ActiveEffect>::iterator effectIt = it->second.mEffects.begin();
@@ -470,6 +546,8 @@ namespace MWMechanics
 
     void ActiveSpells::purgeCorprusDisease()
     {
+        applyPendingDuration();
+
         for (TContainer::iterator iter = mSpells.begin(); iter!=mSpells.end();)
         {
             bool hasCorprusEffect = false;
@@ -496,11 +574,14 @@ namespace MWMechanics
     void ActiveSpells::clear()
     {
         mSpells.clear();
+        mPendingDuration = 0;
         mSpellsChanged = true;
     }
 
     void ActiveSpells::writeState(ESM::ActiveSpells &state) const
     {
+        applyPendingDuration();
+
         for (TContainer::const_iterator it = mSpells.begin(); it != mSpells.end(); ++it)
         {
             // Stupid copying of almost identical structures. ESM::TimeStamp <-> MWWorld::TimeStamp
@@ -515,6 +596,8 @@ namespace MWMechanics
 
     void ActiveSpells::readState(const ESM::ActiveSpells &state)
     {
+        applyPendingDuration();
+
         for (ESM::ActiveSpells::TContainer::const_iterator it = state.mSpells.begin(); it != state.mSpells.end(); ++it)
         {
             // Stupid copying of almost identical structures. ESM::TimeStamp <-> MWWorld::TimeStamp
@@ -50,6 +50,11 @@ namespace MWMechanics
             mutable TContainer mSpells;
             mutable MagicEffects mEffects;
             mutable bool mSpellsChanged;
+            mutable std::size_t mEffectsRevision;
+
+            // Until an effect runs out, update() only adds up the time passed instead of touching every effect
+            mutable float mPendingDuration;
+            mutable float mNextExpiry; ///< least time left of all effects, without the pending duration
 
             /*
                 Start of tes3mp addition
@@ -63,6 +68,11 @@ namespace MWMechanics
 
             void rebuildEffects() const;
 
+            /// Take the pending duration off the time left of each effect
+            void applyPendingDuration() const;
+
+            void updateNextExpiry() const;
+
             /// Add any effects that are in "from" and not in "addTo" to "addTo"
             void mergeEffects(std::vector<ActiveEffect>& addTo, const std::vector<ActiveEffect>& from);
 
@@ -154,6 +164,13 @@ namespace MWMechanics
 
             const MagicEffects& getMagicEffects() const;
 
+            /// Changes whenever the effects returned by getMagicEffects change
+            std::size_t getMagicEffectsRevision() const;
+
+            /// Whether an effect may have less than \a duration left, otherwise visiting the effects to find the
+            /// ones that are about to expire can be skipped
+            bool hasEffectsExpiringWithin(float duration) const;
+
             void visitEffectSources (MWMechanics::EffectSourceVisitor& visitor) const;
 
             /*
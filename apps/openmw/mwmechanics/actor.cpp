@@ -4,6 +4,19 @@
 
 namespace MWMechanics
 {
+    namespace
+    {
+        std::optional<float> skip(float& skipped, float duration, bool update)
+        {
+            skipped += duration;
+            if (!update)
+                return std::nullopt;
+            const float result = skipped;
+            skipped = 0.f;
+            return result;
+        }
+    }
+
     Actor::Actor(const MWWorld::Ptr &ptr, MWRender::Animation *animation)
     {
         mCharacterController.reset(new CharacterController(ptr, animation));
@@ -58,4 +71,24 @@ namespace MWMechanics
     {
         mIsTurningToPlayer = turning;
     }
+
+    ActorUpdateTier Actor::getUpdateTier() const
+    {
+        return mUpdateTier;
+    }
+
+    void Actor::setUpdateTier(ActorUpdateTier tier)
+    {
+        mUpdateTier = tier;
+    }
+
+    std::optional<float> Actor::skipMechanics(float duration, bool update)
+    {
+        return skip(mSkippedMechanicsDuration, duration, update);
+    }
+
+    std::optional<float> Actor::skipAnimation(float duration, bool update)
+    {
+        return skip(mSkippedAnimationDuration, duration, update);
+    }
 }
@@ -2,6 +2,7 @@
 #define OPENMW_MECHANICS_ACTOR_H
 
 #include <memory>
+#include <optional>
 
 #include "../mwmechanics/actorutil.hpp"
 
@@ -20,6 +21,14 @@ namespace MWMechanics
 {
     class CharacterController;
 
+    /// How often an actor in the processing range is updated
+    enum class ActorUpdateTier
+    {
+        Full, ///< every frame
+        Reduced, ///< mechanics and AI every few frames, animation every frame
+        Hidden ///< mechanics, AI and animation every few frames
+    };
+
     /// @brief Holds temporary state for an actor that will be discarded when the actor leaves the scene.
     class Actor
     {
@@ -48,6 +57,17 @@ namespace MWMechanics
             return mEngageCombat.update(duration);
         }
 
+        ActorUpdateTier getUpdateTier() const;
+        void setUpdateTier(ActorUpdateTier tier);
+
+        /// Add \a duration to the time the mechanics were not updated for.
+        /// @return All of that time when \a update is set, nothing otherwise
+        std::optional<float> skipMechanics(float duration, bool update);
+
+        /// Add \a duration to the time the character controller was not updated for.
+        /// @return All of that time when \a update is set, nothing otherwise
+        std::optional<float> skipAnimation(float duration, bool update);
+
     private:
         std::unique_ptr<CharacterController> mCharacterController;
         int mGreetingTimer{0};
@@ -55,6 +75,9 @@ namespace MWMechanics
         GreetingState mGreetingState{Greet_None};
         bool mIsTurningToPlayer{false};
         Misc::DeviatingPeriodicTimer mEngageCombat{1.0f, 0.25f, Misc::Rng::deviate(0, 0.25f)};
+        ActorUpdateTier mUpdateTier{ActorUpdateTier::Full};
+        float mSkippedMechanicsDuration{0.f};
+        float mSkippedAnimationDuration{0.f};
     };
 
 }
@@ -1,6 +1,9 @@
 #include "actors.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <optional>
+#include <tuple>
 
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
@@ -8,9 +11,16 @@
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/misc/rng.hpp>
+#include <components/misc/stringops.hpp>
 #include <components/misc/mathutil.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/settings.hpp>
 
+#include <osg/Quat>
+#include <osg/Stats>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+
 /*
     Start of tes3mp addition
 
@@ -63,6 +73,7 @@
 #include "summoning.hpp"
 #include "actorutil.hpp"
 #include "tickableeffects.hpp"
+#include "pendingpath.hpp"
 
 namespace
 {
@@ -73,6 +84,43 @@ bool isConscious(const MWWorld::Ptr& ptr)
     return !stats.isDead() && !stats.getKnockedDown();
 }
 
+float getMaxHeadTrackDistance(const MWWorld::Ptr& actor)
+{
+    static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+            .find("fMaxHeadTrackDistance")->mValue.getFloat();
+    static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+            .find("fInteriorHeadTrackMult")->mValue.getFloat();
+    const ESM::Cell* currentCell = actor.getCell()->getCell();
+    if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
+        return fMaxHeadTrackDistance * fInteriorHeadTrackMult;
+    return fMaxHeadTrackDistance;
+}
+
+// Same check as the physics uses, without multithreading support Bullet serializes the ray casts
+bool isBulletThreadSafe()
+{
+    btDbvtBroadphase broadphase;
+    return broadphase.m_rayTestStacks.size() > 1;
+}
+
+// Line of sight queries per work item, small enough to keep all sensing threads busy
+const std::size_t sLineOfSightQueriesPerItem = 16;
+
+class SensingWorkItem : public SceneUtil::WorkItem
+{
+public:
+    explicit SensingWorkItem(std::function<void()>&& function)
+        : mFunction(std::move(function)) {}
+
+    void doWork() override
+    {
+        mFunction();
+    }
+
+private:
+    std::function<void()> mFunction;
+};
+
 int getBoundItemSlot (const std::string& itemId)
 {
     static std::map<std::string, int> boundItemsMap;
@@ -484,14 +532,7 @@ namespace MWMechanics
         if (targetActor.getClass().getCreatureStats(targetActor).isDead())
             return;
 
-        static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fMaxHeadTrackDistance")->mValue.getFloat();
-        static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fInteriorHeadTrackMult")->mValue.getFloat();
-        float maxDistance = fMaxHeadTrackDistance;
-        const ESM::Cell* currentCell = actor.getCell()->getCell();
-        if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
-            maxDistance *= fInteriorHeadTrackMult;
+        const float maxDistance = getMaxHeadTrackDistance(actor);
 
         const osg::Vec3f actor1Pos(actor.getRefData().getPosition().asVec3());
         const osg::Vec3f actor2Pos(targetActor.getRefData().getPosition().asVec3());
@@ -506,7 +547,7 @@ namespace MWMechanics
         actorDirection.z() = 0;
         targetDirection.z() = 0;
         if ((actorDirection * targetDirection > 0 || inCombatOrPursue)
-            && MWBase::Environment::get().getWorld()->getLOS(actor, targetActor) // check LOS and awareness last as it's the most expensive function
+            && getHeadTrackingLOS(actor, targetActor) // check LOS and awareness last as it's the most expensive function
             && MWBase::Environment::get().getMechanicsManager()->awarenessCheck(targetActor, actor))
         {
             sqrHeadTrackDistance = sqrDist;
@@ -841,9 +882,19 @@ namespace MWMechanics
         if (creatureStats.isDeathAnimationFinished())
             return;
 
+        // The effects are only combined again when one of their sources changed
+        const bool hasInventoryStore = creature.getClass().hasInventoryStore(creature);
+        MagicEffectSources sources;
+        sources.mSpells = creatureStats.getSpells().getMagicEffectsRevision();
+        if (hasInventoryStore)
+            sources.mEquipment = creature.getClass().getInventoryStore(creature).getMagicEffectsRevision();
+        sources.mActiveSpells = creatureStats.getActiveSpells().getMagicEffectsRevision();
+        if (creatureStats.hasMagicEffectSources(sources))
+            return;
+
         MagicEffects now = creatureStats.getSpells().getMagicEffects();
 
-        if (creature.getClass().hasInventoryStore(creature))
+        if (hasInventoryStore)
         {
             MWWorld::InventoryStore& store = creature.getClass().getInventoryStore (creature);
             now += store.getMagicEffects();
@@ -851,7 +902,7 @@ namespace MWMechanics
 
         now += creatureStats.getActiveSpells().getMagicEffects();
 
-        creatureStats.modifyMagicEffects(now);
+        creatureStats.modifyMagicEffects(now, sources);
     }
 
     void Actors::calculateDynamicStats (const MWWorld::Ptr& ptr)
@@ -995,7 +1046,10 @@ namespace MWMechanics
                 {
                     CreatureStats& creatureStats = mActor.getClass().getCreatureStats(mActor);
                     if (effectTick(creatureStats, mActor, key, magnitude * remainingTime))
+                    {
                         creatureStats.getMagicEffects().add(key, -magnitude);
+                        creatureStats.invalidateMagicEffectSources();
+                    }
                 }
             }
     };
@@ -1056,8 +1110,11 @@ namespace MWMechanics
             // in case duration > remaining time of effect.
             // One case where this will happen is when the player uses the rest/wait command
             // while there is a tickable effect active that should expire before the end of the rest/wait.
-            ExpiryVisitor visitor(ptr, duration);
-            creatureStats.getActiveSpells().visitEffectSources(visitor);
+            if (creatureStats.getActiveSpells().hasEffectsExpiringWithin(duration))
+            {
+                ExpiryVisitor visitor(ptr, duration);
+                creatureStats.getActiveSpells().visitEffectSources(visitor);
+            }
 
             for (MagicEffects::Collection::const_iterator it = effects.begin(); it != effects.end(); ++it)
             {
@@ -1688,10 +1745,27 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors() : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    Actors::Actors()
+        : mActorGrid(512.f)
+        , mActorGridValid(false)
+        , mFullRateDistance(Settings::Manager::getFloat("actor full rate distance", "Game"))
+        , mReducedUpdateInterval(static_cast<unsigned int>(std::max(1, Settings::Manager::getInt("actor reduced update interval", "Game"))))
+        , mHiddenUpdateInterval(static_cast<unsigned int>(std::max(1, Settings::Manager::getInt("actor hidden update interval", "Game"))))
+        , mUpdateFrame(0)
+        , mUpdateTierCounts {}
+        , mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
     {
         mTimerDisposeSummonsCorpses = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
 
+        const int sensingThreads = Settings::Manager::getInt("actor sensing threads", "Game");
+        if (sensingThreads > 0)
+        {
+            if (isBulletThreadSafe())
+                mSensingQueue = new SceneUtil::WorkQueue(sensingThreads);
+            else
+                Log(Debug::Warning) << "Bullet was not compiled with multithreading support, actor sensing threads will not be used";
+        }
+
         updateProcessingRange();
     }
 
@@ -1728,6 +1802,18 @@ namespace MWMechanics
         mActorsProcessingRange = actorsProcessingRange;
     }
 
+    void Actors::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Mechanics FullRateActors", mUpdateTierCounts[static_cast<std::size_t>(ActorUpdateTier::Full)]);
+        stats.setAttribute(frameNumber, "Mechanics ReducedRateActors", mUpdateTierCounts[static_cast<std::size_t>(ActorUpdateTier::Reduced)]);
+        stats.setAttribute(frameNumber, "Mechanics HiddenActors", mUpdateTierCounts[static_cast<std::size_t>(ActorUpdateTier::Hidden)]);
+    }
+
+    void Actors::requestPath(const std::shared_ptr<PendingPath>& path)
+    {
+        mRequestedPaths.push_back(path);
+    }
+
     void Actors::addActor (const MWWorld::Ptr& ptr, bool updateImmediately)
     {
         removeActor(ptr);
@@ -1736,6 +1822,7 @@ namespace MWMechanics
         if (!anim)
             return;
         mActors.insert(std::make_pair(ptr, new Actor(ptr, anim)));
+        mActorGridValid = false;
 
         CharacterController* ctrl = mActors[ptr]->getCharacterController();
         if (updateImmediately)
@@ -1785,6 +1872,7 @@ namespace MWMechanics
         {
             delete iter->second;
             mActors.erase(iter);
+            mActorGridValid = false;
         }
     }
 
@@ -1837,6 +1925,7 @@ namespace MWMechanics
 
             actor->updatePtr(ptr);
             mActors.insert(std::make_pair(ptr, actor));
+            mActorGridValid = false;
         }
     }
 
@@ -1849,6 +1938,7 @@ namespace MWMechanics
             {
                 delete iter->second;
                 mActors.erase(iter++);
+                mActorGridValid = false;
             }
             else
                 ++iter;
@@ -1911,6 +2001,7 @@ namespace MWMechanics
 
         MWWorld::Ptr player = getPlayer();
         MWBase::World* world = MWBase::Environment::get().getWorld();
+        std::vector<MWWorld::Ptr> neighbours;
         for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
         {
             const MWWorld::Ptr& ptr = iter->first;
@@ -1969,10 +2060,11 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
-            // Iterate through all other actors and predict collisions.
-            for(PtrActorMap::iterator otherIter(mActors.begin()); otherIter != mActors.end(); ++otherIter)
+            // Iterate through the other actors close enough to check and predict collisions.
+            neighbours.clear();
+            getActorsInRange(basePos, maxDistToCheck, neighbours);
+            for (const MWWorld::Ptr& otherPtr : neighbours)
             {
-                const MWWorld::Ptr& otherPtr = otherIter->first;
                 if (otherPtr == ptr || otherPtr == currentTarget)
                     continue;
 
@@ -2062,6 +2154,23 @@ namespace MWMechanics
 
             MWWorld::Ptr player = getPlayer();
             const osg::Vec3f playerPos = player.getRefData().getPosition().asVec3();
+            // Third person, preview and vanity cameras do not have to face where the player does
+            osg::Vec3f cameraPos;
+            osg::Vec3f viewDirection;
+            world->getCameraView(cameraPos, viewDirection);
+
+            ++mUpdateFrame;
+            mUpdateTierCounts.fill(0);
+
+            /*
+                Start of tes3mp addition
+
+                Find the cells near other players once, LocalActors in them are updated at full rate
+            */
+            mwmp::PlayerList::getCellsNearPlayers(mExteriorCellsNearPlayers, mInteriorCellsNearPlayers);
+            /*
+                End of tes3mp addition
+            */
 
             /// \todo move update logic to Actor class where appropriate
 
@@ -2078,6 +2187,18 @@ namespace MWMechanics
             }
             bool godmode = MWBase::Environment::get().getWorld()->getGodModeState();
 
+            // Neighbour queries below use the actor positions at the start of the update
+            updateActorGrid();
+            std::vector<MWWorld::Ptr> neighbours;
+
+            // Head tracking needs the most line of sight rays, cast them in parallel before the actors are updated.
+            // Without sensing threads updateHeadTracking casts only the rays it still needs on its own.
+            if (timerUpdateHeadTrack == 0 && mSensingQueue)
+                senseHeadTracking(playerPos, aiActive);
+
+            // Paths AI packages asked for in the last update are found together, the packages pick them up below
+            findRequestedPaths();
+
              // AI and magic effects update
             for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
             {
@@ -2088,6 +2209,12 @@ namespace MWMechanics
                 // AI processing is only done within given distance to the player.
                 bool inProcessingRange = distSqr <= mActorsProcessingRange*mActorsProcessingRange;
 
+                // Far actors update their mechanics and AI every few frames, with the time passed since the last update
+                const ActorUpdateTier updateTier = getUpdateTier(iter->first, playerPos, cameraPos, viewDirection);
+                iter->second->setUpdateTier(updateTier);
+                ++mUpdateTierCounts[static_cast<std::size_t>(updateTier)];
+                const std::optional<float> mechanicsDuration = iter->second->skipMechanics(duration, isUpdateFrame(iter->first, updateTier));
+
                 /*
                     Start of tes3mp change (minor)
 
@@ -2143,7 +2270,8 @@ namespace MWMechanics
                     End of tes3mp change (major)
                 */
 
-                iter->first.getClass().getCreatureStats(iter->first).getActiveSpells().update(duration);
+                if (mechanicsDuration)
+                    iter->first.getClass().getCreatureStats(iter->first).getActiveSpells().update(*mechanicsDuration);
 
                 const Misc::TimerStatus engageCombatTimerStatus = iter->second->updateEngageCombatTimer(duration);
 
@@ -2159,7 +2287,8 @@ namespace MWMechanics
                 {
                     bool cellChanged = world->hasCellChanged();
                     MWWorld::Ptr actor = iter->first; // make a copy of the map key to avoid it being invalidated when the player teleports
-                    updateActor(actor, duration);
+                    if (mechanicsDuration)
+                        updateActor(actor, *mechanicsDuration);
 
                     // Looping magic VFX update
                     // Note: we need to do this before any of the animations are updated.
@@ -2170,6 +2299,8 @@ namespace MWMechanics
 
                     if (!cellChanged && world->hasCellChanged())
                     {
+                        mActorGridValid = false;
+                        mHeadTrackingQueries.clear();
                         return; // for now abort update of the old cell when cell changes by teleportation magic effect
                                 // a better solution might be to apply cell changes at the end of the frame
                     }
@@ -2186,14 +2317,19 @@ namespace MWMechanics
                     {
                         if (engageCombatTimerStatus == Misc::TimerStatus::Elapsed && (isLocalActor || aiActive))
                         {
-                            if (!isPlayer)
+                            if (!isPlayer) // player is not AI-controlled
+                            {
                                 adjustCommandedActor(iter->first);
 
-                            for(PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
-                            {
-                                if (it->first == iter->first || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(iter->first, it->first, cachedAllies, it->first == player);
+                                // engageCombat ignores actors out of processing range
+                                neighbours.clear();
+                                getActorsInRange(iter->first.getRefData().getPosition().asVec3(), mActorsProcessingRange, neighbours);
+                                for (const MWWorld::Ptr& other : neighbours)
+                                {
+                                    if (other == iter->first)
+                                        continue;
+                                    engageCombat(iter->first, other, cachedAllies, other == player);
+                                }
                             }
                         }
                         if (timerUpdateHeadTrack == 0)
@@ -2212,42 +2348,48 @@ namespace MWMechanics
                             if (!stats.getKnockedDown() && !firstPersonPlayer)
                             {
                                 if (inCombatOrPursue)
+                                {
                                     activePackageTarget = stats.getAiSequence().getActivePackage().getTarget();
-
-                                for (PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
+                                    if (activePackageTarget != iter->first && mActors.count(activePackageTarget))
+                                        updateHeadTracking(iter->first, activePackageTarget, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                                }
+                                else
                                 {
-                                    if (it->first == iter->first)
-                                        continue;
-
-                                    if (inCombatOrPursue && it->first != activePackageTarget)
-                                        continue;
-
-                                    updateHeadTracking(iter->first, it->first, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                                    // Out of combat only actors within the head tracking distance are tracked
+                                    neighbours.clear();
+                                    getActorsInRange(iter->first.getRefData().getPosition().asVec3(), getMaxHeadTrackDistance(iter->first), neighbours);
+                                    for (const MWWorld::Ptr& other : neighbours)
+                                    {
+                                        if (other == iter->first)
+                                            continue;
+
+                                        updateHeadTracking(iter->first, other, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                                    }
                                 }
                             }
 
                             ctrl->setHeadTrackTarget(headTrackTarget);
                         }
 
-                        if (iter->first.getClass().isNpc() && iter->first != player && (isLocalActor || aiActive))
-                            updateCrimePursuit(iter->first, duration);
+                        if (iter->first.getClass().isNpc() && iter->first != player && (isLocalActor || aiActive) && mechanicsDuration)
+                            updateCrimePursuit(iter->first, *mechanicsDuration);
 
-                        if (iter->first != player && (isLocalActor || aiActive))
+                        if (iter->first != player && (isLocalActor || aiActive) && mechanicsDuration)
                         {
                             CreatureStats &stats = iter->first.getClass().getCreatureStats(iter->first);
                             if (isConscious(iter->first))
                             {
-                                stats.getAiSequence().execute(iter->first, *ctrl, duration);
+                                stats.getAiSequence().execute(iter->first, *ctrl, *mechanicsDuration);
                                 updateGreetingState(iter->first, *iter->second, timerUpdateHello > 0);
                                 playIdleDialogue(iter->first);
                                 updateMovementSpeed(iter->first);
                             }
                         }
                     }
-                    else if ((isLocalActor || aiActive) && iter->first != player && isConscious(iter->first))
+                    else if ((isLocalActor || aiActive) && iter->first != player && isConscious(iter->first) && mechanicsDuration)
                     {
                         CreatureStats &stats = iter->first.getClass().getCreatureStats(iter->first);
-                        stats.getAiSequence().execute(iter->first, *ctrl, duration, /*outOfRange*/true);
+                        stats.getAiSequence().execute(iter->first, *ctrl, *mechanicsDuration, /*outOfRange*/true);
                     }
                     /*
                         End of tes3mp change (major)
@@ -2255,11 +2397,14 @@ namespace MWMechanics
 
                     if(iter->first.getClass().isNpc())
                     {
-                        // We can not update drowning state for actors outside of AI distance - they can not resurface to breathe
-                        if (inProcessingRange)
-                            updateDrowning(iter->first, duration, ctrl->isKnockedOut(), isPlayer);
+                        if (mechanicsDuration)
+                        {
+                            // We can not update drowning state for actors outside of AI distance - they can not resurface to breathe
+                            if (inProcessingRange)
+                                updateDrowning(iter->first, *mechanicsDuration, ctrl->isKnockedOut(), isPlayer);
 
-                        calculateNpcStatModifiers(iter->first, duration);
+                            calculateNpcStatModifiers(iter->first, *mechanicsDuration);
+                        }
 
                         if (timerUpdateEquippedLight == 0)
                             updateEquippedLight(iter->first, updateEquippedLightInterval, showTorches);
@@ -2267,6 +2412,8 @@ namespace MWMechanics
                 }
             }
 
+            mHeadTrackingQueries.clear();
+
             static const bool avoidCollisions = Settings::Manager::getBool("NPCs avoid collisions", "Game");
             if (avoidCollisions)
                 predictAndAvoidCollisions(duration);
@@ -2321,7 +2468,13 @@ namespace MWMechanics
                 }
 
                 world->setActorCollisionMode(iter->first, true, !iter->first.getClass().getCreatureStats(iter->first).isDeathAnimationFinished());
-                ctrl->update(duration);
+
+                // Actors out of view are animated every few frames too, they keep moving with their last velocity meanwhile
+                const ActorUpdateTier updateTier = iter->second->getUpdateTier();
+                const std::optional<float> animationDuration = iter->second->skipAnimation(duration,
+                    updateTier != ActorUpdateTier::Hidden || isUpdateFrame(iter->first, updateTier));
+                if (animationDuration)
+                    ctrl->update(*animationDuration);
 
                 updateVisibility(iter->first, ctrl);
             }
@@ -2353,6 +2506,8 @@ namespace MWMechanics
 
             killDeadActors();
             updateSneaking(playerCharacter, duration);
+
+            mActorGridValid = false;
         }
 
         updateCombatMusic();
@@ -2745,15 +2900,21 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out)
     {
-        for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
-        {
-            if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                out.push_back(iter->first);
-        }
+        getActorsInRange(position, radius, out);
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius)
     {
+        if (mActorGridValid)
+        {
+            bool found = false;
+            mActorGrid.forEachInRange(position, radius, [&] (const MWWorld::Ptr& ptr)
+            {
+                found = found || (ptr.getRefData().getPosition().asVec3() - position).length2() <= radius*radius;
+            });
+            return found;
+        }
+
         for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
         {
             if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
@@ -2763,6 +2924,251 @@ namespace MWMechanics
         return false;
     }
 
+    void Actors::updateActorGrid()
+    {
+        mActorGrid.clear();
+        for (PtrActorMap::const_iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
+            mActorGrid.add(iter->first.getRefData().getPosition().asVec3(), iter->first);
+        mActorGridValid = true;
+    }
+
+    void Actors::getActorsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
+    {
+        if (!mActorGridValid)
+        {
+            for (PtrActorMap::const_iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
+            {
+                if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
+                    out.push_back(iter->first);
+            }
+            return;
+        }
+
+        // The grid has the positions from when it was built, check where the actors are now
+        const std::size_t begin = out.size();
+        mActorGrid.forEachInRange(position, radius, [&] (const MWWorld::Ptr& ptr)
+        {
+            if ((ptr.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
+                out.push_back(ptr);
+        });
+        std::sort(out.begin() + begin, out.end());
+    }
+
+    void Actors::senseHeadTracking(const osg::Vec3f& playerPos, bool aiActive)
+    {
+        mHeadTrackingQueries.clear();
+
+        MWBase::World* world = MWBase::Environment::get().getWorld();
+        const MWWorld::Ptr player = getPlayer();
+        std::vector<MWWorld::Ptr> neighbours;
+
+        // Same checks as updateHeadTracking does before its line of sight query. Actors may move or die during
+        // the update, pairs that are not found here are queried by updateHeadTracking itself.
+        const auto addQuery = [&] (const MWWorld::Ptr& actor, const MWWorld::Ptr& target, bool inCombatOrPursue)
+        {
+            if (target == actor || target.getClass().getCreatureStats(target).isDead())
+                return;
+            if (!inCombatOrPursue)
+            {
+                osg::Vec3f actorDirection = actor.getRefData().getBaseNode()->getAttitude() * osg::Vec3f(0,1,0);
+                osg::Vec3f targetDirection(target.getRefData().getPosition().asVec3() - actor.getRefData().getPosition().asVec3());
+                actorDirection.z() = 0;
+                targetDirection.z() = 0;
+                if (actorDirection * targetDirection <= 0)
+                    return;
+            }
+            mHeadTrackingQueries.push_back(LineOfSightQuery {actor, target, false});
+        };
+
+        for (PtrActorMap::const_iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
+        {
+            const MWWorld::Ptr& actor = iter->first;
+            if (!actor.getRefData().getBaseNode())
+                continue;
+
+            CreatureStats& stats = actor.getClass().getCreatureStats(actor);
+            if (stats.isDead() || stats.getKnockedDown() || (actor == player && world->isFirstPerson()))
+                continue;
+
+            if ((playerPos - actor.getRefData().getPosition().asVec3()).length2() > mActorsProcessingRange * mActorsProcessingRange)
+                continue;
+
+            /*
+                Start of tes3mp change (major)
+
+                Head tracking is also done for LocalActors and DedicatedActors
+            */
+            if (!aiActive && !mwmp::Main::get().getCellController()->isLocalActor(actor)
+                && !mwmp::Main::get().getCellController()->isDedicatedActor(actor))
+                continue;
+            /*
+                End of tes3mp change (major)
+            */
+
+            AiSequence& sequence = stats.getAiSequence();
+            if (sequence.isInCombat() || sequence.hasPackage(AiPackageTypeId::Pursue))
+            {
+                const MWWorld::Ptr target = sequence.getActivePackage().getTarget();
+                if (mActors.count(target))
+                    addQuery(actor, target, true);
+            }
+            else
+            {
+                neighbours.clear();
+                getActorsInRange(actor.getRefData().getPosition().asVec3(), getMaxHeadTrackDistance(actor), neighbours);
+                for (const MWWorld::Ptr& other : neighbours)
+                    addQuery(actor, other, false);
+            }
+        }
+
+        std::sort(mHeadTrackingQueries.begin(), mHeadTrackingQueries.end(),
+            [] (const LineOfSightQuery& lhs, const LineOfSightQuery& rhs)
+            {
+                return std::tie(lhs.mActor, lhs.mTarget) < std::tie(rhs.mActor, rhs.mTarget);
+            });
+
+        // Only the ray casts run on the sensing threads, nothing in the world is changed until they are done
+        const auto cast = [world] (LineOfSightQuery* begin, LineOfSightQuery* end)
+        {
+            for (; begin != end; ++begin)
+                begin->mResult = world->getLOS(begin->mActor, begin->mTarget);
+        };
+
+        LineOfSightQuery* const queries = mHeadTrackingQueries.data();
+        const std::size_t size = mHeadTrackingQueries.size();
+        // Casting every expected ray on the main thread would cost more than the ones updateHeadTracking skips
+        if (size <= sLineOfSightQueriesPerItem)
+        {
+            mHeadTrackingQueries.clear();
+            return;
+        }
+
+        std::vector<osg::ref_ptr<SceneUtil::WorkItem>> items;
+        std::size_t begin = 0;
+        for (; begin + sLineOfSightQueriesPerItem < size; begin += sLineOfSightQueriesPerItem)
+        {
+            osg::ref_ptr<SceneUtil::WorkItem> item = new SensingWorkItem(
+                [=] { cast(queries + begin, queries + begin + sLineOfSightQueriesPerItem); });
+            mSensingQueue->addWorkItem(item, SceneUtil::WorkQueue::Priority::High);
+            items.push_back(item);
+        }
+        // The main thread takes the last share instead of only waiting
+        cast(queries + begin, queries + size);
+        for (const auto& item : items)
+            item->waitTillDone();
+    }
+
+    ActorUpdateTier Actors::getUpdateTier(const MWWorld::Ptr& actor, const osg::Vec3f& playerPos,
+                                          const osg::Vec3f& cameraPos, const osg::Vec3f& viewDirection) const
+    {
+        if (mFullRateDistance <= 0 || actor == getPlayer())
+            return ActorUpdateTier::Full;
+
+        const osg::Vec3f actorPos = actor.getRefData().getPosition().asVec3();
+        if ((actorPos - playerPos).length2() <= mFullRateDistance * mFullRateDistance)
+            return ActorUpdateTier::Full;
+
+        // Fights, pursuits and packages that have to run out of range rely on timely updates
+        CreatureStats& stats = actor.getClass().getCreatureStats(actor);
+        AiSequence& sequence = stats.getAiSequence();
+        if (stats.isDead() || sequence.isInCombat() || sequence.hasPackage(AiPackageTypeId::Pursue)
+            || (!sequence.isEmpty() && sequence.getActivePackage().alwaysActive()))
+            return ActorUpdateTier::Full;
+
+        /*
+            Start of tes3mp addition
+
+            DedicatedPlayers and DedicatedActors get their state from packets and need to show it right away
+
+            LocalActors are sent to the other players, who may be standing right next to them while
+            the local player is far away, so keep them at full rate while another player is in or next to their cell
+        */
+        if (mwmp::PlayerList::isDedicatedPlayer(actor) || mwmp::Main::get().getCellController()->isDedicatedActor(actor))
+            return ActorUpdateTier::Full;
+
+        if (isInCellNearPlayers(actor) && mwmp::Main::get().getCellController()->isLocalActor(actor))
+            return ActorUpdateTier::Full;
+        /*
+            End of tes3mp addition
+        */
+
+        // Actors behind the camera are out of view
+        const osg::Vec3f offset = actorPos - cameraPos;
+        if (offset.x() * viewDirection.x() + offset.y() * viewDirection.y() < 0)
+            return ActorUpdateTier::Hidden;
+
+        return ActorUpdateTier::Reduced;
+    }
+
+    /*
+        Start of tes3mp addition
+
+        Check the actor's cell against the cells found near other players at the start of the update
+    */
+    bool Actors::isInCellNearPlayers(const MWWorld::Ptr& actor) const
+    {
+        if (mExteriorCellsNearPlayers.empty() && mInteriorCellsNearPlayers.empty())
+            return false;
+
+        const ESM::Cell* cell = actor.getCell()->getCell();
+        if (cell->isExterior())
+            return mExteriorCellsNearPlayers.count(std::make_pair(cell->getGridX(), cell->getGridY())) != 0;
+
+        return mInteriorCellsNearPlayers.count(Misc::StringUtils::lowerCase(cell->mName)) != 0;
+    }
+    /*
+        End of tes3mp addition
+    */
+
+    bool Actors::isUpdateFrame(const MWWorld::Ptr& actor, ActorUpdateTier tier) const
+    {
+        unsigned int interval = 1;
+        if (tier == ActorUpdateTier::Reduced)
+            interval = mReducedUpdateInterval;
+        else if (tier == ActorUpdateTier::Hidden)
+            interval = mHiddenUpdateInterval;
+        if (interval <= 1)
+            return true;
+
+        // Spread the actors over the frames, so that the same actors are not always updated together
+        const unsigned int phase = static_cast<unsigned int>(actor.getClass().getCreatureStats(actor).getActorId());
+        return (mUpdateFrame + phase) % interval == 0;
+    }
+
+    bool Actors::getHeadTrackingLOS(const MWWorld::Ptr& actor, const MWWorld::Ptr& target) const
+    {
+        const auto key = std::tie(actor, target);
+        const auto it = std::lower_bound(mHeadTrackingQueries.begin(), mHeadTrackingQueries.end(), key,
+            [] (const LineOfSightQuery& query, const auto& value) { return std::tie(query.mActor, query.mTarget) < value; });
+        if (it != mHeadTrackingQueries.end() && it->mActor == actor && it->mTarget == target)
+            return it->mResult;
+        return MWBase::Environment::get().getWorld()->getLOS(actor, target);
+    }
+
+    void Actors::findRequestedPaths()
+    {
+        // Paths the PathFinder does not wait for anymore are only held here
+        mRequestedPaths.erase(std::remove_if(mRequestedPaths.begin(), mRequestedPaths.end(),
+            [] (const std::shared_ptr<PendingPath>& path) { return path.use_count() == 1; }), mRequestedPaths.end());
+
+        if (mRequestedPaths.empty())
+            return;
+
+        std::vector<DetourNavigator::PathRequest> requests;
+        requests.reserve(mRequestedPaths.size());
+        for (const std::shared_ptr<PendingPath>& path : mRequestedPaths)
+            requests.push_back(path->mRequest);
+
+        // Requests of actors with the same half extents share the navmesh lock and query
+        std::vector<DetourNavigator::PathResult> results
+            = MWBase::Environment::get().getWorld()->getNavigator()->findPaths(requests);
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+            mRequestedPaths[i]->mResult = std::move(results[i]);
+
+        mRequestedPaths.clear();
+    }
+
     std::list<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actor)
     {
         std::list<MWWorld::Ptr> list;
@@ -3000,6 +3406,7 @@ namespace MWMechanics
         }
         mActors.clear();
         mDeathCount.clear();
+        mRequestedPaths.clear();
     }
 
     void Actors::updateMagicEffects(const MWWorld::Ptr &ptr)
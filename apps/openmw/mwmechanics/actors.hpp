@@ -1,13 +1,20 @@
 #ifndef GAME_MWMECHANICS_ACTORS_H
 #define GAME_MWMECHANICS_ACTORS_H
 
+#include <array>
 #include <set>
 #include <vector>
 #include <string>
 #include <list>
 #include <map>
+#include <memory>
+
+#include <components/misc/spatialgrid.hpp>
+
+#include <osg/ref_ptr>
 
 #include "../mwmechanics/actorutil.hpp"
+#include "../mwworld/ptr.hpp"
 
 namespace ESM
 {
@@ -18,6 +25,7 @@ namespace ESM
 namespace osg
 {
     class Vec3f;
+    class Stats;
 }
 
 namespace Loading
@@ -25,6 +33,11 @@ namespace Loading
     class Listener;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWWorld
 {
     class Ptr;
@@ -34,8 +47,10 @@ namespace MWWorld
 namespace MWMechanics
 {
     class Actor;
+    enum class ActorUpdateTier;
     class CharacterController;
     class CreatureStats;
+    struct PendingPath;
 
     class Actors
     {
@@ -65,6 +80,38 @@ namespace MWMechanics
 
             void predictAndAvoidCollisions(float duration);
 
+            /// Rebuild the grid of actor positions, used by the neighbour queries until an actor is added or removed
+            void updateActorGrid();
+
+            /// Add the actors at most \a radius away from \a position, in the order of mActors
+            void getActorsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const;
+
+            /// Find the pairs of actors that head tracking will check this frame and cast their line of sight rays
+            /// on the sensing threads, while the world is not changed. Only used when there are sensing threads.
+            void senseHeadTracking(const osg::Vec3f& playerPos, bool aiActive);
+
+            /// Line of sight found by senseHeadTracking, or a new query for pairs it did not expect
+            bool getHeadTrackingLOS(const MWWorld::Ptr& actor, const MWWorld::Ptr& target) const;
+
+            /// Find the paths requested since the last update with one navigator query, before the AI uses them
+            void findRequestedPaths();
+
+            ActorUpdateTier getUpdateTier(const MWWorld::Ptr& actor, const osg::Vec3f& playerPos,
+                                          const osg::Vec3f& cameraPos, const osg::Vec3f& viewDirection) const;
+
+            /*
+                Start of tes3mp addition
+
+                Whether the actor is in or next to a cell another player is in
+            */
+            bool isInCellNearPlayers(const MWWorld::Ptr& actor) const;
+            /*
+                End of tes3mp addition
+            */
+
+            /// Whether an actor in \a tier is updated in the current frame
+            bool isUpdateFrame(const MWWorld::Ptr& actor, ActorUpdateTier tier) const;
+
         public:
 
             Actors();
@@ -89,6 +136,10 @@ namespace MWMechanics
             void updateProcessingRange();
             float getProcessingRange() const;
 
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+            void requestPath(const std::shared_ptr<PendingPath>& path);
+
             void addActor (const MWWorld::Ptr& ptr, bool updateImmediately=false);
             ///< Register an actor for stats management
             ///
@@ -230,9 +281,37 @@ namespace MWMechanics
         void updateVisibility (const MWWorld::Ptr& ptr, CharacterController* ctrl);
         void applyCureEffects (const MWWorld::Ptr& actor);
 
+        struct LineOfSightQuery
+        {
+            MWWorld::Ptr mActor;
+            MWWorld::Ptr mTarget;
+            bool mResult;
+        };
+
         PtrActorMap mActors;
+        Misc::SpatialGrid<MWWorld::Ptr> mActorGrid;
+        bool mActorGridValid;
+        osg::ref_ptr<SceneUtil::WorkQueue> mSensingQueue;
+        std::vector<LineOfSightQuery> mHeadTrackingQueries; // ordered by actor and target
+        std::vector<std::shared_ptr<PendingPath>> mRequestedPaths;
         float mTimerDisposeSummonsCorpses;
         float mActorsProcessingRange;
+        float mFullRateDistance;
+        unsigned int mReducedUpdateInterval;
+        unsigned int mHiddenUpdateInterval;
+        unsigned int mUpdateFrame;
+        std::array<std::size_t, 3> mUpdateTierCounts; // indexed by ActorUpdateTier
+
+        /*
+            Start of tes3mp addition
+
+            Cells near other players, found at the start of each update
+        */
+        std::set<std::pair<int, int>> mExteriorCellsNearPlayers;
+        std::set<std::string> mInteriorCellsNearPlayers;
+        /*
+            End of tes3mp addition
+        */
 
         bool mSmoothMovement;
     };
@@ -44,7 +44,8 @@ MWMechanics::AiPackage::AiPackage(AiPackageTypeId typeId, const Options& options
     mRotateOnTheRunChecks(0),
     mIsShortcutting(false),
     mShortcutProhibited(false),
-    mShortcutFailPos()
+    mShortcutFailPos(),
+    mDestInLOSOnPathRequest(false)
 {
 }
 
@@ -131,24 +132,12 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
         {
             if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
             {
+                // The path is found along with the paths other actors request, the current one is followed until then
                 const auto pathfindingHalfExtents = world->getPathfindingHalfExtents(actor);
-                mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
-                    pathfindingHalfExtents, getNavigatorFlags(actor), getAreaCosts(actor));
+                mPathFinder.requestLimitedPath(actor, position, dest, actor.getCell(), pathfindingHalfExtents,
+                    getNavigatorFlags(actor), getAreaCosts(actor));
                 mRotateOnTheRunChecks = 3;
-
-                // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
-                {
-                    // get point just before dest
-                    auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
-
-                    // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
-                    if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
-                    {
-                        mPathFinder.clearPath();
-                        mPathFinder.addPointToPath(dest);
-                    }
-                }
+                mDestInLOSOnPathRequest = destInLOS;
             }
 
             if (!mPathFinder.getPath().empty()) //Path has points in it
@@ -161,6 +150,27 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
         }
     }
 
+    if (mPathFinder.isPathRequested()
+        && mPathFinder.finishPathRequest(actor, actor.getCell(), getPathGridGraph(actor.getCell())))
+    {
+        // give priority to go directly on target if there is minimal opportunity
+        if (mDestInLOSOnPathRequest && mPathFinder.getPath().size() > 1)
+        {
+            // get point just before dest
+            auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
+
+            // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
+            if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
+            {
+                mPathFinder.clearPath();
+                mPathFinder.addPointToPath(dest);
+            }
+        }
+
+        if (!mPathFinder.getPath().empty() && distance(dest, mPathFinder.getPath().back()) > 100)
+            mPathFinder.addPointToPath(dest);
+    }
+
     const float pointTolerance = getPointTolerance(actor.getClass().getMaxSpeed(actor), duration, halfExtents);
 
     static const bool smoothMovement = Settings::Manager::getBool("smooth movement", "Game");
@@ -168,7 +178,7 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
                        /*shortenIfAlmostStraight=*/smoothMovement, actorCanMoveByZ,
                        halfExtents, getNavigatorFlags(actor));
 
-    if (isDestReached || mPathFinder.checkPathCompleted()) // if path is finished
+    if (isDestReached || (mPathFinder.checkPathCompleted() && !mPathFinder.isPathRequested())) // if path is finished
     {
         // turn to destination point
         zTurn(actor, getZAngleToPoint(position, dest));
@@ -171,6 +171,7 @@ namespace MWMechanics
             bool mShortcutProhibited; // shortcutting may be prohibited after unsuccessful attempt
             osg::Vec3f mShortcutFailPos; // position of last shortcut fail
             float mLastDestinationTolerance = 0;
+            bool mDestInLOSOnPathRequest; // if the destination was in line of sight when the path was requested
 
         private:
             bool isNearInactiveCell(osg::Vec3f position);
@@ -1,5 +1,6 @@
 #include "aisequence.hpp"
 
+#include <algorithm>
 #include <limits>
 
 #include <components/debug/debuglog.hpp>
@@ -23,17 +24,19 @@ namespace MWMechanics
 
 void AiSequence::copy (const AiSequence& sequence)
 {
+    mPackages.reserve(sequence.mPackages.size());
     for (const auto& package : sequence.mPackages)
-        mPackages.push_back(package->clone());
+        insertPackage(mPackages.end(), package->clone());
 
     // We need to keep an AiWander storage, if present - it has a state machine.
     // Not sure about another temporary storages
     sequence.mAiState.copy<AiWanderStorage>(mAiState);
 }
 
-AiSequence::AiSequence() : mDone (false), mRepeat(false), mLastAiPackage(AiPackageTypeId::None) {}
+AiSequence::AiSequence() : mPackageCounts(), mDone (false), mRepeat(false), mLastAiPackage(AiPackageTypeId::None) {}
 
 AiSequence::AiSequence (const AiSequence& sequence)
+    : mPackageCounts()
 {
     copy (sequence);
     mDone = sequence.mDone;
@@ -59,6 +62,30 @@ AiSequence::~AiSequence()
     clear();
 }
 
+AiSequence::AiPackages::iterator AiSequence::insertPackage(AiPackages::const_iterator position, std::unique_ptr<AiPackage>&& package)
+{
+    ++getPackageCount(package->getTypeId());
+    return mPackages.insert(position, std::move(package));
+}
+
+AiSequence::AiPackages::iterator AiSequence::erasePackage(AiPackages::const_iterator position)
+{
+    --getPackageCount((*position)->getTypeId());
+    return mPackages.erase(position);
+}
+
+unsigned short& AiSequence::getPackageCount(AiPackageTypeId typeId)
+{
+    return mPackageCounts[static_cast<std::size_t>(typeId)];
+}
+
+unsigned short AiSequence::getPackageCount(AiPackageTypeId typeId) const
+{
+    if (typeId == AiPackageTypeId::None)
+        return 0;
+    return mPackageCounts[static_cast<std::size_t>(typeId)];
+}
+
 AiPackageTypeId AiSequence::getTypeId() const
 {
     if (mPackages.empty())
@@ -79,6 +106,9 @@ bool AiSequence::getCombatTarget(MWWorld::Ptr &targetActor) const
 
 bool AiSequence::getCombatTargets(std::vector<MWWorld::Ptr> &targetActors) const
 {
+    if (getPackageCount(AiPackageTypeId::Combat) == 0)
+        return !targetActors.empty();
+
     for (auto it = mPackages.begin(); it != mPackages.end(); ++it)
     {
         if ((*it)->getTypeId() == MWMechanics::AiPackageTypeId::Combat)
@@ -88,42 +118,34 @@ bool AiSequence::getCombatTargets(std::vector<MWWorld::Ptr> &targetActors) const
     return !targetActors.empty();
 }
 
-std::list<std::unique_ptr<AiPackage>>::const_iterator AiSequence::begin() const
+AiSequence::AiPackages::const_iterator AiSequence::begin() const
 {
     return mPackages.begin();
 }
 
-std::list<std::unique_ptr<AiPackage>>::const_iterator AiSequence::end() const
+AiSequence::AiPackages::const_iterator AiSequence::end() const
 {
     return mPackages.end();
 }
 
-void AiSequence::erase(std::list<std::unique_ptr<AiPackage>>::const_iterator package)
+void AiSequence::erase(AiPackages::const_iterator package)
 {
     // Not sure if manually terminated packages should trigger mDone, probably not?
-    for(auto it = mPackages.begin(); it != mPackages.end(); ++it)
-    {
-        if (package == it)
-        {
-            mPackages.erase(it);
-            return;
-        }
-    }
-    throw std::runtime_error("can't find package to erase");
+    if (package < mPackages.begin() || package >= mPackages.end())
+        throw std::runtime_error("can't find package to erase");
+    erasePackage(package);
 }
 
 bool AiSequence::isInCombat() const
 {
-    for (auto it = mPackages.begin(); it != mPackages.end(); ++it)
-    {
-        if ((*it)->getTypeId() == AiPackageTypeId::Combat)
-            return true;
-    }
-    return false;
+    return getPackageCount(AiPackageTypeId::Combat) > 0;
 }
 
 bool AiSequence::isEngagedWithActor() const
 {
+    if (getPackageCount(AiPackageTypeId::Combat) == 0)
+        return false;
+
     for (auto it = mPackages.begin(); it != mPackages.end(); ++it)
     {
         if ((*it)->getTypeId() == AiPackageTypeId::Combat)
@@ -138,16 +160,14 @@ bool AiSequence::isEngagedWithActor() const
 
 bool AiSequence::hasPackage(AiPackageTypeId typeId) const
 {
-    for (auto it = mPackages.begin(); it != mPackages.end(); ++it)
-    {
-        if ((*it)->getTypeId() == typeId)
-            return true;
-    }
-    return false;
+    return getPackageCount(typeId) > 0;
 }
 
 bool AiSequence::isInCombat(const MWWorld::Ptr &actor) const
 {
+    if (getPackageCount(AiPackageTypeId::Combat) == 0)
+        return false;
+
     for (auto it = mPackages.begin(); it != mPackages.end(); ++it)
     {
         if ((*it)->getTypeId() == AiPackageTypeId::Combat)
@@ -161,11 +181,14 @@ bool AiSequence::isInCombat(const MWWorld::Ptr &actor) const
 
 void AiSequence::stopCombat()
 {
+    if (getPackageCount(AiPackageTypeId::Combat) == 0)
+        return;
+
     for(auto it = mPackages.begin(); it != mPackages.end(); )
     {
         if ((*it)->getTypeId() == AiPackageTypeId::Combat)
         {
-            it = mPackages.erase(it);
+            it = erasePackage(it);
         }
         else
             ++it;
@@ -174,11 +197,14 @@ void AiSequence::stopCombat()
 
 void AiSequence::stopPursuit()
 {
+    if (getPackageCount(AiPackageTypeId::Pursue) == 0)
+        return;
+
     for(auto it = mPackages.begin(); it != mPackages.end(); )
     {
         if ((*it)->getTypeId() == AiPackageTypeId::Pursue)
         {
-            it = mPackages.erase(it);
+            it = erasePackage(it);
         }
         else
             ++it;
@@ -209,8 +235,7 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
             return;
         }
 
-        auto packageIt = mPackages.begin();
-        MWMechanics::AiPackage* package = packageIt->get();
+        MWMechanics::AiPackage* package = mPackages.front().get();
         if (!package->alwaysActive() && outOfRange)
             return;
 
@@ -237,7 +262,7 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
                 // target disappeared (e.g. summoned creatures)
                 if (target.isEmpty())
                 {
-                    it = mPackages.erase(it);
+                    it = erasePackage(it);
                 }
                 else
                 {
@@ -268,11 +293,10 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
             {
                 assert(itActualCombat != mPackages.end());
                 // move combat package with nearest target to the front
-                mPackages.splice(mPackages.begin(), mPackages, itActualCombat);
+                std::rotate(mPackages.begin(), itActualCombat, std::next(itActualCombat));
             }
 
-            packageIt = mPackages.begin();
-            package = packageIt->get();
+            package = mPackages.front().get();
             packageTypeId = package->getTypeId();
         }
 
@@ -284,11 +308,14 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
                 if (isActualAiPackage(packageTypeId) && (mRepeat || package->getRepeat()))
                 {
                     package->reset();
-                    mPackages.push_back(package->clone());
+                    insertPackage(mPackages.end(), package->clone());
                 }
                 // To account for the rare case where AiPackage::execute() queued another AI package
                 // (e.g. AiPursue executing a dialogue script that uses startCombat)
-                mPackages.erase(packageIt);
+                const auto packageIt = std::find_if(mPackages.begin(), mPackages.end(),
+                    [&] (const auto& v) { return v.get() == package; });
+                if (packageIt != mPackages.end())
+                    erasePackage(packageIt);
                 if (isActualAiPackage(packageTypeId))
                     mDone = true;
             }
@@ -307,6 +334,7 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
 void AiSequence::clear()
 {
     mPackages.clear();
+    mPackageCounts.fill(0);
 }
 
 void AiSequence::stack (const AiPackage& package, const MWWorld::Ptr& actor, bool cancelOther)
@@ -350,7 +378,7 @@ void AiSequence::stack (const AiPackage& package, const MWWorld::Ptr& actor, boo
         {
             if((*it)->canCancel())
             {
-                it = mPackages.erase(it);
+                it = erasePackage(it);
             }
             else
                 ++it;
@@ -370,12 +398,12 @@ void AiSequence::stack (const AiPackage& package, const MWWorld::Ptr& actor, boo
 
         if((*it)->getPriority() <= package.getPriority())
         {
-            mPackages.insert(it, package.clone());
+            insertPackage(it, package.clone());
             return;
         }
     }
 
-    mPackages.push_back(package.clone());
+    insertPackage(mPackages.end(), package.clone());
 
     // Make sure that temporary storage is empty
     if (cancelOther)
@@ -436,7 +464,7 @@ void AiSequence::fill(const ESM::AIPackageList &list)
             ESM::AITarget data = esmPackage.mTarget;
             package = std::make_unique<MWMechanics::AiFollow>(data.mId.toString(), data.mDuration, data.mX, data.mY, data.mZ);
         }
-        mPackages.push_back(std::move(package));
+        insertPackage(mPackages.end(), std::move(package));
     }
 }
 
@@ -523,7 +551,7 @@ void AiSequence::readState(const ESM::AiSequence::AiSequence &sequence)
         if (!package.get())
             continue;
 
-        mPackages.push_back(std::move(package));
+        insertPackage(mPackages.end(), std::move(package));
     }
 
     mLastAiPackage = static_cast<AiPackageTypeId>(sequence.mLastAiPackage);
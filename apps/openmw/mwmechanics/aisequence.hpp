@@ -1,8 +1,9 @@
 #ifndef GAME_MWMECHANICS_AISEQUENCE_H
 #define GAME_MWMECHANICS_AISEQUENCE_H
 
-#include <list>
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "aistate.hpp"
 #include "aipackagetypeid.hpp"
@@ -37,8 +38,17 @@ namespace MWMechanics
     /** The top-most AI package is run each frame. When completed, it is removed from the stack. **/
     class AiSequence
     {
+        public:
+            using AiPackages = std::vector<std::unique_ptr<AiPackage>>;
+
+        private:
+            static constexpr std::size_t sNumPackageTypes = static_cast<std::size_t>(AiPackageTypeId::Cast) + 1;
+
             ///AiPackages to run though
-            std::list<std::unique_ptr<AiPackage>> mPackages;
+            AiPackages mPackages;
+
+            ///Number of packages of each type, answers type queries without visiting the packages
+            std::array<unsigned short, sNumPackageTypes> mPackageCounts;
 
             ///Finished with top AIPackage, set for one frame
             bool mDone;
@@ -53,6 +63,13 @@ namespace MWMechanics
             AiPackageTypeId mLastAiPackage;
             AiState mAiState;
 
+            /// All changes of mPackages go through these to keep mPackageCounts in sync
+            AiPackages::iterator insertPackage(AiPackages::const_iterator position, std::unique_ptr<AiPackage>&& package);
+            AiPackages::iterator erasePackage(AiPackages::const_iterator position);
+
+            unsigned short& getPackageCount(AiPackageTypeId typeId);
+            unsigned short getPackageCount(AiPackageTypeId typeId) const;
+
         public:
             ///Default constructor
             AiSequence();
@@ -66,10 +83,10 @@ namespace MWMechanics
             virtual ~AiSequence();
 
             /// Iterator may be invalidated by any function calls other than begin() or end().
-            std::list<std::unique_ptr<AiPackage>>::const_iterator begin() const;
-            std::list<std::unique_ptr<AiPackage>>::const_iterator end() const;
+            AiPackages::const_iterator begin() const;
+            AiPackages::const_iterator end() const;
 
-            void erase(std::list<std::unique_ptr<AiPackage>>::const_iterator package);
+            void erase(AiPackages::const_iterator package);
 
             /// Returns currently executing AiPackage type
             /** \see enum class AiPackageTypeId **/
@@ -232,6 +232,23 @@ namespace MWMechanics
             mRecalcMagicka = true;
 
         mMagicEffects.setModifiers(effects);
+        mMagicEffectSources.reset();
+    }
+
+    void CreatureStats::modifyMagicEffects(const MagicEffects &effects, const MagicEffectSources& sources)
+    {
+        modifyMagicEffects(effects);
+        mMagicEffectSources = sources;
+    }
+
+    bool CreatureStats::hasMagicEffectSources(const MagicEffectSources& sources) const
+    {
+        return mMagicEffectSources == sources;
+    }
+
+    void CreatureStats::invalidateMagicEffectSources()
+    {
+        mMagicEffectSources.reset();
     }
 
     void CreatureStats::setAiSetting (AiSetting index, Stat<int> value)
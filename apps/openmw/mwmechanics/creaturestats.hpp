@@ -1,6 +1,7 @@
 #ifndef GAME_MWMECHANICS_CREATURESTATS_H
 #define GAME_MWMECHANICS_CREATURESTATS_H
 
+#include <optional>
 #include <set>
 #include <string>
 #include <stdexcept>
@@ -42,6 +43,7 @@ namespace MWMechanics
         Spells mSpells;
         ActiveSpells mActiveSpells;
         MagicEffects mMagicEffects;
+        std::optional<MagicEffectSources> mMagicEffectSources;
         Stat<int> mAiSettings[4];
         AiSequence mAiSequence;
         bool mDead;
@@ -153,6 +155,15 @@ namespace MWMechanics
         /// Set Modifier for each magic effect according to \a effects. Does not touch Base values.
         void modifyMagicEffects(const MagicEffects &effects);
 
+        /// Same, for \a effects combined from \a sources
+        void modifyMagicEffects(const MagicEffects &effects, const MagicEffectSources& sources);
+
+        /// Whether the modifiers were last set from the same revisions of the effect sources
+        bool hasMagicEffectSources(const MagicEffectSources& sources) const;
+
+        /// The modifiers were changed in another way, they have to be combined again on the next update
+        void invalidateMagicEffectSources();
+
         void setAttackingOrSpell(bool attackingOrSpell);
 
         void setLevel(int level);
@@ -193,7 +193,7 @@ namespace MWMechanics
 
     void MagicEffects::writeState(ESM::MagicEffects &state) const
     {
-        // Don't need to save Modifiers, they are recalculated every frame anyway.
+        // Don't need to save Modifiers, they are recalculated from the effect sources anyway.
         for (Collection::const_iterator iter (begin()); iter!=end(); ++iter)
         {
             if (iter->second.getBase() != 0)
@@ -211,4 +211,10 @@ namespace MWMechanics
             mCollection[EffectKey(it->first)].setBase(it->second);
         }
     }
+
+    std::size_t makeMagicEffectsRevision()
+    {
+        static std::size_t revision = 0;
+        return ++revision;
+    }
 }
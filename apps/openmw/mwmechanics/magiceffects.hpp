@@ -1,8 +1,10 @@
 #ifndef GAME_MWMECHANICS_MAGICEFFECTS_H
 #define GAME_MWMECHANICS_MAGICEFFECTS_H
 
+#include <cstddef>
 #include <map>
 #include <string>
+#include <tuple>
 
 namespace ESM
 {
@@ -115,6 +117,24 @@ namespace MWMechanics
             static MagicEffects diff (const MagicEffects& prev, const MagicEffects& now);
             ///< Return changes from \a prev to \a now.
     };
+
+    /// Return a value no earlier call returned. Spells, active spells and equipment tag each version of
+    /// their effects with one, so that actors only combine them again when one of them changed.
+    std::size_t makeMagicEffectsRevision();
+
+    /// Revisions of the effects the magic effect modifiers of an actor are combined from
+    struct MagicEffectSources
+    {
+        std::size_t mSpells = 0;
+        std::size_t mEquipment = 0;
+        std::size_t mActiveSpells = 0;
+    };
+
+    inline bool operator== (const MagicEffectSources& left, const MagicEffectSources& right)
+    {
+        return std::tie(left.mSpells, left.mEquipment, left.mActiveSpells)
+            == std::tie(right.mSpells, right.mEquipment, right.mActiveSpells);
+    }
 }
 
 #endif
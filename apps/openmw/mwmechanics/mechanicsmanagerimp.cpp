@@ -2032,6 +2032,12 @@ namespace MWMechanics
     {
         stats.setAttribute(frameNumber, "Mechanics Actors", mActors.size());
         stats.setAttribute(frameNumber, "Mechanics Objects", mObjects.size());
+        mActors.reportStats(frameNumber, stats);
+    }
+
+    void MechanicsManager::requestPath(const std::shared_ptr<PendingPath>& path)
+    {
+        mActors.requestPath(path);
     }
 
     int MechanicsManager::getGreetingTimer(const MWWorld::Ptr &ptr) const
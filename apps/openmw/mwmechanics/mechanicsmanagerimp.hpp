@@ -255,6 +255,8 @@ namespace MWMechanics
 
             void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
 
+            void requestPath(const std::shared_ptr<PendingPath>& path) override;
+
             int getGreetingTimer(const MWWorld::Ptr& ptr) const override;
             float getAngleToPlayer(const MWWorld::Ptr& ptr) const override;
             GreetingState getGreetingState(const MWWorld::Ptr& ptr) const override;
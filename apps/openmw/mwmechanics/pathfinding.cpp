@@ -10,6 +10,7 @@
 
 #include "../mwbase/world.hpp"
 #include "../mwbase/environment.hpp"
+#include "../mwbase/mechanicsmanager.hpp"
 
 #include "../mwphysics/collisiontype.hpp"
 
@@ -18,6 +19,7 @@
 
 #include "pathgrid.hpp"
 #include "actorutil.hpp"
+#include "pendingpath.hpp"
 
 namespace
 {
@@ -106,6 +108,20 @@ namespace
         return checkAngle && checkDist;
     }
 
+    osg::Vec3f getLimitedPathEnd(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint)
+    {
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        const auto maxDistance = std::min(
+            navigator->getMaxNavmeshAreaRealRadius(),
+            static_cast<float>(Constants::CellSizeInUnits)
+        );
+        const auto startToEnd = endPoint - startPoint;
+        const auto distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
+
     struct IsValidShortcut
     {
         const DetourNavigator::Navigator* mNavigator;
@@ -347,6 +363,7 @@ namespace MWMechanics
         mPath.clear();
         mPath.push_back(endPoint);
         mConstructed = true;
+        mPathRequest = nullptr;
     }
 
     void PathFinder::buildPathByPathgrid(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
@@ -354,6 +371,7 @@ namespace MWMechanics
     {
         mPath.clear();
         mCell = cell;
+        mPathRequest = nullptr;
 
         buildPathByPathgridImpl(startPoint, endPoint, pathgridGraph, std::back_inserter(mPath));
 
@@ -365,6 +383,7 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts)
     {
         mPath.clear();
+        mPathRequest = nullptr;
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
         DetourNavigator::Status status = buildPathByNavigatorImpl(actor, startPoint, endPoint, halfExtents, flags,
@@ -385,6 +404,7 @@ namespace MWMechanics
     {
         mPath.clear();
         mCell = cell;
+        mPathRequest = nullptr;
 
         DetourNavigator::Status status = DetourNavigator::Status::NavMeshNotFound;
 
@@ -395,6 +415,13 @@ namespace MWMechanics
                 mPath.clear();
         }
 
+        buildFallbackPath(status, startPoint, endPoint, pathgridGraph, actor, halfExtents, flags, areaCosts);
+    }
+
+    void PathFinder::buildFallbackPath(DetourNavigator::Status status, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const MWWorld::ConstPtr& actor,
+        const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts)
+    {
         if (status != DetourNavigator::Status::NavMeshNotFound && mPath.empty())
         {
             status = buildPathByNavigatorImpl(actor, startPoint, endPoint, halfExtents,
@@ -475,16 +502,57 @@ namespace MWMechanics
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, const osg::Vec3f& halfExtents,
         const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts)
     {
-        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance = std::min(
-            navigator->getMaxNavmeshAreaRealRadius(),
-            static_cast<float>(Constants::CellSizeInUnits)
-        );
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(actor, startPoint, endPoint, cell, pathgridGraph, halfExtents, flags, areaCosts);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
-        buildPath(actor, startPoint, end, cell, pathgridGraph, halfExtents, flags, areaCosts);
+        buildPath(actor, startPoint, getLimitedPathEnd(startPoint, endPoint), cell, pathgridGraph, halfExtents, flags,
+                  areaCosts);
+    }
+
+    void PathFinder::requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const osg::Vec3f& halfExtents,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts)
+    {
+        const DetourNavigator::PathRequest request {halfExtents, getPathStepSize(actor), startPoint,
+                                                    getLimitedPathEnd(startPoint, endPoint), flags, areaCosts};
+        mPathRequest = std::make_shared<PendingPath>(PendingPath {request, std::nullopt});
+        mRequestCell = cell;
+
+        // Same as buildPath, these actors do not walk over the navmesh and only use the fallbacks
+        if (actor.getClass().isPureWaterCreature(actor) || actor.getClass().isPureFlyingCreature(actor))
+            mPathRequest->mResult = DetourNavigator::PathResult {DetourNavigator::Status::NavMeshNotFound, {}};
+        else
+            MWBase::Environment::get().getMechanicsManager()->requestPath(mPathRequest);
+    }
+
+    bool PathFinder::finishPathRequest(const MWWorld::ConstPtr& actor, const MWWorld::CellStore* cell,
+        const PathgridGraph& pathgridGraph)
+    {
+        if (mPathRequest == nullptr || !mPathRequest->mResult.has_value())
+            return false;
+
+        const std::shared_ptr<PendingPath> pendingPath = std::move(mPathRequest);
+
+        // The pathgrid fallback needs the cell the path was requested in
+        if (cell != mRequestCell)
+            return false;
+
+        const DetourNavigator::PathRequest& request = pendingPath->mRequest;
+        const DetourNavigator::PathResult& result = *pendingPath->mResult;
+
+        mPath.clear();
+        mCell = cell;
+
+        if (result.mStatus == DetourNavigator::Status::Success)
+            mPath.assign(result.mPath.begin(), result.mPath.end());
+        else if (result.mStatus != DetourNavigator::Status::NavMeshNotFound)
+        {
+            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(result.mStatus)
+                << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+                << ") from " << request.mStart << " to " << request.mEnd << " with flags ("
+                << DetourNavigator::WriteFlags {request.mIncludeFlags} << ")";
+        }
+
+        buildFallbackPath(result.mStatus, request.mStart, request.mEnd, pathgridGraph, actor,
+                          request.mAgentHalfExtents, request.mIncludeFlags, request.mAreaCosts);
+
+        return true;
     }
 }
@@ -4,6 +4,7 @@
 #include <deque>
 #include <cassert>
 #include <iterator>
+#include <memory>
 
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/areatype.hpp>
@@ -21,6 +22,7 @@ namespace MWWorld
 namespace MWMechanics
 {
     class PathgridGraph;
+    struct PendingPath;
 
     template <class T>
     inline float distance(const T& lhs, const T& rhs)
@@ -76,6 +78,7 @@ namespace MWMechanics
             PathFinder()
                 : mConstructed(false)
                 , mCell(nullptr)
+                , mRequestCell(nullptr)
             {
             }
 
@@ -84,6 +87,7 @@ namespace MWMechanics
                 mConstructed = false;
                 mPath.clear();
                 mCell = nullptr;
+                mPathRequest = nullptr;
             }
 
             void buildStraightPath(const osg::Vec3f& endPoint);
@@ -106,6 +110,23 @@ namespace MWMechanics
                 const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, const osg::Vec3f& halfExtents,
                 const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts);
 
+            /// Same as buildLimitedPath, but the navmesh path is found before the next AI update along with the paths
+            /// other actors request. The current path is kept until finishPathRequest replaces it.
+            void requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+                const MWWorld::CellStore* cell, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
+                const DetourNavigator::AreaCosts& areaCosts);
+
+            bool isPathRequested() const
+            {
+                return mPathRequest != nullptr;
+            }
+
+            /// Build the requested path if it was found, with the same fallbacks as buildPath
+            /// 
+eturn If the path was built
+            bool finishPathRequest(const MWWorld::ConstPtr& actor, const MWWorld::CellStore* cell,
+                const PathgridGraph& pathgridGraph);
+
             /// Remove front point if exist and within tolerance
             void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
                         bool shortenIfAlmostStraight, bool canMoveByZ, const osg::Vec3f& halfExtents,
@@ -207,6 +228,14 @@ namespace MWMechanics
 
             const MWWorld::CellStore* mCell;
 
+            std::shared_ptr<PendingPath> mPathRequest;
+            const MWWorld::CellStore* mRequestCell;
+
+            void buildFallbackPath(DetourNavigator::Status status, const osg::Vec3f& startPoint,
+                const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const MWWorld::ConstPtr& actor,
+                const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
+                const DetourNavigator::AreaCosts& areaCosts);
+
             void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
                 const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
 
@@ -236,7 +236,7 @@ namespace MWMechanics
      * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
      * that mGraph is already constructed.
      *
-     * Should be possible to make this MT safe.
+     * Not MT safe, the path cache is updated without locking.
      *
      * Returns path which may be empty.  path contains pathgrid points in local
      * cell coordinates (indoors) or world coordinates (external).
@@ -250,12 +250,28 @@ namespace MWMechanics
      *   gScore - past accumulated costs vector indexed by point index
      *   fScore - future estimated costs vector indexed by point index
      *
-     * TODO: An intersting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
+     * Paths are cached in pathgrid points form for each start/goal pair, actors
+     * of a cell often walk between the same points.  Essentially trading speed
+     * w/ memory.
      */
     std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const int start, const int goal) const
+    {
+        const auto key = std::make_pair(start, goal);
+        const auto cached = mPaths.find(key);
+        if (cached != mPaths.end())
+            return cached->second;
+
+        std::deque<ESM::Pathgrid::Point> path = searchPath(start, goal);
+
+        // The cache only saves searches, dropping it is cheaper than tracking which paths are used
+        if (mPaths.size() >= sMaxCachedPaths)
+            mPaths.clear();
+        mPaths.emplace(key, path);
+
+        return path;
+    }
+
+    std::deque<ESM::Pathgrid::Point> PathgridGraph::searchPath(const int start, const int goal) const
     {
         std::deque<ESM::Pathgrid::Point> path;
         if(!isPointConnected(start, goal))
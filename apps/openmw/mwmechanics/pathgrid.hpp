@@ -2,6 +2,8 @@
 #define GAME_MWMECHANICS_PATHGRID_H
 
 #include <deque>
+#include <map>
+#include <utility>
 
 #include <components/esm/loadpgrd.hpp>
 
@@ -38,9 +40,12 @@ namespace MWMechanics
             // cells) coordinates
             //
             // NOTE: if start equals end an empty path is returned
+            //
+            // Found paths are cached, the pathgrid does not change while the graph exists
             std::deque<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
 
         private:
+            static constexpr std::size_t sMaxCachedPaths = 256;
 
             const ESM::Cell *mCell;
             const ESM::Pathgrid *mPathgrid;
@@ -69,6 +74,11 @@ namespace MWMechanics
             std::vector<Node> mGraph;
             bool mIsGraphConstructed;
 
+            // key is a pair of start and end pathgrid point indexes
+            mutable std::map<std::pair<int, int>, std::deque<ESM::Pathgrid::Point>> mPaths;
+
+            std::deque<ESM::Pathgrid::Point> searchPath(const int start, const int goal) const;
+
             // variables used to calculate connected components
             int mSCCId;
             int mSCCIndex;
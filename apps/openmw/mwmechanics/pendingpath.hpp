@@ -0,0 +1,19 @@
+#ifndef GAME_MWMECHANICS_PENDINGPATH_H
+#define GAME_MWMECHANICS_PENDINGPATH_H
+
+#include <components/detournavigator/navigator.hpp>
+
+#include <optional>
+
+namespace MWMechanics
+{
+    /// Navmesh path a PathFinder asked for. Paths asked for during a frame are found together
+    /// before the next AI update, the result is set then.
+    struct PendingPath
+    {
+        DetourNavigator::PathRequest mRequest;
+        std::optional<DetourNavigator::PathResult> mResult;
+    };
+}
+
+#endif
@@ -32,12 +32,14 @@ namespace MWMechanics
 {
     Spells::Spells()
         : mSpellsChanged(false)
+        , mEffectsRevision(0)
     {
     }
 
     Spells::Spells(const Spells& spells) : mSpellList(spells.mSpellList), mSpells(spells.mSpells),
         mSelectedSpell(spells.mSelectedSpell), mUsedPowers(spells.mUsedPowers),
-        mSpellsChanged(spells.mSpellsChanged), mEffects(spells.mEffects), mSourcedEffects(spells.mSourcedEffects)
+        mSpellsChanged(spells.mSpellsChanged), mEffects(spells.mEffects), mEffectsRevision(spells.mEffectsRevision),
+        mSourcedEffects(spells.mSourcedEffects)
     {
         if(mSpellList)
             mSpellList->addListener(this);
@@ -46,7 +48,7 @@ namespace MWMechanics
     Spells::Spells(Spells&& spells) : mSpellList(std::move(spells.mSpellList)), mSpells(std::move(spells.mSpells)),
         mSelectedSpell(std::move(spells.mSelectedSpell)), mUsedPowers(std::move(spells.mUsedPowers)),
         mSpellsChanged(std::move(spells.mSpellsChanged)), mEffects(std::move(spells.mEffects)),
-        mSourcedEffects(std::move(spells.mSourcedEffects))
+        mEffectsRevision(spells.mEffectsRevision), mSourcedEffects(std::move(spells.mSourcedEffects))
     {
         if (mSpellList)
             mSpellList->updateListener(&spells, this);
@@ -66,6 +68,7 @@ namespace MWMechanics
     {
         mEffects = MagicEffects();
         mSourcedEffects.clear();
+        mEffectsRevision = makeMagicEffectsRevision();
 
         for (const auto& iter : mSpells)
         {
@@ -173,6 +176,15 @@ namespace MWMechanics
         return mEffects;
     }
 
+    std::size_t Spells::getMagicEffectsRevision() const
+    {
+        if (mSpellsChanged) {
+            rebuildEffects();
+            mSpellsChanged = false;
+        }
+        return mEffectsRevision;
+    }
+
     void Spells::removeAllSpells()
     {
         mSpells.clear();
@@ -38,6 +38,7 @@ namespace MWMechanics
 
             mutable bool mSpellsChanged;
             mutable MagicEffects mEffects;
+            mutable std::size_t mEffectsRevision;
             mutable std::map<const ESM::Spell*, MagicEffects> mSourcedEffects;
             void rebuildEffects() const;
 
@@ -105,6 +106,9 @@ namespace MWMechanics
             MagicEffects getMagicEffects() const;
             ///< Return sum of magic effects resulting from abilities, blights, deseases and curses.
 
+            std::size_t getMagicEffectsRevision() const;
+            ///< Changes whenever the effects returned by getMagicEffects change.
+
             void clear(bool modifyBase = false);
             ///< Remove all spells of al types.
 
@@ -91,6 +91,9 @@ mwmp::BaseObject ObjectList::getBaseObjectFromPtr(const MWWorld::Ptr& ptr)
         baseObject.refId = ptr.getCellRef().getRefId();
         baseObject.refNum = ptr.getCellRef().getRefNum().mIndex;
         baseObject.mpNum = ptr.getCellRef().getMpNum();
+
+        if (ptr.getClass().hasContainerStore(ptr))
+            baseObject.containerRevision = ptr.getClass().getContainerStore(ptr).getMpRevision();
     }
 
     return baseObject;
@@ -203,6 +206,15 @@ void ObjectList::editContainers(MWWorld::CellStore* cellStore)
 
             MWWorld::ContainerStore& containerStore = ptrFound.getClass().getContainerStore(ptrFound);
 
+            // An ADD or REMOVE without items only tells us the revision our current contents correspond to
+            if (action != BaseObjectList::SET && baseObject.containerItems.empty())
+            {
+                if (baseObject.containerRevision != 0)
+                    containerStore.setMpRevision(baseObject.containerRevision);
+
+                continue;
+            }
+
             // If we are setting the entire contents, clear the current ones
             if (action == BaseObjectList::SET)
             {
@@ -216,6 +228,9 @@ void ObjectList::editContainers(MWWorld::CellStore* cellStore)
 
             MWWorld::Ptr ownerPtr = ptrFound.getClass().isActor() ? ptrFound : MWBase::Environment::get().getWorld()->getPlayerPtr();
 
+            MWWorld::ContainerStore::TItemIndex itemIndex;
+            bool hasItemIndex = false;
+
             for (const auto &containerItem : baseObject.containerItems)
             {
                 //LOG_APPEND(TimedLog::LOG_VERBOSE, "-- containerItem %s, count: %i, actionCount: %i",
@@ -248,10 +263,22 @@ void ObjectList::editContainers(MWWorld::CellStore* cellStore)
                 else if (action == BaseObjectList::REMOVE && containerItem.actionCount > 0)
                 {
                     // We have to find the right item ourselves because ContainerStore has no method
-                    // accounting for charge
-                    for (const auto itemPtr : containerStore)
+                    // accounting for charge, so look up its stacks through an index of the store
+                    // instead of walking the entire store for every item
+                    if (!hasItemIndex)
                     {
-                        if (Misc::StringUtils::ciEqual(itemPtr.getCellRef().getRefId(), containerItem.refId))
+                        itemIndex = containerStore.getItemIndex();
+                        hasItemIndex = true;
+                    }
+
+                    auto itemRange = itemIndex.equal_range(Misc::StringUtils::lowerCase(containerItem.refId));
+
+                    for (auto itemIterator = itemRange.first; itemIterator != itemRange.second; ++itemIterator)
+                    {
+                        const MWWorld::Ptr itemPtr = itemIterator->second;
+
+                        // Skip stacks that have already been emptied by earlier items in this packet
+                        if (itemPtr.getRefData().getCount() != 0)
                         {
                             if (itemPtr.getCellRef().getCharge() == containerItem.charge &&
                                 itemPtr.getCellRef().getEnchantmentCharge() == containerItem.enchantmentCharge &&
@@ -299,6 +326,11 @@ void ObjectList::editContainers(MWWorld::CellStore* cellStore)
                 }
             }
 
+            // Keep track of the revision these contents now correspond to, so our own changes to them
+            // can be sent against it
+            if (baseObject.containerRevision != 0)
+                containerStore.setMpRevision(baseObject.containerRevision);
+
             // Was this a SET or ADD action on an actor's container, and are we the authority
             // over the actor? If so, autoequip the actor
             if ((action == BaseObjectList::ADD || action == BaseObjectList::SET) && hasActorEquipment &&
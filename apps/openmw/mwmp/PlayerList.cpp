@@ -1,3 +1,4 @@
+#include <components/misc/stringops.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
 #include <apps/openmw/mwclass/creature.hpp>
 
@@ -115,6 +116,29 @@ std::vector<RakNet::RakNetGUID> PlayerList::getPlayersInCell(const ESM::Cell& ce
     return playersInCell;
 }
 
+void PlayerList::getCellsNearPlayers(std::set<std::pair<int, int>>& exteriorCells, std::set<std::string>& interiorCells)
+{
+    exteriorCells.clear();
+    interiorCells.clear();
+
+    for (auto& playerEntry : playerList)
+    {
+        if (playerEntry.first == RakNet::UNASSIGNED_CRABNET_GUID || playerEntry.second == nullptr)
+            continue;
+
+        const ESM::Cell& cell = playerEntry.second->cell;
+
+        if (cell.isExterior())
+        {
+            for (int x = cell.mData.mX - 1; x <= cell.mData.mX + 1; ++x)
+                for (int y = cell.mData.mY - 1; y <= cell.mData.mY + 1; ++y)
+                    exteriorCells.emplace(x, y);
+        }
+        else
+            interiorCells.insert(Misc::StringUtils::lowerCase(cell.mName));
+    }
+}
+
 bool PlayerList::isDedicatedPlayer(const MWWorld::Ptr &ptr)
 {
     if (ptr.mRef == nullptr)
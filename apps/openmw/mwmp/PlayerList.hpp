@@ -12,6 +12,9 @@
 #include "DedicatedPlayer.hpp"
 
 #include <map>
+#include <set>
+#include <string>
+#include <utility>
 #include <RakNetTypes.h>
 
 namespace MWMechanics
@@ -37,6 +40,10 @@ namespace mwmp
         static DedicatedPlayer* getPlayer(int actorId);
         static std::vector<RakNet::RakNetGUID> getPlayersInCell(const ESM::Cell& cell);
 
+        // Replaces the contents of the sets with the cells DedicatedPlayers are in, along with the exterior
+        // cells next to theirs, using lower case names for interiors
+        static void getCellsNearPlayers(std::set<std::pair<int, int>>& exteriorCells, std::set<std::string>& interiorCells);
+
         static bool isDedicatedPlayer(const MWWorld::Ptr &ptr);
 
         static void enableMarkers(const ESM::Cell& cell);
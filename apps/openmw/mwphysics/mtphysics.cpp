@@ -6,6 +6,7 @@
 #include "components/debug/debuglog.hpp"
 #include <components/misc/barrier.hpp>
 #include "components/misc/convert.hpp"
+#include "components/misc/hash.hpp"
 #include "components/settings/settings.hpp"
 #include "../mwmechanics/actorutil.hpp"
 #include "../mwmechanics/movement.hpp"
@@ -100,6 +101,11 @@ namespace
             stats.addToFallHeight(-actorData.mFallHeight);
     }
 
+    std::uint64_t hashLOSRequest(const MWPhysics::LOSRequest& request)
+    {
+        return Misc::hashFnv1a(request.mRawActors.data(), sizeof(request.mRawActors));
+    }
+
     osg::Vec3f interpolateMovements(MWPhysics::ActorFrameData& actorData, float timeAccum, float physicsDt)
     {
         const float interpolationFactor = std::clamp(timeAccum / physicsDt, 0.0f, 1.0f);
@@ -143,6 +149,9 @@ namespace MWPhysics
           , mQuit(false)
           , mNextJob(0)
           , mNextLOS(0)
+          , mLOSHits(0)
+          , mLOSMisses(0)
+          , mLOSRaycasts(0)
           , mFrameNumber(0)
           , mTimer(osg::Timer::instance())
           , mPrevStepCount(1)
@@ -408,24 +417,54 @@ namespace MWPhysics
 
     bool PhysicsTaskScheduler::getLineOfSight(const std::weak_ptr<Actor>& actor1, const std::weak_ptr<Actor>& actor2)
     {
-        std::unique_lock lock(mLOSCacheMutex);
-
         auto actorPtr1 = actor1.lock();
         auto actorPtr2 = actor2.lock();
         if (!actorPtr1 || !actorPtr2)
             return false;
 
         auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+        if (mLOSCacheExpiry >= 0)
         {
-            req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
-            if (mLOSCacheExpiry >= 0)
+            // Hits only need the shared lock, so concurrent queries and the refresh on the physics threads don't serialize
+            std::shared_lock lock(mLOSCacheMutex);
+            const std::uint32_t index = findLOSRequest(req);
+            if (index != Misc::HashIndex::sNotFound)
+            {
+                mLOSCache[index].mAge.store(0, std::memory_order_relaxed);
+                mLOSHits.fetch_add(1, std::memory_order_relaxed);
+                return mLOSCache[index].mResult.load(std::memory_order_relaxed);
+            }
+        }
+
+        mLOSMisses.fetch_add(1, std::memory_order_relaxed);
+        mLOSRaycasts.fetch_add(1, std::memory_order_relaxed);
+        req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+        if (mLOSCacheExpiry >= 0)
+        {
+            std::unique_lock lock(mLOSCacheMutex);
+            // Another query may have added the same pair while the ray was cast
+            if (findLOSRequest(req) == Misc::HashIndex::sNotFound)
+            {
+                const auto index = static_cast<std::uint32_t>(mLOSCache.size());
                 mLOSCache.push_back(req);
-            return req.mResult;
+                mLOSIndex.insert(hashLOSRequest(req), index, [] (std::uint32_t) { return false; });
+            }
         }
-        result->mAge = 0;
-        return result->mResult;
+        return req.mResult;
+    }
+
+    std::uint32_t PhysicsTaskScheduler::findLOSRequest(const LOSRequest& request) const
+    {
+        return mLOSIndex.find(hashLOSRequest(request),
+            [&] (std::uint32_t index) { return mLOSCache[index] == request; });
+    }
+
+    void PhysicsTaskScheduler::rebuildLOSIndex()
+    {
+        mLOSIndex.clear();
+        mLOSIndex.reserve(mLOSCache.size());
+        for (std::size_t i = 0; i < mLOSCache.size(); ++i)
+            mLOSIndex.insert(hashLOSRequest(mLOSCache[i]), static_cast<std::uint32_t>(i), [] (std::uint32_t) { return false; });
     }
 
     void PhysicsTaskScheduler::refreshLOSCache()
@@ -439,10 +478,13 @@ namespace MWPhysics
             auto actorPtr1 = req.mActors[0].lock();
             auto actorPtr2 = req.mActors[1].lock();
 
-            if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
+            if (req.mAge.fetch_add(1, std::memory_order_relaxed) > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
                 req.mStale = true;
             else
-                req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+            {
+                req.mResult.store(hasLineOfSight(actorPtr1.get(), actorPtr2.get()), std::memory_order_relaxed);
+                mLOSRaycasts.fetch_add(1, std::memory_order_relaxed);
+            }
         }
 
     }
@@ -591,6 +633,18 @@ namespace MWPhysics
         mFrameNumber = frameNumber;
     }
 
+    void PhysicsTaskScheduler::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        {
+            std::shared_lock lock(mLOSCacheMutex);
+            stats.setAttribute(frameNumber, "Physics LOS Cache", mLOSCache.size());
+        }
+        // Counted since the previous report, so the values are per frame
+        stats.setAttribute(frameNumber, "Physics LOS Hits", mLOSHits.exchange(0, std::memory_order_relaxed));
+        stats.setAttribute(frameNumber, "Physics LOS Misses", mLOSMisses.exchange(0, std::memory_order_relaxed));
+        stats.setAttribute(frameNumber, "Physics LOS Raycasts", mLOSRaycasts.exchange(0, std::memory_order_relaxed));
+    }
+
     void PhysicsTaskScheduler::debugDraw()
     {
         std::shared_lock lock(mCollisionWorldMutex);
@@ -626,10 +680,13 @@ namespace MWPhysics
         if (mLOSCacheExpiry >= 0)
         {
             std::unique_lock lock(mLOSCacheMutex);
-            mLOSCache.erase(
-                    std::remove_if(mLOSCache.begin(), mLOSCache.end(),
-                        [](const LOSRequest& req) { return req.mStale; }),
-                    mLOSCache.end());
+            const auto stale = std::remove_if(mLOSCache.begin(), mLOSCache.end(),
+                        [](const LOSRequest& req) { return req.mStale; });
+            if (stale != mLOSCache.end())
+            {
+                mLOSCache.erase(stale, mLOSCache.end());
+                rebuildLOSIndex();
+            }
         }
         mTimeEnd = mTimer->tick();
         std::unique_lock lock(mWorkersDoneMutex);
@@ -14,6 +14,7 @@
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
 #include "components/misc/budgetmeasurement.hpp"
+#include "components/misc/hashindex.hpp"
 
 namespace Misc
 {
@@ -55,6 +56,7 @@ namespace MWPhysics
             void updateSingleAabb(std::weak_ptr<PtrHolder> ptr, bool immediate=false);
             bool getLineOfSight(const std::weak_ptr<Actor>& actor1, const std::weak_ptr<Actor>& actor2);
             void debugDraw();
+            void reportStats(unsigned int frameNumber, osg::Stats& stats);
 
         private:
             void syncComputation();
@@ -62,6 +64,8 @@ namespace MWPhysics
             void updateActorsPositions();
             bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
             void refreshLOSCache();
+            std::uint32_t findLOSRequest(const LOSRequest& request) const;
+            void rebuildLOSIndex();
             void updateAabbs();
             void updatePtrAabb(const std::weak_ptr<PtrHolder>& ptr);
             void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
@@ -90,6 +94,7 @@ namespace MWPhysics
             btCollisionWorld* mCollisionWorld;
             MWRender::DebugDrawer* mDebugDrawer;
             std::vector<LOSRequest> mLOSCache;
+            Misc::HashIndex mLOSIndex; // into mLOSCache, by actor pair
             std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
             // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
@@ -108,6 +113,9 @@ namespace MWPhysics
             bool mQuit;
             std::atomic<int> mNextJob;
             std::atomic<int> mNextLOS;
+            std::atomic<unsigned int> mLOSHits;
+            std::atomic<unsigned int> mLOSMisses;
+            std::atomic<unsigned int> mLOSRaycasts;
             std::vector<std::thread> mThreads;
 
             std::size_t mWorkersFrameCounter = 0;
@@ -943,6 +943,7 @@ namespace MWPhysics
         stats.setAttribute(frameNumber, "Physics Actors", mActors.size());
         stats.setAttribute(frameNumber, "Physics Objects", mObjects.size());
         stats.setAttribute(frameNumber, "Physics HeightFields", mHeightFields.size());
+        mTaskScheduler->reportStats(frameNumber, stats);
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
@@ -1006,6 +1007,24 @@ namespace MWPhysics
         }
     }
 
+    LOSRequest::LOSRequest(const LOSRequest& other)
+        : mActors(other.mActors)
+        , mRawActors(other.mRawActors)
+        , mResult(other.mResult.load(std::memory_order_relaxed))
+        , mStale(other.mStale)
+        , mAge(other.mAge.load(std::memory_order_relaxed))
+    {}
+
+    LOSRequest& LOSRequest::operator=(const LOSRequest& other)
+    {
+        mActors = other.mActors;
+        mRawActors = other.mRawActors;
+        mResult.store(other.mResult.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        mStale = other.mStale;
+        mAge.store(other.mAge.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
     bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept
     {
         return lhs.mRawActors == rhs.mRawActors;
@@ -2,6 +2,7 @@
 #define OPENMW_MWPHYSICS_PHYSICSSYSTEM_H
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <map>
 #include <set>
@@ -68,11 +69,14 @@ namespace MWPhysics
     struct LOSRequest
     {
         LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2);
+        LOSRequest(const LOSRequest& other);
+        LOSRequest& operator=(const LOSRequest& other);
         std::array<std::weak_ptr<Actor>, 2> mActors;
         std::array<const Actor*, 2> mRawActors;
-        bool mResult;
+        // Read by lookups while the physics threads refresh the cache
+        std::atomic<bool> mResult;
         bool mStale;
-        int mAge;
+        std::atomic<int> mAge;
     };
     bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept;
 
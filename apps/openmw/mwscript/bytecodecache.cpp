@@ -0,0 +1,317 @@
+#include "bytecodecache.hpp"
+
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/debug/debuglog.hpp>
+
+#include <components/misc/hash.hpp>
+#include <components/misc/stringops.hpp>
+
+namespace
+{
+    const char sMagic[4] = { 'O', 'M', 'S', 'C' };
+    const std::uint32_t sFormatVersion = 2;
+    const char sLocalTypes[] = { 's', 'l', 'f' };
+
+    class Reader
+    {
+            const char* mCurrent;
+            const char* mEnd;
+
+        public:
+
+            Reader (const char* begin, const char* end) : mCurrent (begin), mEnd (end) {}
+
+            bool read (void* data, std::size_t size)
+            {
+                if (static_cast<std::size_t> (mEnd - mCurrent) < size)
+                    return false;
+
+                std::memcpy (data, mCurrent, size);
+                mCurrent += size;
+                return true;
+            }
+
+            template<typename T>
+            bool read (T& value)
+            {
+                return read (&value, sizeof (T));
+            }
+
+            bool read (std::string& value)
+            {
+                std::uint32_t size;
+                if (!read (size) || static_cast<std::size_t> (mEnd - mCurrent) < size)
+                    return false;
+
+                value.assign (mCurrent, size);
+                mCurrent += size;
+                return true;
+            }
+
+            bool skip (std::uint32_t size, const char*& begin)
+            {
+                if (static_cast<std::size_t> (mEnd - mCurrent) < size)
+                    return false;
+
+                begin = mCurrent;
+                mCurrent += size;
+                return true;
+            }
+
+            bool atEnd() const
+            {
+                return mCurrent == mEnd;
+            }
+    };
+
+    void write (std::string& buffer, const void* data, std::size_t size)
+    {
+        buffer.append (static_cast<const char*> (data), size);
+    }
+
+    template<typename T>
+    void write (std::string& buffer, const T& value)
+    {
+        write (buffer, &value, sizeof (T));
+    }
+
+    void write (std::string& buffer, const std::string& value)
+    {
+        write (buffer, static_cast<std::uint32_t> (value.size()));
+        buffer.append (value);
+    }
+
+    std::uint64_t hashSource (const std::string& source)
+    {
+        return Misc::hashFnv1a (source.data(), source.size());
+    }
+}
+
+namespace MWScript
+{
+    ByteCodeCache::ByteCodeCache (const boost::filesystem::path& path, std::uint64_t fingerprint)
+    : mPath (path), mFingerprint (fingerprint)
+    {
+        load();
+    }
+
+    void ByteCodeCache::load()
+    {
+        mMapped.clear();
+
+        try
+        {
+            if (!boost::filesystem::exists (mPath) || boost::filesystem::file_size (mPath) == 0)
+                return;
+
+            mFile.open (mPath.string());
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to open script cache " << mPath << ": " << e.what();
+            return;
+        }
+
+        Reader reader (mFile.data(), mFile.data() + mFile.size());
+
+        char magic[sizeof (sMagic)];
+        std::uint32_t version;
+        std::uint64_t fingerprint;
+        std::uint32_t count;
+
+        if (!reader.read (magic, sizeof (magic)) || std::memcmp (magic, sMagic, sizeof (sMagic)) != 0
+            || !reader.read (version) || version != sFormatVersion
+            || !reader.read (fingerprint) || !reader.read (count))
+        {
+            Log(Debug::Warning) << "Ignoring script cache " << mPath << " with unknown format";
+            mFile.close();
+            return;
+        }
+
+        if (fingerprint != mFingerprint)
+        {
+            Log(Debug::Info) << "Script cache " << mPath << " was written for other content files, ignoring it";
+            mFile.close();
+            return;
+        }
+
+        // Only the entry table is walked here, the bodies stay in the mapping until get() needs them
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            std::string name;
+            std::uint32_t size;
+            const char* body;
+
+            if (!reader.read (name) || !reader.read (size) || !reader.skip (size, body))
+            {
+                Log(Debug::Warning) << "Ignoring truncated script cache " << mPath;
+                mMapped.clear();
+                mFile.close();
+                return;
+            }
+
+            mMapped[name] = std::make_pair (body, body + size);
+        }
+    }
+
+    bool ByteCodeCache::read (const char* begin, const char* end, Entry& entry) const
+    {
+        Reader reader (begin, end);
+
+        std::uint32_t codeSize;
+        if (!reader.read (entry.mSourceHash) || !reader.read (codeSize))
+            return false;
+
+        if (static_cast<std::size_t> (end - begin) / sizeof (Interpreter::Type_Code) < codeSize)
+            return false;
+
+        entry.mByteCode.resize (codeSize);
+        if (codeSize > 0 && !reader.read (entry.mByteCode.data(), codeSize * sizeof (Interpreter::Type_Code)))
+            return false;
+
+        entry.mLocals.clear();
+        for (char type : sLocalTypes)
+        {
+            std::uint32_t count;
+            if (!reader.read (count))
+                return false;
+
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                std::string local;
+                if (!reader.read (local))
+                    return false;
+
+                entry.mLocals.declare (type, local);
+            }
+        }
+
+        return reader.atEnd();
+    }
+
+    bool ByteCodeCache::get (const std::string& name, const std::string& source,
+        std::vector<Interpreter::Type_Code>& code, Compiler::Locals& locals) const
+    {
+        const std::string key = Misc::StringUtils::lowerCase (name);
+        const std::uint64_t sourceHash = hashSource (source);
+
+        auto added = mAdded.find (key);
+        if (added != mAdded.end())
+        {
+            if (added->second.mSourceHash != sourceHash)
+                return false;
+
+            code = added->second.mByteCode;
+            locals = added->second.mLocals;
+            return true;
+        }
+
+        auto mapped = mMapped.find (key);
+        if (mapped == mMapped.end())
+            return false;
+
+        Entry entry;
+        if (!read (mapped->second.first, mapped->second.second, entry) || entry.mSourceHash != sourceHash)
+            return false;
+
+        code = std::move (entry.mByteCode);
+        locals = entry.mLocals;
+        return true;
+    }
+
+    void ByteCodeCache::put (const std::string& name, const std::string& source,
+        const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals)
+    {
+        Entry& entry = mAdded[Misc::StringUtils::lowerCase (name)];
+        entry.mSourceHash = hashSource (source);
+        entry.mByteCode = code;
+        entry.mLocals = locals;
+    }
+
+    void ByteCodeCache::save()
+    {
+        if (mAdded.empty())
+            return;
+
+        std::string buffer;
+        std::uint32_t count = 0;
+
+        write (buffer, sMagic, sizeof (sMagic));
+        write (buffer, sFormatVersion);
+        write (buffer, mFingerprint);
+        write (buffer, count); // patched below
+
+        for (const auto& mapped : mMapped)
+        {
+            if (mAdded.count (mapped.first))
+                continue;
+
+            write (buffer, mapped.first);
+            write (buffer, static_cast<std::uint32_t> (mapped.second.second - mapped.second.first));
+            write (buffer, mapped.second.first, mapped.second.second - mapped.second.first);
+            ++count;
+        }
+
+        std::string body;
+        for (const auto& added : mAdded)
+        {
+            body.clear();
+            write (body, added.second.mSourceHash);
+            write (body, static_cast<std::uint32_t> (added.second.mByteCode.size()));
+            write (body, added.second.mByteCode.data(), added.second.mByteCode.size() * sizeof (Interpreter::Type_Code));
+
+            for (char type : sLocalTypes)
+            {
+                const std::vector<std::string>& names = added.second.mLocals.get (type);
+                write (body, static_cast<std::uint32_t> (names.size()));
+                for (const std::string& local : names)
+                    write (body, local);
+            }
+
+            write (buffer, added.first);
+            write (buffer, body);
+            ++count;
+        }
+
+        std::memcpy (&buffer[sizeof (sMagic) + sizeof (sFormatVersion) + sizeof (mFingerprint)], &count, sizeof (count));
+
+        // Write next to the old file and swap it in, so a crash never leaves a half-written cache behind
+        boost::filesystem::path temp = mPath;
+        temp += ".tmp";
+
+        try
+        {
+            boost::filesystem::create_directories (mPath.parent_path());
+
+            {
+                boost::filesystem::ofstream stream (temp, std::ios::binary | std::ios::trunc);
+                stream.write (buffer.data(), buffer.size());
+                if (!stream)
+                    throw std::runtime_error ("write failed");
+            }
+
+            mMapped.clear();
+            mFile.close();
+
+            boost::filesystem::rename (temp, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save script cache " << mPath << ": " << e.what();
+
+            // The old file is still in place if the rename failed
+            if (!mFile.is_open())
+                load();
+            return;
+        }
+
+        mAdded.clear();
+        load();
+    }
+}
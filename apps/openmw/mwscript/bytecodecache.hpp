@@ -0,0 +1,61 @@
+#ifndef GAME_SCRIPT_BYTECODECACHE_H
+#define GAME_SCRIPT_BYTECODECACHE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <components/compiler/locals.hpp>
+
+#include <components/interpreter/types.hpp>
+
+namespace MWScript
+{
+    /// \brief Compiled scripts kept on disk between runs
+    ///
+    /// The cache file is memory mapped when it is loaded and an entry is only decoded when a script
+    /// asks for it. Entries are keyed by script id and are only returned when the script text hashes
+    /// the same as the one they were compiled from. The whole file is ignored when it was written
+    /// for a different fingerprint, which covers the compiler extensions and the content files
+    /// that script compilation looks up globals and members in.
+    class ByteCodeCache
+    {
+            struct Entry
+            {
+                std::uint64_t mSourceHash;
+                std::vector<Interpreter::Type_Code> mByteCode;
+                Compiler::Locals mLocals;
+            };
+
+            boost::filesystem::path mPath;
+            std::uint64_t mFingerprint;
+            boost::iostreams::mapped_file_source mFile;
+            std::map<std::string, std::pair<const char*, const char*> > mMapped; // entry bodies in mFile
+            std::map<std::string, Entry> mAdded;
+
+            void load();
+
+            bool read (const char* begin, const char* end, Entry& entry) const;
+
+        public:
+
+            ByteCodeCache (const boost::filesystem::path& path, std::uint64_t fingerprint);
+
+            bool get (const std::string& name, const std::string& source,
+                std::vector<Interpreter::Type_Code>& code, Compiler::Locals& locals) const;
+            ///< Return the cached code and locals for script \a name, if they were compiled from \a source.
+
+            void put (const std::string& name, const std::string& source,
+                const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals);
+            ///< Add a freshly compiled script. Nothing is written until save() is called.
+
+            void save();
+            ///< Write the cache file if any scripts were added since it was loaded.
+    };
+}
+
+#endif
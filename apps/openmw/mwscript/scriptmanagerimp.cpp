@@ -18,6 +18,7 @@
 
 #include "../mwworld/esmstore.hpp"
 
+#include "bytecodecache.hpp"
 #include "extensions.hpp"
 #include "interpretercontext.hpp"
 
@@ -28,7 +29,7 @@ namespace MWScript
         const std::vector<std::string>& scriptBlacklist)
     : mErrorHandler(), mStore (store),
       mCompilerContext (compilerContext), mParser (mErrorHandler, mCompilerContext),
-      mOpcodesInstalled (false), mGlobalScripts (store)
+      mOpcodesInstalled (false), mGlobalScripts (store), mCompiling (false), mUsesOtherLocals (false)
     {
         mErrorHandler.setWarningsMode (warningsMode);
 
@@ -39,6 +40,17 @@ namespace MWScript
         std::sort (mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
+    ScriptManager::~ScriptManager()
+    {
+        if (mByteCodeCache)
+            mByteCodeCache->save();
+    }
+
+    void ScriptManager::setByteCodeCache (std::unique_ptr<ByteCodeCache> cache)
+    {
+        mByteCodeCache = std::move (cache);
+    }
+
     bool ScriptManager::compile (const std::string& name)
     {
         mParser.reset();
@@ -46,9 +58,23 @@ namespace MWScript
 
         if (const ESM::Script *script = mStore.get<ESM::Script>().find (name))
         {
+            if (mByteCodeCache)
+            {
+                std::vector<Interpreter::Type_Code> code;
+                Compiler::Locals locals;
+
+                if (mByteCodeCache->get (name, script->mScriptText, code, locals))
+                {
+                    mScripts.emplace(name, CompiledScript(code, locals));
+                    return true;
+                }
+            }
+
             mErrorHandler.setContext(name);
 
             bool Success = true;
+            mCompiling = true;
+            mUsesOtherLocals = false;
             try
             {
                 std::istringstream input (script->mScriptText);
@@ -70,6 +96,7 @@ namespace MWScript
                 Log(Debug::Error) << "Error: An exception has been thrown: " << error.what();
                 Success = false;
             }
+            mCompiling = false;
 
             if (!Success)
             {
@@ -82,6 +109,11 @@ namespace MWScript
                 mParser.getCode(code);
                 mScripts.emplace(name, CompiledScript(code, mParser.getLocals()));
 
+                // Code accessing the locals of other scripts was compiled against their layout at
+                // this point, which can change without this script's text changing
+                if (mByteCodeCache && !mUsesOtherLocals)
+                    mByteCodeCache->put (name, script->mScriptText, code, mParser.getLocals());
+
                 return true;
             }
         }
@@ -118,7 +150,12 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
+                if (iter->second.mDecoded.empty())
+                    mInterpreter.decode (&iter->second.mByteCode[0], iter->second.mByteCode.size(),
+                        iter->second.mDecoded);
+
+                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(),
+                    iter->second.mDecoded, interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -161,6 +198,9 @@ namespace MWScript
             }
         }
 
+        if (mByteCodeCache)
+            mByteCodeCache->save();
+
         return std::make_pair (count, success);
     }
 
@@ -168,6 +208,10 @@ namespace MWScript
     {
         std::string name2 = Misc::StringUtils::lowerCase (name);
 
+        // The compiler only asks for the locals of other scripts to resolve member accesses
+        if (mCompiling)
+            mUsesOtherLocals = true;
+
         {
             ScriptCollection::iterator iter = mScripts.find (name2);
 
@@ -2,6 +2,7 @@
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include <components/compiler/streamerrorhandler.hpp>
@@ -32,6 +33,8 @@ namespace Interpreter
 
 namespace MWScript
 {
+    class ByteCodeCache;
+
     class ScriptManager : public MWBase::ScriptManager
     {
             Compiler::StreamErrorHandler mErrorHandler;
@@ -44,6 +47,7 @@ namespace MWScript
             struct CompiledScript
             {
                 std::vector<Interpreter::Type_Code> mByteCode;
+                std::vector<Interpreter::DecodedInstruction> mDecoded; // Filled on the first run
                 Compiler::Locals mLocals;
                 bool mActive;
 
@@ -61,6 +65,9 @@ namespace MWScript
             GlobalScripts mGlobalScripts;
             std::map<std::string, Compiler::Locals> mOtherLocals;
             std::vector<std::string> mScriptBlacklist;
+            std::unique_ptr<ByteCodeCache> mByteCodeCache;
+            bool mCompiling;
+            bool mUsesOtherLocals; // The script being compiled looked up the locals of a script
 
         public:
 
@@ -68,6 +75,15 @@ namespace MWScript
                 Compiler::Context& compilerContext, int warningsMode,
                 const std::vector<std::string>& scriptBlacklist);
 
+            ~ScriptManager();
+
+            void setByteCodeCache (std::unique_ptr<ByteCodeCache> cache);
+            ///< Reuse scripts compiled in earlier runs. Scripts compiled from now on are added to
+            /// \a cache, which is saved after compileAll() and when the manager is destroyed.
+            ///
+            /// Scripts that access the locals of other scripts are never cached, because those
+            /// locals can change without the script itself changing.
+
             void clear() override;
 
             bool run (const std::string& name, Interpreter::Context& interpreterContext) override;
@@ -1,5 +1,6 @@
 #include "cellpreloader.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <limits>
 
@@ -70,6 +71,11 @@ namespace MWWorld
             mAbort = true;
         }
 
+        const std::vector<std::string>& getMeshes() const
+        {
+            return mMeshes;
+        }
+
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
@@ -152,6 +158,26 @@ namespace MWWorld
         std::set<osg::ref_ptr<const osg::Object> > mPreloadedObjects;
     };
 
+    /// Worker thread item: decompress a batch of a cell's meshes while its PreloadItem works through the others.
+    class PrefetchItem : public SceneUtil::WorkItem
+    {
+    public:
+        PrefetchItem(const VFS::Manager* vfs, std::vector<std::string>&& names)
+            : mVFS(vfs)
+            , mNames(std::move(names))
+        {
+        }
+
+        void doWork() override
+        {
+            mVFS->prefetch(mNames);
+        }
+
+    private:
+        const VFS::Manager* mVFS;
+        std::vector<std::string> mNames;
+    };
+
     class TerrainPreloadItem : public SceneUtil::WorkItem
     {
     public:
@@ -249,7 +275,7 @@ namespace MWWorld
         }
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();++it)
-            it->second.mWorkItem->abort();
+            it->second.mWorkItem->cancel();
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();++it)
             it->second.mWorkItem->waitTillDone();
@@ -295,7 +321,7 @@ namespace MWWorld
 
             if (oldestTimestamp + threshold < timestamp)
             {
-                oldestCell->second.mWorkItem->abort();
+                oldestCell->second.mWorkItem->cancel();
                 mPreloadCells.erase(oldestCell);
             }
             else
@@ -303,6 +329,18 @@ namespace MWWorld
         }
 
         osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+
+        // Let other worker threads inflate meshes from compressed archives in batches while the preload
+        // works through them. The batches go ahead of the preload at the same priority, so they are
+        // picked up before it or alongside it rather than after it.
+        const std::vector<std::string>& meshes = item->getMeshes();
+        const std::size_t batchSize = 16;
+        for (std::size_t i = 0; i < meshes.size(); i += batchSize)
+        {
+            std::vector<std::string> batch (meshes.begin() + i, meshes.begin() + std::min(i + batchSize, meshes.size()));
+            mWorkQueue->addWorkItem(new PrefetchItem(mResourceSystem->getVFS(), std::move(batch)));
+        }
+
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
@@ -316,7 +354,7 @@ namespace MWWorld
             // do the deletion in the background thread
             if (found->second.mWorkItem)
             {
-                found->second.mWorkItem->abort();
+                found->second.mWorkItem->cancel();
                 mUnrefQueue->push(mPreloadCells[cell].mWorkItem);
             }
 
@@ -330,7 +368,7 @@ namespace MWWorld
         {
             if (it->second.mWorkItem)
             {
-                it->second.mWorkItem->abort();
+                it->second.mWorkItem->cancel();
                 mUnrefQueue->push(it->second.mWorkItem);
             }
 
@@ -346,7 +384,7 @@ namespace MWWorld
             {
                 if (it->second.mWorkItem)
                 {
-                    it->second.mWorkItem->abort();
+                    it->second.mWorkItem->cancel();
                     mUnrefQueue->push(it->second.mWorkItem);
                 }
                 mPreloadCells.erase(it++);
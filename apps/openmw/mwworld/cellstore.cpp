@@ -767,38 +767,51 @@ namespace MWWorld
         if (mCell->mContextList.empty())
             return; // this is a dynamically generated cell -> skipping.
 
-        // Load references from all plugins that do something with this cell.
-        for (size_t i = 0; i < mCell->mContextList.size(); i++)
+        if (const std::vector<ESMStore::CellRefEntry>* refs = mStore.getCellRefs(*mCell))
         {
-            try
+            // Already read while loading the content files, moved references are left out
+            mIds.reserve(refs->size() + mCell->mLeasedRefs.size());
+            for (const ESMStore::CellRefEntry& ref : *refs)
             {
-                // Reopen the ESM reader and seek to the right position.
-                int index = mCell->mContextList[i].index;
-                mCell->restore (esm[index], i);
-
-                ESM::CellRef ref;
-
-                // Get each reference in turn
-                bool deleted = false;
-                while (mCell->getNextRef (esm[index], ref, deleted))
+                if (!ref.mDeleted)
+                    mIds.push_back(mStore.getCellRefId(ref.mRefId));
+            }
+        }
+        else
+        {
+            // Load references from all plugins that do something with this cell.
+            for (size_t i = 0; i < mCell->mContextList.size(); i++)
+            {
+                try
                 {
-                    if (deleted)
-                        continue;
+                    // Reopen the ESM reader and seek to the right position.
+                    int index = mCell->mContextList[i].index;
+                    mCell->restore (esm[index], i);
 
-                    // Don't list reference if it was moved to a different cell.
-                    ESM::MovedCellRefTracker::const_iterator iter =
-                        std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
-                    if (iter != mCell->mMovedRefs.end()) {
-                        continue;
-                    }
+                    ESM::CellRef ref;
 
-                    Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
-                    mIds.push_back(std::move(ref.mRefID));
+                    // Get each reference in turn
+                    bool deleted = false;
+                    while (mCell->getNextRef (esm[index], ref, deleted))
+                    {
+                        if (deleted)
+                            continue;
+
+                        // Don't list reference if it was moved to a different cell.
+                        ESM::MovedCellRefTracker::const_iterator iter =
+                            std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
+                        if (iter != mCell->mMovedRefs.end()) {
+                            continue;
+                        }
+
+                        Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
+                        mIds.push_back(std::move(ref.mRefID));
+                    }
+                }
+                catch (std::exception& e)
+                {
+                    Log(Debug::Error) << "An error occurred listing references for cell " << getCell()->getDescription() << ": " << e.what();
                 }
-            }
-            catch (std::exception& e)
-            {
-                Log(Debug::Error) << "An error occurred listing references for cell " << getCell()->getDescription() << ": " << e.what();
             }
         }
 
@@ -159,7 +159,17 @@ MWWorld::ContainerStore::ContainerStore()
     , mModified(false)
     , mResolved(false)
     , mSeed()
-    , mPtr() {}
+    , mPtr()
+    /*
+        Start of tes3mp addition
+
+        Initialize the revision of the container's contents
+    */
+    , mMpRevision(0)
+    /*
+        End of tes3mp addition
+    */
+    {}
 
 MWWorld::ContainerStore::~ContainerStore() {}
 
@@ -719,6 +729,44 @@ void MWWorld::ContainerStore::setResolved(bool state)
     End of tes3mp addition
 */
 
+/*
+    Start of tes3mp addition
+
+    Make it possible to get and set the revision of the container's contents, so that
+    container changes can be sent to the server against the revision they were based on
+*/
+unsigned int MWWorld::ContainerStore::getMpRevision() const
+{
+    return mMpRevision;
+}
+
+void MWWorld::ContainerStore::setMpRevision(unsigned int revision)
+{
+    mMpRevision = revision;
+}
+/*
+    End of tes3mp addition
+*/
+
+/*
+    Start of tes3mp addition
+
+    Make it possible to look up every stack of an item by its lowercase refId, so that
+    container packets don't need to walk the entire store for each item they affect
+*/
+MWWorld::ContainerStore::TItemIndex MWWorld::ContainerStore::getItemIndex()
+{
+    TItemIndex index;
+
+    for (const auto itemPtr : *this)
+        index.emplace(Misc::StringUtils::lowerCase(itemPtr.getCellRef().getRefId()), itemPtr);
+
+    return index;
+}
+/*
+    End of tes3mp addition
+*/
+
 void MWWorld::ContainerStore::resolve()
 {
     if(!mResolved && !mPtr.isEmpty())
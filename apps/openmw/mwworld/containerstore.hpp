@@ -6,6 +6,16 @@
 #include <memory>
 #include <utility>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <unordered_map>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/esm/loadalch.hpp>
 #include <components/esm/loadappa.hpp>
 #include <components/esm/loadarmo.hpp>
@@ -125,6 +135,16 @@ namespace MWWorld
             MWWorld::Ptr mPtr;
             std::weak_ptr<ResolutionListener> mResolutionListener;
 
+            /*
+                Start of tes3mp addition
+
+                Track the revision of this container's contents last received from the server
+            */
+            unsigned int mMpRevision;
+            /*
+                End of tes3mp addition
+            */
+
             ContainerStoreIterator addImp (const Ptr& ptr, int count, bool markModified = true);
             void addInitialItem (const std::string& id, const std::string& owner, int count, Misc::Rng::Seed* seed, bool topLevel=true);
             void addInitialItemImp (const MWWorld::Ptr& ptr, const std::string& owner, int count, Misc::Rng::Seed* seed, bool topLevel=true);
@@ -259,6 +279,30 @@ namespace MWWorld
                 End of tes3mp addition
             */
 
+            /*
+                Start of tes3mp addition
+
+                Make it possible to get and set the revision of the container's contents, so that
+                container changes can be sent to the server against the revision they were based on
+            */
+            unsigned int getMpRevision() const;
+            void setMpRevision(unsigned int revision);
+            /*
+                End of tes3mp addition
+            */
+
+            /*
+                Start of tes3mp addition
+
+                Make it possible to look up every stack of an item by its lowercase refId, so that
+                container packets don't need to walk the entire store for each item they affect
+            */
+            typedef std::unordered_multimap<std::string, Ptr> TItemIndex;
+            TItemIndex getItemIndex();
+            /*
+                End of tes3mp addition
+            */
+
             void resolve();
             ResolutionHandle resolveTemporarily();
             void unresolve();
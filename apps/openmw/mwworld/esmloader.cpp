@@ -1,7 +1,23 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <components/esm/esmreader.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+namespace
+{
+    double toMilliseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
 
 namespace MWWorld
 {
@@ -17,15 +33,164 @@ EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& read
 
 void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
 {
-  ContentLoader::load(filepath.filename(), index);
-
-  ESM::ESMReader lEsm;
-  lEsm.setEncoder(mEncoder);
-  lEsm.setIndex(index);
-  lEsm.setGlobalReaderList(&mEsm);
-  lEsm.open(filepath.string());
-  mEsm[index] = lEsm;
-  mStore.load(mEsm[index], &mListener);
+  File file;
+  file.mPath = filepath;
+  file.mIndex = index;
+  mFiles.push_back(std::move(file));
+}
+
+void EsmLoader::parse(File& file, ToUTF8::Utf8Encoder* encoder)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  try
+  {
+    // Every file has its own slot in mEsm, so the readers can be opened from several threads
+    ESM::ESMReader& esm = mEsm[file.mIndex];
+    esm.setEncoder(encoder);
+    esm.setIndex(file.mIndex);
+    esm.setGlobalReaderList(&mEsm);
+    esm.open(file.mPath.string());
+    mStore.parse(esm, file.mParsed);
+  }
+  catch (...)
+  {
+    file.mError = std::current_exception();
+  }
+
+  file.mParseTime = std::chrono::steady_clock::now() - start;
+}
+
+void EsmLoader::finish()
+{
+  if (mFiles.empty())
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // Worker threads parse the files while this thread merges them in load order, so later files
+  // override earlier ones exactly like before. Parsing may only run ahead of merging by one file
+  // per thread, which bounds how many parsed files are held at once. The encoder keeps a
+  // conversion buffer, so every thread works with its own copy.
+  const size_t threadCount = std::min<size_t>(mFiles.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t next = 0;
+  size_t merged = 0;
+  bool stopping = false;
+  std::vector<bool> parsed(mFiles.size(), false);
+
+  auto parseFiles = [&]
+  {
+    std::unique_ptr<ToUTF8::Utf8Encoder> encoder;
+    if (mEncoder)
+      encoder = std::make_unique<ToUTF8::Utf8Encoder>(*mEncoder);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+      // The file being merged does not count against the threads' lead
+      condition.wait(lock, [&] { return stopping || next >= mFiles.size() || next <= merged + threadCount; });
+      if (stopping || next >= mFiles.size())
+        return;
+
+      const size_t i = next++;
+      lock.unlock();
+      parse(mFiles[i], encoder.get());
+      lock.lock();
+
+      parsed[i] = true;
+      condition.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadCount; ++i)
+    threads.emplace_back(parseFiles);
+
+  auto stopThreads = [&]
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    condition.notify_all();
+    for (std::thread& thread : threads)
+      thread.join();
+  };
+
+  std::map<int, ESMStore::ParsedFile::TypeStats> totals;
+  std::chrono::steady_clock::duration mergeTime {};
+
+  try
+  {
+    for (size_t i = 0; i < mFiles.size(); ++i)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return parsed[i]; });
+      }
+
+      File& file = mFiles[i];
+      int index = file.mIndex;
+      ContentLoader::load(file.mPath.filename(), index);
+
+      if (file.mError)
+        std::rethrow_exception(file.mError);
+
+      ESM::ESMReader& esm = mEsm[file.mIndex];
+      esm.setEncoder(mEncoder);
+
+      const auto mergeStart = std::chrono::steady_clock::now();
+      const size_t records = file.mParsed.mRecords.size();
+      mStore.merge(esm, file.mParsed, &mListener);
+      const auto mergeEnd = std::chrono::steady_clock::now();
+      mergeTime += mergeEnd - mergeStart;
+
+      Log(Debug::Verbose) << "Content file " << file.mPath.filename() << ": " << records << " records, parsed in "
+          << toMilliseconds(file.mParseTime) << " ms, merged in " << toMilliseconds(mergeEnd - mergeStart) << " ms";
+
+      for (const auto& [type, stats] : file.mParsed.mStats)
+      {
+        ESMStore::ParsedFile::TypeStats& total = totals[type];
+        total.mCount += stats.mCount;
+        total.mParseTime += stats.mParseTime;
+        total.mMergeTime += stats.mMergeTime;
+      }
+
+      // Free the parsed records right away instead of holding every file's until the end
+      file.mParsed = ESMStore::ParsedFile();
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++merged;
+      }
+      condition.notify_all();
+    }
+  }
+  catch (...)
+  {
+    stopThreads();
+    mFiles.clear();
+    throw;
+  }
+
+  stopThreads();
+
+  for (const auto& [type, stats] : totals)
+  {
+    ESM::NAME name;
+    name.intval = type;
+    Log(Debug::Verbose) << "Record type " << name.toString() << ": " << stats.mCount << " records, parsed in "
+        << toMilliseconds(stats.mParseTime) << " ms, merged in " << toMilliseconds(stats.mMergeTime) << " ms";
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  Log(Debug::Info) << "Loaded " << mFiles.size() << " content files in " << toMilliseconds(end - start)
+      << " ms (parsing on " << threadCount << " threads, merging " << toMilliseconds(mergeTime) << " ms)";
+
+  mFiles.clear();
 }
 
 } /* namespace MWWorld */
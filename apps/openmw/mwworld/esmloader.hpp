@@ -1,9 +1,11 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <exception>
 #include <vector>
 
 #include "contentloader.hpp"
+#include "esmstore.hpp"
 
 namespace ToUTF8
 {
@@ -18,19 +20,34 @@ namespace ESM
 namespace MWWorld
 {
 
-class ESMStore;
-
 struct EsmLoader : public ContentLoader
 {
     EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
       ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener);
 
+    /// Queue a content file. Nothing is read until finish() is called.
     void load(const boost::filesystem::path& filepath, int& index) override;
 
+    /// Parse the queued files on worker threads and merge each into the store, in load order, as
+    /// soon as it and all files before it are parsed.
+    void finish();
+
     private:
+      struct File
+      {
+          boost::filesystem::path mPath;
+          int mIndex;
+          ESMStore::ParsedFile mParsed;
+          std::chrono::steady_clock::duration mParseTime {};
+          std::exception_ptr mError;
+      };
+
+      void parse(File& file, ToUTF8::Utf8Encoder* encoder);
+
       std::vector<ESM::ESMReader>& mEsm;
       MWWorld::ESMStore& mStore;
       ToUTF8::Utf8Encoder* mEncoder;
+      std::vector<File> mFiles;
 };
 
 } /* namespace MWWorld */
@@ -1,6 +1,7 @@
 #include "esmstore.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <set>
 
 #include <boost/filesystem/operations.hpp>
@@ -25,8 +26,27 @@ namespace
 
     constexpr std::size_t deletedRefID = std::numeric_limits<std::size_t>::max();
 
-    void readRefs(const ESM::Cell& cell, std::vector<Ref>& refs, std::vector<std::string>& refIDs, std::vector<ESM::ESMReader>& readers)
+    struct CellRefIndex
     {
+        std::unordered_map<const ESM::Cell*, std::vector<MWWorld::ESMStore::CellRefEntry>>& mCells;
+        std::vector<std::string>& mIds;
+        std::unordered_map<std::string, uint32_t> mIdIndices;
+
+        uint32_t getIdIndex(const std::string& id)
+        {
+            std::string lowerCase = Misc::StringUtils::lowerCase(id);
+            const auto [it, inserted] = mIdIndices.emplace(std::move(lowerCase), static_cast<uint32_t>(mIds.size()));
+            if (inserted)
+                mIds.push_back(it->first);
+            return it->second;
+        }
+    };
+
+    void readRefs(const ESM::Cell& cell, std::vector<Ref>& refs, std::vector<std::string>& refIDs, std::vector<ESM::ESMReader>& readers,
+        CellRefIndex& cellRefIndex)
+    {
+        std::vector<MWWorld::ESMStore::CellRefEntry>& cellRefs = cellRefIndex.mCells[&cell];
+
         for (size_t i = 0; i < cell.mContextList.size(); i++)
         {
             size_t index = cell.mContextList[i].index;
@@ -38,9 +58,15 @@ namespace
             bool deleted = false;
             while(cell.getNextRef(readers[index], ref, deleted))
             {
+                const bool moved = std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum) != cell.mMovedRefs.end();
+
+                // Same filtering as CellStore::loadRefs
+                if (!moved)
+                    cellRefs.push_back({cellRefIndex.getIdIndex(ref.mRefID), deleted});
+
                 if(deleted)
                     refs.emplace_back(ref.mRefNum, deletedRefID);
-                else if (std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum) == cell.mMovedRefs.end())
+                else if (!moved)
                 {
                     refs.emplace_back(ref.mRefNum, refIDs.size());
                     refIDs.push_back(std::move(ref.mRefID));
@@ -128,7 +154,47 @@ static bool isCacheableRecord(int id)
     return false;
 }
 
-void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
+void ESMStore::parse(ESM::ESMReader &esm, ParsedFile &file) const
+{
+    while(esm.hasMoreRecs())
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t offset = esm.getFileOffset();
+
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+
+        std::unique_ptr<ParsedRecord> record;
+
+        std::map<int, StoreBase *>::const_iterator it = mStores.find(n.intval);
+        if (it != mStores.end())
+            record = it->second->parse(esm);
+        else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+        {
+            // ignore project file only records
+            esm.skipRecord();
+            continue;
+        }
+        else if (n.intval != ESM::REC_INFO && n.intval != ESM::REC_MGEF && n.intval != ESM::REC_SKIL)
+        {
+            std::stringstream error;
+            error << "Unknown record: " << n.toString();
+            throw std::runtime_error(error.str());
+        }
+
+        // Anything that could not be parsed on its own is read again by merge()
+        if (!record)
+            esm.skipRecord();
+
+        file.mRecords.push_back({n.intval, offset, std::move(record)});
+
+        ParsedFile::TypeStats& stats = file.mStats[n.intval];
+        ++stats.mCount;
+        stats.mParseTime += std::chrono::steady_clock::now() - start;
+    }
+}
+
+void ESMStore::merge(ESM::ESMReader &esm, ParsedFile &file, Loading::Listener* listener)
 {
     listener->setProgressRange(1000);
 
@@ -168,59 +234,92 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         esm.addParentFileIndex(index);
     }
 
-    // Loop through all records
-    while(esm.hasMoreRecs())
+    // Loop through all records, in the order they appear in the file
+    for (ParsedFile::Record& record : file.mRecords)
     {
-        ESM::NAME n = esm.getRecName();
-        esm.getRecHeader();
+        const auto start = std::chrono::steady_clock::now();
+        ParsedFile::TypeStats& stats = file.mStats[record.mType];
 
-        // Look up the record type.
-        std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+        if (record.mRecord)
+        {
+            RecordId id = mStores[record.mType]->loadParsed(*record.mRecord);
+            record.mRecord.reset();
 
-        if (it == mStores.end()) {
-            if (n.intval == ESM::REC_INFO) {
-                if (dialogue)
-                {
-                    dialogue->readInfo(esm, esm.getIndex() != 0);
-                }
-                else
-                {
-                    Log(Debug::Error) << "Error: info record without dialog";
-                    esm.skipRecord();
-                }
-            } else if (n.intval == ESM::REC_MGEF) {
-                mMagicEffects.load (esm);
-            } else if (n.intval == ESM::REC_SKIL) {
-                mSkills.load (esm);
-            }
-            else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+            if (id.mIsDeleted)
+                mStores[record.mType]->eraseStatic(id.mId);
+            else
+                dialogue = nullptr;
+        }
+        else
+        {
+            loadRecord(esm, record.mOffset, dialogue);
+        }
+
+        stats.mMergeTime += std::chrono::steady_clock::now() - start;
+        listener->setProgress(static_cast<size_t>(record.mOffset / (float)esm.getFileSize() * 1000));
+    }
+
+    file.mRecords.clear();
+}
+
+void ESMStore::loadRecord(ESM::ESMReader &esm, size_t offset, ESM::Dialogue *&dialogue)
+{
+    if (esm.getFileOffset() != offset)
+    {
+        // Only the position changes, the parent file indices added by merge() have to stay
+        ESM::ESM_Context context = esm.getContext();
+        context.filePos = offset;
+        context.leftFile = esm.getFileSize() - offset;
+        context.leftRec = 0;
+        context.subCached = false;
+        esm.restoreContext(context);
+    }
+
+    ESM::NAME n = esm.getRecName();
+    esm.getRecHeader();
+
+    // Look up the record type.
+    std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+
+    if (it == mStores.end()) {
+        if (n.intval == ESM::REC_INFO) {
+            if (dialogue)
             {
-                // ignore project file only records
-                esm.skipRecord();
+                dialogue->readInfo(esm, esm.getIndex() != 0);
             }
-            else {
-                std::stringstream error;
-                error << "Unknown record: " << n.toString();
-                throw std::runtime_error(error.str());
-            }
-        } else {
-            RecordId id = it->second->load(esm);
-            if (id.mIsDeleted)
+            else
             {
-                it->second->eraseStatic(id.mId);
-                continue;
+                Log(Debug::Error) << "Error: info record without dialog";
+                esm.skipRecord();
             }
+        } else if (n.intval == ESM::REC_MGEF) {
+            mMagicEffects.load (esm);
+        } else if (n.intval == ESM::REC_SKIL) {
+            mSkills.load (esm);
+        }
+    } else {
+        RecordId id = it->second->load(esm);
+        if (id.mIsDeleted)
+        {
+            it->second->eraseStatic(id.mId);
+            return;
+        }
 
-            if (n.intval==ESM::REC_DIAL) {
-                dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
-            } else {
-                dialogue = nullptr;
-            }
+        if (n.intval==ESM::REC_DIAL) {
+            dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
+        } else {
+            dialogue = nullptr;
         }
-        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
     }
 }
 
+void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
+{
+    ParsedFile file;
+    parse(esm, file);
+    merge(esm, file, listener);
+}
+
 void ESMStore::setUp(bool validateRecords)
 {
     mIds.clear();
@@ -261,10 +360,16 @@ void ESMStore::countRecords()
     std::vector<Ref> refs;
     std::vector<std::string> refIDs;
     std::vector<ESM::ESMReader> readers;
+
+    // Every reference is read here anyway, so keep a compact copy per cell for CellStore
+    mCellRefs.clear();
+    mCellRefIds.clear();
+    CellRefIndex index {mCellRefs, mCellRefIds, {}};
+
     for(auto it = mCells.intBegin(); it != mCells.intEnd(); it++)
-        readRefs(*it, refs, refIDs, readers);
+        readRefs(*it, refs, refIDs, readers, index);
     for(auto it = mCells.extBegin(); it != mCells.extEnd(); it++)
-        readRefs(*it, refs, refIDs, readers);
+        readRefs(*it, refs, refIDs, readers, index);
     const auto lessByRefNum = [] (const Ref& l, const Ref& r) { return l.mRefNum < r.mRefNum; };
     std::stable_sort(refs.begin(), refs.end(), lessByRefNum);
     const auto equalByRefNum = [] (const Ref& l, const Ref& r) { return l.mRefNum == r.mRefNum; };
@@ -289,6 +394,14 @@ int ESMStore::getRefCount(const std::string& id) const
     return it->second;
 }
 
+const std::vector<ESMStore::CellRefEntry>* ESMStore::getCellRefs(const ESM::Cell& cell) const
+{
+    auto it = mCellRefs.find(&cell);
+    if(it == mCellRefs.end())
+        return nullptr;
+    return &it->second;
+}
+
 void ESMStore::validate()
 {
     std::vector<ESM::NPC> npcsToReplace = getNPCsToReplace(mFactions, mClasses, mNpcs.mStatic);
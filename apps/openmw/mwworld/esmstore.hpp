@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWWORLD_ESMSTORE_H
 #define OPENMW_MWWORLD_ESMSTORE_H
 
+#include <chrono>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -23,6 +24,15 @@ namespace MWWorld
 {
     class ESMStore
     {
+    public:
+        /// Reference a cell gets from a content file, as kept by the index countRecords() builds
+        struct CellRefEntry
+        {
+            uint32_t mRefId; // Index for getCellRefId()
+            bool mDeleted;
+        };
+
+    private:
         Store<ESM::Activator>       mActivators;
         Store<ESM::Potion>          mPotions;
         Store<ESM::Apparatus>       mAppas;
@@ -79,6 +89,9 @@ namespace MWWorld
 
         std::unordered_map<std::string, int> mRefCount;
 
+        std::unordered_map<const ESM::Cell*, std::vector<CellRefEntry> > mCellRefs;
+        std::vector<std::string> mCellRefIds;
+
         std::map<int, StoreBase *> mStores;
 
         unsigned int mDynamicCount;
@@ -89,6 +102,9 @@ namespace MWWorld
         void validate();
 
         void countRecords();
+
+        /// Read the record at \a offset from \a esm, for records that need what was loaded before them
+        void loadRecord(ESM::ESMReader &esm, size_t offset, ESM::Dialogue *&dialogue);
     public:
         /// \todo replace with SharedIterator<StoreBase>
         typedef std::map<int, StoreBase *>::const_iterator iterator;
@@ -183,7 +199,37 @@ namespace MWWorld
         /// Validate entries in store after loading a save
         void validateDynamic();
 
+        /// Records of one content file, read ahead of merging them into the stores
+        struct ParsedFile
+        {
+            struct Record
+            {
+                int mType;
+                size_t mOffset;
+                std::unique_ptr<ParsedRecord> mRecord; // nullptr if the record is read from the file during the merge
+            };
+
+            struct TypeStats
+            {
+                size_t mCount = 0;
+                std::chrono::steady_clock::duration mParseTime {};
+                std::chrono::steady_clock::duration mMergeTime {};
+            };
+
+            std::vector<Record> mRecords;
+            std::map<int, TypeStats> mStats;
+        };
+
+        void parse(ESM::ESMReader &esm, ParsedFile &file) const;
+        ///< Read the records of \a esm that do not depend on other content files. The store is not
+        /// changed, so several files can be parsed at the same time on different threads.
+
+        void merge(ESM::ESMReader &esm, ParsedFile &file, Loading::Listener* listener);
+        ///< Insert the records of \a file into the stores. Files have to be merged one at a time and
+        /// in load order, which keeps the result identical to loading them one after another.
+
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
+        ///< Parse and merge a single file
 
         template <class T>
         const Store<T> &get() const {
@@ -268,6 +314,13 @@ namespace MWWorld
         /// @return The number of instances defined in the base files. Excludes changes from the save file.
         int getRefCount(const std::string& id) const;
 
+        /// @return The references \a cell gets from the content files, in load order and without the ones
+        /// moved to other cells, or nullptr if the cell is not indexed.
+        const std::vector<CellRefEntry>* getCellRefs(const ESM::Cell& cell) const;
+
+        /// @return Lower case ID of a reference returned by getCellRefs()
+        const std::string& getCellRefId(uint32_t index) const { return mCellRefIds[index]; }
+
         /// Actors with the same ID share spells, abilities, etc.
         /// @return The shared spell list to use for this actor and whether or not it has already been initialized.
         std::pair<std::shared_ptr<MWMechanics::SpellList>, bool> getSpellList(const std::string& id) const;
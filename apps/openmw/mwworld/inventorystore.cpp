@@ -111,6 +111,7 @@ void MWWorld::InventoryStore::readEquipmentState(const MWWorld::ContainerStoreIt
 
 MWWorld::InventoryStore::InventoryStore()
  : ContainerStore()
+ , mMagicEffectsRevision(0)
  , mInventoryListener(nullptr)
  , mUpdatesEnabled (true)
  , mFirstAutoEquip(true)
@@ -122,6 +123,7 @@ MWWorld::InventoryStore::InventoryStore()
 MWWorld::InventoryStore::InventoryStore (const InventoryStore& store)
  : ContainerStore (store)
  , mMagicEffects(store.mMagicEffects)
+ , mMagicEffectsRevision(store.mMagicEffectsRevision)
  , mInventoryListener(store.mInventoryListener)
  , mUpdatesEnabled(store.mUpdatesEnabled)
  , mFirstAutoEquip(store.mFirstAutoEquip)
@@ -139,6 +141,7 @@ MWWorld::InventoryStore& MWWorld::InventoryStore::operator= (const InventoryStor
     mListener = store.mListener;
     mInventoryListener = store.mInventoryListener;
     mMagicEffects = store.mMagicEffects;
+    mMagicEffectsRevision = store.mMagicEffectsRevision;
     mFirstAutoEquip = store.mFirstAutoEquip;
     mPermanentMagicEffectMagnitudes = store.mPermanentMagicEffectMagnitudes;
     mRechargingItemsUpToDate = false;
@@ -617,6 +620,11 @@ const MWMechanics::MagicEffects& MWWorld::InventoryStore::getMagicEffects() cons
     return mMagicEffects;
 }
 
+std::size_t MWWorld::InventoryStore::getMagicEffectsRevision() const
+{
+    return mMagicEffectsRevision;
+}
+
 void MWWorld::InventoryStore::updateMagicEffects(const Ptr& actor)
 {
     // To avoid excessive updates during auto-equip
@@ -628,6 +636,7 @@ void MWWorld::InventoryStore::updateMagicEffects(const Ptr& actor)
         return;
 
     mMagicEffects = MWMechanics::MagicEffects();
+    mMagicEffectsRevision = MWMechanics::makeMagicEffectsRevision();
 
     const auto& stats = actor.getClass().getCreatureStats(actor);
     if (stats.isDead() && stats.isDeathAnimationFinished())
@@ -1032,7 +1041,10 @@ void MWWorld::InventoryStore::purgeEffect(short effectId, const std::string &sou
                 magnitude *= params[i].mMultiplier;
 
                 if (magnitude)
+                {
                     mMagicEffects.add (*effectIt, -magnitude);
+                    mMagicEffectsRevision = MWMechanics::makeMagicEffectsRevision();
+                }
 
                 params[i].mMultiplier = 0;
             }
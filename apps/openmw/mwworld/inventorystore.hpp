@@ -69,6 +69,7 @@ namespace MWWorld
         private:
 
             MWMechanics::MagicEffects mMagicEffects;
+            std::size_t mMagicEffectsRevision;
 
             InventoryStoreListener* mInventoryListener;
 
@@ -164,6 +165,9 @@ namespace MWWorld
             const MWMechanics::MagicEffects& getMagicEffects() const;
             ///< Return magic effects from worn items.
 
+            std::size_t getMagicEffectsRevision() const;
+            ///< Changes whenever the effects returned by getMagicEffects change.
+
             bool stacks (const ConstPtr& ptr1, const ConstPtr& ptr2) const override;
             ///< @return true if the two specified objects can stack with each other
 
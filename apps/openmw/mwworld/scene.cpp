@@ -1,5 +1,6 @@
 #include "scene.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <chrono>
 #include <thread>
@@ -809,6 +810,10 @@ namespace MWWorld
         mPhysics->setUnrefQueue(rendering.getUnrefQueue());
 
         rendering.getResourceSystem()->setExpiryDelay(Settings::Manager::getFloat("cache expiry delay", "Cells"));
+        rendering.getResourceSystem()->setArchiveCacheBudget(static_cast<std::size_t>(
+            std::max(0, Settings::Manager::getInt("archive cache budget", "Cells"))) * 1024 * 1024);
+        rendering.getResourceSystem()->setMemoryBudget(static_cast<std::size_t>(
+            std::max(0, Settings::Manager::getInt("cache memory budget", "Cells"))) * 1024 * 1024);
 
         mPreloader->setExpiryDelay(Settings::Manager::getFloat("preload cell expiry delay", "Cells"));
         mPreloader->setMinCacheSize(Settings::Manager::getInt("preload cell cache min", "Cells"));
@@ -28,6 +28,13 @@ namespace
             return x->mX < y.first;
         }
     };
+
+    template <class T>
+    struct TypedParsedRecord : public MWWorld::ParsedRecord
+    {
+        T mRecord;
+        bool mIsDeleted = false;
+    };
 }
 
 namespace MWWorld
@@ -185,6 +192,28 @@ namespace MWWorld
         return RecordId(record.mId, isDeleted);
     }
     template<typename T>
+    std::unique_ptr<ParsedRecord> Store<T>::parse(ESM::ESMReader &esm) const
+    {
+        std::unique_ptr<TypedParsedRecord<T>> parsed = std::make_unique<TypedParsedRecord<T>>();
+
+        parsed->mRecord.load(esm, parsed->mIsDeleted);
+        Misc::StringUtils::lowerCaseInPlace(parsed->mRecord.mId);
+
+        return parsed;
+    }
+    template<typename T>
+    RecordId Store<T>::loadParsed(ParsedRecord &record)
+    {
+        TypedParsedRecord<T>& parsed = static_cast<TypedParsedRecord<T>&>(record);
+        RecordId id(parsed.mRecord.mId, parsed.mIsDeleted);
+
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id.mId, std::move(parsed.mRecord));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+
+        return id;
+    }
+    template<typename T>
     void Store<T>::setUp()
     {
     }
@@ -1145,6 +1174,14 @@ namespace MWWorld
         return RecordId(dialogue.mId, isDeleted);
     }
 
+    template <>
+    inline std::unique_ptr<ParsedRecord> Store<ESM::Dialogue>::parse(ESM::ESMReader &esm) const
+    {
+        // Dialogues are merged with the ones from earlier content files, and the info records that
+        // follow them are read into whichever dialogue is current at that point
+        return nullptr;
+    }
+
     template<>
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWWORLD_STORE_H
 #define OPENMW_MWWORLD_STORE_H
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -27,6 +28,12 @@ namespace MWWorld
         RecordId(const std::string &id = "", bool isDeleted = false);
     };
 
+    /// Record read by StoreBase::parse, waiting to be inserted into its store
+    struct ParsedRecord
+    {
+        virtual ~ParsedRecord() {}
+    };
+
     class StoreBase
     {
     public:
@@ -41,6 +48,13 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader &esm) = 0;
 
+        virtual std::unique_ptr<ParsedRecord> parse(ESM::ESMReader &esm) const { return nullptr; }
+        ///< Read the current record without changing the store, so several content files can be read at once.
+        /// Returns nullptr for records that depend on what was loaded before them, which have to go through load().
+
+        virtual RecordId loadParsed(ParsedRecord &record) { return RecordId(); }
+        ///< Insert a record returned by parse()
+
         virtual bool eraseStatic(const std::string &id) {return false;}
         virtual void clearDynamic() {}
 
@@ -196,6 +210,8 @@ namespace MWWorld
         bool erase(const T &item);
 
         RecordId load(ESM::ESMReader &esm) override;
+        std::unique_ptr<ParsedRecord> parse(ESM::ESMReader &esm) const override;
+        RecordId loadParsed(ParsedRecord &record) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
     };
@@ -9,6 +9,8 @@
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 
+#include <boost/filesystem/path.hpp>
+
 /*
     Start of tes3mp addition
 
@@ -166,7 +168,8 @@ namespace MWWorld
         const std::vector<std::string>& groundcoverFiles,
         ToUTF8::Utf8Encoder* encoder, int activationDistanceOverride,
         const std::string& startCell, const std::string& startupScript,
-        const std::string& resourcePath, const std::string& userDataPath)
+        const std::string& resourcePath, const std::string& userDataPath,
+        const std::string& cachePath)
     : mResourceSystem(resourceSystem), mLocalScripts (mStore),
       mCells (mStore, mEsm), mSky (true),
       mGodMode(false), mScriptsEnabled(true), mDiscardMovements(true), mContentFiles (contentFiles),
@@ -190,6 +193,7 @@ namespace MWWorld
         gameContentLoader.addLoader(".project", &esmLoader);
 
         loadContentFiles(fileCollections, contentFiles, groundcoverFiles, gameContentLoader);
+        esmLoader.finish();
 
         listener->loadingOff();
 
@@ -213,6 +217,7 @@ namespace MWWorld
             navigatorSettings->mMaxClimb = MWPhysics::sStepSizeUp;
             navigatorSettings->mMaxSlope = MWPhysics::sMaxSlope;
             navigatorSettings->mSwimHeightScale = mSwimHeightScale;
+            navigatorSettings->mNavMeshDbPath = (boost::filesystem::path(cachePath) / "navmesh").string();
             DetourNavigator::RecastGlobalAllocator::init();
             mNavigator.reset(new DetourNavigator::NavigatorImpl(*navigatorSettings));
         }
@@ -1804,9 +1809,13 @@ namespace MWWorld
             if (const auto object = mPhysics->getObject(door.first))
                 updateNavigatorObject(*object);
 
+        const ESM::Position& playerPosition = getPlayerPtr().getRefData().getPosition();
+        const osg::Quat playerOrientation(playerPosition.rot[2], osg::Vec3f(0, 0, -1));
+        mNavigator->setPlayerView(playerPosition.asVec3(), playerOrientation * osg::Vec3f(0, 1, 0));
+
         if (mShouldUpdateNavigator)
         {
-            mNavigator->update(getPlayerPtr().getRefData().getPosition().asVec3());
+            mNavigator->update(playerPosition.asVec3());
             mShouldUpdateNavigator = false;
         }
     }
@@ -2779,6 +2788,17 @@ namespace MWWorld
         mRendering->getCamera()->adjustCameraDistance(dist);
     }
 
+    void World::getCameraView(osg::Vec3f& position, osg::Vec3f& direction) const
+    {
+        const MWRender::Camera* camera = mRendering->getCamera();
+        osg::Vec3d focal, cameraPosition;
+        camera->getPosition(focal, cameraPosition);
+        position = cameraPosition;
+        // Same orientation as Camera::updateCamera, without the head bobbing roll
+        direction = osg::Quat(camera->getPitch(), osg::Vec3f(1, 0, 0)) * osg::Quat(camera->getYaw(), osg::Vec3f(0, 0, 1))
+            * osg::Vec3f(0, 1, 0);
+    }
+
     void World::saveLoaded()
     {
         mStore.validateDynamic();
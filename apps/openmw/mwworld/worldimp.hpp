@@ -204,7 +204,8 @@ namespace MWWorld
                 const std::vector<std::string>& groundcoverFiles,
                 ToUTF8::Utf8Encoder* encoder, int activationDistanceOverride,
                 const std::string& startCell, const std::string& startupScript,
-                const std::string& resourcePath, const std::string& userDataPath);
+                const std::string& resourcePath, const std::string& userDataPath,
+                const std::string& cachePath);
 
             virtual ~World();
 
@@ -673,6 +674,7 @@ namespace MWWorld
             void allowVanityMode(bool allow) override;
             bool vanityRotateCamera(float * rot) override;
             void adjustCameraDistance(float dist) override;
+            void getCameraView(osg::Vec3f& position, osg::Vec3f& direction) const override;
 
             void applyDeferredPreviewRotationToPlayer(float dt) override;
             void disableDeferredPreviewRotation() override;
@@ -185,6 +185,41 @@ namespace
         )) << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_paths_should_return_same_paths_as_find_path)
+    {
+        const std::array<btScalar, 5 * 5> heightfieldData {{
+            0,   0,    0,    0,    0,
+            0, -25,  -25,  -25,  -25,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+        }};
+        const auto shapePtr = makeSquareHeightfieldTerrainShape(heightfieldData);
+        btHeightfieldTerrainShape& shape = *shapePtr;
+        shape.setLocalScaling(btVector3(128, 128, 1));
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        mNavigator->addObject(ObjectId(&shape), nullptr, shape, btTransform::getIdentity());
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        EXPECT_EQ(mNavigator->findPath(mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mOut), Status::Success);
+
+        const PathRequest request {mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts};
+        const PathRequest reversed {mAgentHalfExtents, mStepSize, mEnd, mStart, Flag_walk, mAreaCosts};
+        const PathRequest otherAgent {osg::Vec3f(1, 1, 1), mStepSize, mStart, mEnd, Flag_walk, mAreaCosts};
+        const auto results = mNavigator->findPaths({request, otherAgent, reversed, request});
+
+        ASSERT_EQ(results.size(), 4u);
+        EXPECT_EQ(results[0].mStatus, Status::Success);
+        EXPECT_EQ(std::deque<osg::Vec3f>(results[0].mPath.begin(), results[0].mPath.end()), mPath);
+        EXPECT_EQ(results[1].mStatus, Status::NavMeshNotFound);
+        EXPECT_EQ(results[2].mStatus, Status::Success);
+        EXPECT_FALSE(results[2].mPath.empty());
+        EXPECT_EQ(results[3].mStatus, Status::Success);
+        EXPECT_EQ(results[3].mPath, results[0].mPath);
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         const std::array<btScalar, 5 * 5> heightfieldData {{
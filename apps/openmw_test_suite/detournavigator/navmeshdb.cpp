@@ -0,0 +1,135 @@
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshDbTest : Test
+    {
+        const boost::filesystem::path mPath = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("navmeshdb-%%%%%%%%");
+        Settings mSettings;
+        const std::vector<unsigned char> mData {{1, 2, 3, 4, 5, 6, 7, 8}};
+
+        DetourNavigatorNavMeshDbTest()
+        {
+            mSettings.mCellSize = 0.2f;
+            mSettings.mTileSize = 64;
+        }
+
+        ~DetourNavigatorNavMeshDbTest()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(mPath, ec);
+        }
+
+        static std::vector<unsigned char> toVector(const NavMeshData& data)
+        {
+            return std::vector<unsigned char>(data.mValue.get(), data.mValue.get() + data.mSize);
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_for_empty_db_should_return_empty_value)
+    {
+        NavMeshDb db(mPath, 1024 * 1024, mSettings);
+        EXPECT_FALSE(db.get("42").mValue);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, put_tile_should_be_loaded_by_next_db)
+    {
+        {
+            NavMeshDb db(mPath, 1024 * 1024, mSettings);
+            db.put("42", mData.data(), static_cast<int>(mData.size()));
+        }
+        NavMeshDb db(mPath, 1024 * 1024, mSettings);
+        const NavMeshData result = db.get("42");
+        ASSERT_TRUE(result.mValue);
+        EXPECT_EQ(toVector(result), mData);
+        EXPECT_FALSE(db.get("43").mValue);
+        EXPECT_EQ(db.getStats().mTiles, 1u);
+        EXPECT_EQ(db.getStats().mHits, 1u);
+        EXPECT_EQ(db.getStats().mMisses, 1u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, key_should_depend_on_settings)
+    {
+        const std::vector<int> indices {{0, 1, 2}};
+        const std::vector<float> vertices {{0, 0, 0, 1, 0, 0, 1, 1, 0}};
+        const std::vector<AreaType> areaTypes {1, AreaType_ground};
+        const RecastMesh recastMesh(0, 0, indices, vertices, areaTypes, {});
+        const osg::Vec3f agentHalfExtents(1, 2, 3);
+        const TilePosition tilePosition(0, 0);
+
+        const NavMeshDb db(mPath, 1024 * 1024, mSettings);
+        Settings otherSettings = mSettings;
+        otherSettings.mCellSize = 0.4f;
+        const NavMeshDb otherDb(mPath, 1024 * 1024, otherSettings);
+
+        const auto key = db.makeKey(agentHalfExtents, tilePosition, recastMesh, {});
+        EXPECT_EQ(key, db.makeKey(agentHalfExtents, tilePosition, recastMesh, {}));
+        EXPECT_NE(key, otherDb.makeKey(agentHalfExtents, tilePosition, recastMesh, {}));
+        EXPECT_NE(key, db.makeKey(agentHalfExtents, TilePosition(1, 0), recastMesh, {}));
+        EXPECT_NE(key, db.makeKey(agentHalfExtents, tilePosition, recastMesh,
+            {OffMeshConnection {osg::Vec3f(0, 0, 0), osg::Vec3f(1, 0, 0), AreaType_door}}));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tiles_over_max_size_should_be_removed)
+    {
+        const std::size_t maxSize = 3 * (mData.size() + 32);
+        {
+            NavMeshDb db(mPath, maxSize, mSettings);
+            for (int key = 0; key < 10; ++key)
+                db.put(std::to_string(key), mData.data(), static_cast<int>(mData.size()));
+        }
+        NavMeshDb db(mPath, maxSize, mSettings);
+        EXPECT_LE(db.getStats().mSize, maxSize);
+        EXPECT_GT(db.getStats().mTiles, 0u);
+        EXPECT_LT(db.getStats().mTiles, 10u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, corrupted_tile_should_be_ignored)
+    {
+        {
+            NavMeshDb db(mPath, 1024 * 1024, mSettings);
+            db.put("42", mData.data(), static_cast<int>(mData.size()));
+        }
+        for (boost::filesystem::directory_iterator it(mPath), end; it != end; ++it)
+            boost::filesystem::resize_file(it->path(), 20);
+        NavMeshDb db(mPath, 1024 * 1024, mSettings);
+        EXPECT_FALSE(db.get("42").mValue);
+        EXPECT_EQ(db.getStats().mTiles, 0u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tile_stored_for_other_key_with_same_hash_should_not_be_loaded)
+    {
+        {
+            NavMeshDb db(mPath, 1024 * 1024, mSettings);
+            db.put("42", mData.data(), static_cast<int>(mData.size()));
+        }
+        const boost::filesystem::path stored = boost::filesystem::directory_iterator(mPath)->path();
+        {
+            NavMeshDb db(mPath, 1024 * 1024, mSettings);
+            db.put("43", mData.data(), static_cast<int>(mData.size()));
+        }
+
+        // Make the file of the second key hold the tile of the first, as if both keys had the same hash
+        for (boost::filesystem::directory_iterator it(mPath), end; it != end; ++it)
+            if (it->path() != stored)
+                boost::filesystem::copy_file(stored, it->path(), boost::filesystem::copy_option::overwrite_if_exists);
+
+        NavMeshDb db(mPath, 1024 * 1024, mSettings);
+        EXPECT_FALSE(db.get("43").mValue);
+        EXPECT_TRUE(db.get("42").mValue);
+    }
+}
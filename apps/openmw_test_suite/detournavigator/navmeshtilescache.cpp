@@ -136,6 +136,23 @@ namespace
         EXPECT_FALSE(cache.get(mAgentHalfExtents, mTilePosition, unexistentRecastMesh, mOffMeshConnections));
     }
 
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, get_for_cache_miss_by_any_off_mesh_connection_should_return_empty_value)
+    {
+        std::vector<OffMeshConnection> offMeshConnections;
+        for (int i = 0; i < 9; ++i)
+            offMeshConnections.push_back(OffMeshConnection {osg::Vec3f(i, 0, 0), osg::Vec3f(i, 1, 0), AreaType_ground});
+        std::vector<OffMeshConnection> otherOffMeshConnections = offMeshConnections;
+        otherOffMeshConnections[4].mEnd = osg::Vec3f(4, 2, 0);
+        const std::size_t navMeshDataSize = 1;
+        const std::size_t navMeshKeySize = cRecastMeshKeySize + offMeshConnections.size() * sizeof(OffMeshConnection);
+        const std::size_t maxSize = navMeshDataSize + navMeshKeySize;
+        NavMeshTilesCache cache(maxSize);
+
+        cache.set(mAgentHalfExtents, mTilePosition, mRecastMesh, offMeshConnections, std::move(mNavMeshData));
+        EXPECT_FALSE(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, otherOffMeshConnections));
+        EXPECT_TRUE(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, offMeshConnections));
+    }
+
     TEST_F(DetourNavigatorNavMeshTilesCacheTest, set_should_replace_unused_value)
     {
         const std::size_t navMeshDataSize = 1;
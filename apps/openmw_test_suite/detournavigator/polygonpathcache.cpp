@@ -0,0 +1,81 @@
+#include <components/detournavigator/polygonpathcache.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorPolygonPathCacheTest : Test
+    {
+        const float mCellSize = 0.5f;
+        const osg::Vec3f mStart {1, 2, 3};
+        const osg::Vec3f mEnd {11, 12, 13};
+        const PolygonPathKey mKey = makePolygonPathKey(1, 2, mStart, mEnd, Flag_walk, AreaCosts {}, mCellSize);
+        const std::vector<dtPolyRef> mPath {{1, 3, 2}};
+    };
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, get_for_empty_cache_should_return_empty_value)
+    {
+        PolygonPathCache cache(4);
+        EXPECT_EQ(cache.get(mKey), std::nullopt);
+        EXPECT_EQ(cache.getMisses(), 1u);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, get_after_set_should_return_path)
+    {
+        PolygonPathCache cache(4);
+        cache.set(mKey, mPath);
+        EXPECT_EQ(cache.get(mKey), mPath);
+        EXPECT_EQ(cache.getHits(), 1u);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, get_for_other_flags_or_costs_should_return_empty_value)
+    {
+        PolygonPathCache cache(4);
+        cache.set(mKey, mPath);
+        PolygonPathKey otherFlags = mKey;
+        otherFlags.mIncludeFlags = Flag_swim;
+        EXPECT_EQ(cache.get(otherFlags), std::nullopt);
+        PolygonPathKey otherCosts = mKey;
+        otherCosts.mAreaCosts.mDoor = 10;
+        EXPECT_EQ(cache.get(otherCosts), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, get_for_other_positions_in_same_cells_should_return_path)
+    {
+        PolygonPathCache cache(4);
+        cache.set(mKey, mPath);
+        const osg::Vec3f start = mStart + osg::Vec3f(0.1f, 0.2f, 0.3f);
+        const osg::Vec3f end = mEnd + osg::Vec3f(0.3f, 0.2f, 0.1f);
+        EXPECT_EQ(cache.get(makePolygonPathKey(1, 2, start, end, Flag_walk, AreaCosts {}, mCellSize)), mPath);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, get_for_other_positions_in_same_polygons_should_return_empty_value)
+    {
+        PolygonPathCache cache(4);
+        cache.set(mKey, mPath);
+        const osg::Vec3f start = mStart + osg::Vec3f(4, 0, 0);
+        const osg::Vec3f end = mEnd - osg::Vec3f(0, 4, 0);
+        EXPECT_EQ(cache.get(makePolygonPathKey(1, 2, start, mEnd, Flag_walk, AreaCosts {}, mCellSize)), std::nullopt);
+        EXPECT_EQ(cache.get(makePolygonPathKey(1, 2, mStart, end, Flag_walk, AreaCosts {}, mCellSize)), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, set_over_max_size_should_drop_previous_paths)
+    {
+        PolygonPathCache cache(2);
+        for (dtPolyRef end = 2; end < 5; ++end)
+            cache.set(makePolygonPathKey(1, end, mStart, mEnd, Flag_walk, AreaCosts {}, mCellSize), mPath);
+        EXPECT_LE(cache.size(), 2u);
+        EXPECT_EQ(cache.get(makePolygonPathKey(1, 4, mStart, mEnd, Flag_walk, AreaCosts {}, mCellSize)), mPath);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, get_after_clear_should_return_empty_value)
+    {
+        PolygonPathCache cache(4);
+        cache.set(mKey, mPath);
+        cache.clear();
+        EXPECT_EQ(cache.get(mKey), std::nullopt);
+    }
+}
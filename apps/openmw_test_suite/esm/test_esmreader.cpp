@@ -0,0 +1,155 @@
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/esm/loadglob.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    struct ESMReaderTest : Test
+    {
+        boost::filesystem::path mPath;
+        std::string mData;
+
+        ESMReaderTest()
+            : mPath(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("esmreader-%%%%%%%%.esp"))
+        {
+            std::stringstream stream;
+            ESMWriter writer;
+            writer.setFormat(0);
+            writer.save(stream);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                Global global;
+                global.mId = "global" + std::to_string(i);
+                global.mValue.setType(VT_Long);
+                global.mValue.setInteger(i * 10);
+
+                writer.startRecord(Global::sRecordId);
+                global.save(writer);
+                writer.endRecord(Global::sRecordId);
+            }
+            writer.close();
+
+            mData = stream.str();
+            boost::filesystem::ofstream file(mPath, std::ios::binary);
+            file << mData;
+        }
+
+        ~ESMReaderTest()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(mPath, ec);
+        }
+
+        static std::vector<Global> readAll(ESMReader& reader)
+        {
+            std::vector<Global> result;
+            while (reader.hasMoreRecs())
+            {
+                EXPECT_EQ(reader.getRecName().intval, Global::sRecordId);
+                reader.getRecHeader();
+
+                Global global;
+                bool isDeleted = false;
+                global.load(reader, isDeleted);
+                result.push_back(global);
+            }
+            return result;
+        }
+    };
+
+    TEST_F(ESMReaderTest, open_by_name_should_map_the_file)
+    {
+        ESMReader reader;
+        reader.open(mPath.string());
+        EXPECT_TRUE(reader.isMapped());
+        EXPECT_EQ(reader.getFileSize(), mData.size());
+    }
+
+    TEST_F(ESMReaderTest, mapped_file_should_read_the_same_records_as_stream)
+    {
+        ESMReader mapped;
+        mapped.open(mPath.string());
+
+        ESMReader streamed;
+        streamed.open(Files::IStreamPtr(new std::istringstream(mData)), mPath.string());
+        EXPECT_FALSE(streamed.isMapped());
+
+        const std::vector<Global> fromMapped = readAll(mapped);
+        const std::vector<Global> fromStream = readAll(streamed);
+
+        ASSERT_EQ(fromMapped.size(), 3u);
+        ASSERT_EQ(fromStream.size(), 3u);
+        for (std::size_t i = 0; i < fromMapped.size(); ++i)
+        {
+            EXPECT_EQ(fromMapped[i].mId, fromStream[i].mId);
+            EXPECT_EQ(fromMapped[i].mValue, fromStream[i].mValue);
+        }
+    }
+
+    TEST_F(ESMReaderTest, restore_context_should_continue_from_saved_record)
+    {
+        ESMReader reader;
+        reader.open(mPath.string());
+
+        reader.getRecName();
+        reader.getRecHeader();
+        reader.skipRecord();
+
+        const ESM_Context context = reader.getContext();
+        const std::vector<Global> rest = readAll(reader);
+        ASSERT_EQ(rest.size(), 2u);
+
+        // A second reader of the same file shares the mapping and only needs to seek
+        ESMReader other;
+        other.restoreContext(context);
+        EXPECT_TRUE(other.isMapped());
+
+        const std::vector<Global> restored = readAll(other);
+        ASSERT_EQ(restored.size(), 2u);
+        EXPECT_EQ(restored[0].mId, "global1");
+        EXPECT_EQ(restored[1].mValue.getInteger(), 20);
+    }
+
+    TEST_F(ESMReaderTest, mapped_file_should_convert_strings_that_are_not_zero_terminated)
+    {
+        // Subrecord strings are stored without a terminator, so in the mapped file this one is
+        // directly followed by the next subrecord
+        std::stringstream stream;
+        ESMWriter writer;
+        writer.setFormat(0);
+        writer.save(stream);
+        writer.startRecord(Global::sRecordId);
+        writer.writeHNString("NAME", "caf\xe9");
+        writer.writeHNString("FNAM", "s");
+        writer.endRecord(Global::sRecordId);
+        writer.close();
+
+        {
+            boost::filesystem::ofstream file(mPath, std::ios::binary | std::ios::trunc);
+            file << stream.str();
+        }
+
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        ESMReader reader;
+        reader.setEncoder(&encoder);
+        reader.open(mPath.string());
+        ASSERT_TRUE(reader.isMapped());
+
+        reader.getRecName();
+        reader.getRecHeader();
+        EXPECT_EQ(reader.getHNString("NAME"), "caf\xc3\xa9");
+        EXPECT_EQ(reader.getHNString("FNAM"), "s");
+    }
+}
@@ -0,0 +1,70 @@
+#include <components/misc/spatialgrid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    std::vector<int> findInRange(const Misc::SpatialGrid<int>& grid, const osg::Vec3f& position, float radius)
+    {
+        std::vector<int> result;
+        grid.forEachInRange(position, radius, [&] (int value) { result.push_back(value); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    TEST(MiscSpatialGridTest, should_find_values_within_radius)
+    {
+        Misc::SpatialGrid<int> grid(512);
+        grid.add(osg::Vec3f(0, 0, 0), 1);
+        grid.add(osg::Vec3f(100, 0, 0), 2);
+        grid.add(osg::Vec3f(0, 0, 300), 3);
+        grid.add(osg::Vec3f(-600, -600, 0), 4);
+        EXPECT_EQ(grid.size(), 4u);
+        EXPECT_EQ(findInRange(grid, osg::Vec3f(0, 0, 0), 200), std::vector<int>({1, 2}));
+        EXPECT_EQ(findInRange(grid, osg::Vec3f(0, 0, 0), 300), std::vector<int>({1, 2, 3}));
+        EXPECT_EQ(findInRange(grid, osg::Vec3f(-550, -550, 0), 100), std::vector<int>({4}));
+    }
+
+    TEST(MiscSpatialGridTest, cleared_grid_should_be_empty)
+    {
+        Misc::SpatialGrid<int> grid(512);
+        grid.add(osg::Vec3f(0, 0, 0), 1);
+        grid.clear();
+        EXPECT_EQ(grid.size(), 0u);
+        EXPECT_EQ(findInRange(grid, osg::Vec3f(0, 0, 0), 1000), std::vector<int>());
+        grid.add(osg::Vec3f(10, 0, 0), 2);
+        EXPECT_EQ(findInRange(grid, osg::Vec3f(0, 0, 0), 1000), std::vector<int>({2}));
+    }
+
+    TEST(MiscSpatialGridTest, should_find_the_same_values_as_linear_search)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-5000, 5000);
+        std::vector<osg::Vec3f> positions;
+        Misc::SpatialGrid<int> grid(512);
+        for (int i = 0; i < 300; ++i)
+        {
+            positions.emplace_back(distribution(random), distribution(random), distribution(random) / 10);
+            grid.add(positions.back(), i);
+        }
+
+        for (float radius : {50.f, 700.f, 7168.f, 20000.f})
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                const osg::Vec3f position(distribution(random), distribution(random), 0);
+                std::vector<int> expected;
+                for (int j = 0; j < static_cast<int>(positions.size()); ++j)
+                    if ((positions[j] - position).length2() <= radius * radius)
+                        expected.push_back(j);
+                EXPECT_EQ(findInRange(grid, position, radius), expected) << radius;
+            }
+        }
+    }
+}
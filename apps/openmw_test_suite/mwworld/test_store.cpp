@@ -318,3 +318,76 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests that parsing files out of order and merging them in load order gives the same result as loading
+/// them one after another, including records that are read again during the merge.
+TEST_F(StoreTest, parse_merge_test)
+{
+    ESM::Apparatus apparatus;
+    apparatus.blank();
+    apparatus.mId = "foobar";
+    apparatus.mModel = "master_model";
+
+    ESM::Apparatus other;
+    other.blank();
+    other.mId = "other";
+
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "topic";
+    dialogue.mType = ESM::Dialogue::Topic;
+
+    ESM::DialInfo info;
+    info.blank();
+    info.mId = "info";
+
+    auto* masterStream = new std::stringstream;
+    {
+        ESM::ESMWriter writer;
+        writer.setFormat(0);
+        writer.save(*masterStream);
+        writer.startRecord(ESM::Apparatus::sRecordId);
+        apparatus.save(writer);
+        writer.endRecord(ESM::Apparatus::sRecordId);
+        writer.startRecord(ESM::Dialogue::sRecordId);
+        dialogue.save(writer);
+        writer.endRecord(ESM::Dialogue::sRecordId);
+        writer.startRecord(ESM::DialInfo::sRecordId);
+        info.save(writer);
+        writer.endRecord(ESM::DialInfo::sRecordId);
+        writer.startRecord(ESM::Apparatus::sRecordId);
+        other.save(writer);
+        writer.endRecord(ESM::Apparatus::sRecordId);
+    }
+
+    apparatus.mModel = "plugin_model";
+    Files::IStreamPtr pluginFile = getEsmFile(apparatus, false);
+
+    std::vector<ESM::ESMReader> readerList(2);
+    for (int i = 0; i < 2; ++i)
+    {
+        readerList[i].setIndex(i);
+        readerList[i].setGlobalReaderList(&readerList);
+    }
+    readerList[0].open(Files::IStreamPtr(masterStream), "master");
+    readerList[1].open(pluginFile, "plugin");
+
+    MWWorld::ESMStore::ParsedFile master;
+    MWWorld::ESMStore::ParsedFile plugin;
+    mEsmStore.parse(readerList[1], plugin);
+    mEsmStore.parse(readerList[0], master);
+
+    mEsmStore.merge(readerList[0], master, &dummyListener);
+    mEsmStore.merge(readerList[1], plugin, &dummyListener);
+    mEsmStore.setUp();
+
+    const ESM::Apparatus* merged = mEsmStore.get<ESM::Apparatus>().search("foobar");
+    ASSERT_TRUE (merged != nullptr);
+    EXPECT_EQ (merged->mModel, "plugin_model");
+    EXPECT_EQ (mEsmStore.get<ESM::Apparatus>().getSize(), 2u);
+
+    const ESM::Dialogue* topic = mEsmStore.get<ESM::Dialogue>().search("topic");
+    ASSERT_TRUE (topic != nullptr);
+    ASSERT_EQ (topic->mInfo.size(), 1u);
+    EXPECT_EQ (topic->mInfo.front().mId, "info");
+}
@@ -0,0 +1,242 @@
+#include <components/resource/nifscenecache.hpp>
+#include <components/nifosg/matrixtransform.hpp>
+#include <components/vfs/archive.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Image>
+#include <osg/NodeCallback>
+#include <osg/Texture2D>
+#include <osg/io_utils>
+
+#include <osgDB/Registry>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ctime>
+
+namespace
+{
+    using namespace testing;
+
+    osg::ref_ptr<osg::Node> makeScene()
+    {
+        osg::ref_ptr<osg::Group> root = new osg::Group;
+        root->setName("root");
+        root->setUserValue("recIndex", 1u);
+
+        osg::ref_ptr<NifOsg::MatrixTransform> transform = new NifOsg::MatrixTransform;
+        transform->setName("transform");
+        transform->setMatrix(osg::Matrixf::scale(2, 2, 2) * osg::Matrixf::translate(1, 2, 3));
+        transform->mScale = 2;
+        transform->mRotationScale.mValues[0][1] = 0.5f;
+        root->addChild(transform);
+
+        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
+        vertices->push_back(osg::Vec3f(0, 0, 0));
+        vertices->push_back(osg::Vec3f(1, 0, 0));
+        vertices->push_back(osg::Vec3f(0, 1, 0));
+
+        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+        geometry->setName("geometry");
+        geometry->setVertexArray(vertices);
+        geometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, 3));
+        transform->addChild(geometry);
+
+        return root;
+    }
+
+    struct TestNifSceneCache : Test
+    {
+        const boost::filesystem::path mPath = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw-nifscenecache-%%%%-%%%%-%%%%");
+        const std::string mName = "meshes/test.nif";
+        const VFS::FileStamp mStamp {1024, 1000};
+        const std::uint64_t mFingerprint = 42;
+
+        void SetUp() override
+        {
+            if (!osgDB::Registry::instance()->getReaderWriterForExtension("osgb"))
+                GTEST_SKIP() << "osgb plugin is not available";
+        }
+
+        ~TestNifSceneCache()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(mPath, ec);
+        }
+
+        std::vector<boost::filesystem::path> getEntries() const
+        {
+            std::vector<boost::filesystem::path> result;
+            for (boost::filesystem::directory_iterator it(mPath), end; it != end; ++it)
+                result.push_back(it->path());
+            return result;
+        }
+    };
+
+    TEST_F(TestNifSceneCache, read_should_return_same_scene_as_written)
+    {
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        const osg::ref_ptr<osg::Node> scene = makeScene();
+        ASSERT_TRUE(cache.write(mName, mStamp, *scene));
+
+        const osg::ref_ptr<osg::Node> result = cache.read(mName, mStamp, nullptr);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result->getName(), "root");
+        unsigned int recIndex = 0;
+        EXPECT_TRUE(result->getUserValue("recIndex", recIndex));
+        EXPECT_EQ(recIndex, 1u);
+
+        const osg::Group* root = result->asGroup();
+        ASSERT_NE(root, nullptr);
+        ASSERT_EQ(root->getNumChildren(), 1u);
+
+        const auto transform = dynamic_cast<const NifOsg::MatrixTransform*>(root->getChild(0));
+        const auto expectedTransform = static_cast<const NifOsg::MatrixTransform*>(scene->asGroup()->getChild(0));
+        ASSERT_NE(transform, nullptr);
+        EXPECT_EQ(transform->getName(), "transform");
+        EXPECT_EQ(transform->getMatrix(), expectedTransform->getMatrix());
+        EXPECT_EQ(transform->mScale, 2);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                EXPECT_EQ(transform->mRotationScale.mValues[i][j], expectedTransform->mRotationScale.mValues[i][j]) << i << " " << j;
+
+        ASSERT_EQ(transform->getNumChildren(), 1u);
+        const auto geometry = dynamic_cast<const osg::Geometry*>(transform->getChild(0));
+        ASSERT_NE(geometry, nullptr);
+        EXPECT_EQ(geometry->getName(), "geometry");
+        ASSERT_EQ(geometry->getNumPrimitiveSets(), 1u);
+        EXPECT_EQ(geometry->getPrimitiveSet(0)->getNumIndices(), 3u);
+
+        const auto vertices = dynamic_cast<const osg::Vec3Array*>(geometry->getVertexArray());
+        ASSERT_NE(vertices, nullptr);
+        const auto expectedVertices = static_cast<const osg::Vec3Array*>(
+            static_cast<const osg::Geometry*>(expectedTransform->getChild(0))->getVertexArray());
+        EXPECT_EQ(vertices->asVector(), expectedVertices->asVector());
+    }
+
+    TEST_F(TestNifSceneCache, read_should_return_written_scene_after_reopening)
+    {
+        {
+            Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+            ASSERT_TRUE(cache.write(mName, mStamp, *makeScene()));
+        }
+
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        EXPECT_GT(cache.getSize(), 0u);
+        EXPECT_NE(cache.read(mName, mStamp, nullptr), nullptr);
+    }
+
+    TEST_F(TestNifSceneCache, read_should_return_null_for_missing_entry)
+    {
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        EXPECT_EQ(cache.read(mName, mStamp, nullptr), nullptr);
+    }
+
+    TEST_F(TestNifSceneCache, read_should_return_null_for_other_stamp)
+    {
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        ASSERT_TRUE(cache.write(mName, mStamp, *makeScene()));
+        EXPECT_EQ(cache.read(mName, VFS::FileStamp {mStamp.mSize + 1, mStamp.mTime}, nullptr), nullptr);
+        EXPECT_EQ(cache.read(mName, VFS::FileStamp {mStamp.mSize, mStamp.mTime + 1}, nullptr), nullptr);
+    }
+
+    TEST_F(TestNifSceneCache, read_should_return_null_for_other_fingerprint)
+    {
+        {
+            Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+            ASSERT_TRUE(cache.write(mName, mStamp, *makeScene()));
+        }
+
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint + 1);
+        EXPECT_EQ(cache.read(mName, mStamp, nullptr), nullptr);
+    }
+
+    TEST_F(TestNifSceneCache, read_should_return_null_for_corrupted_header)
+    {
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        ASSERT_TRUE(cache.write(mName, mStamp, *makeScene()));
+
+        const std::vector<boost::filesystem::path> entries = getEntries();
+        ASSERT_EQ(entries.size(), 1u);
+        {
+            boost::filesystem::fstream stream(entries[0], std::ios::in | std::ios::out | std::ios::binary);
+            stream.seekp(4);
+            stream.put('\xff');
+        }
+
+        EXPECT_EQ(cache.read(mName, mStamp, nullptr), nullptr);
+    }
+
+    TEST_F(TestNifSceneCache, read_should_return_null_for_truncated_entry)
+    {
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        ASSERT_TRUE(cache.write(mName, mStamp, *makeScene()));
+
+        const std::vector<boost::filesystem::path> entries = getEntries();
+        ASSERT_EQ(entries.size(), 1u);
+        boost::filesystem::resize_file(entries[0], boost::filesystem::file_size(entries[0]) - 1);
+
+        EXPECT_EQ(cache.read(mName, mStamp, nullptr), nullptr);
+    }
+
+    TEST_F(TestNifSceneCache, write_should_skip_scene_with_callbacks)
+    {
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        const osg::ref_ptr<osg::Node> scene = makeScene();
+        scene->asGroup()->getChild(0)->addUpdateCallback(new osg::NodeCallback);
+
+        EXPECT_FALSE(Resource::NifSceneCache::isCacheable(*scene));
+        EXPECT_FALSE(cache.write(mName, mStamp, *scene));
+        EXPECT_EQ(cache.getSize(), 0u);
+        EXPECT_EQ(cache.read(mName, mStamp, nullptr), nullptr);
+    }
+
+    TEST_F(TestNifSceneCache, write_should_skip_scene_with_texture_not_read_from_file)
+    {
+        Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+        const osg::ref_ptr<osg::Node> scene = makeScene();
+        scene->getOrCreateStateSet()->setTextureAttribute(0, new osg::Texture2D(new osg::Image));
+
+        EXPECT_FALSE(Resource::NifSceneCache::isCacheable(*scene));
+        EXPECT_FALSE(cache.write(mName, mStamp, *scene));
+    }
+
+    TEST_F(TestNifSceneCache, write_should_skip_scene_larger_than_max_size)
+    {
+        Resource::NifSceneCache cache(mPath, 16, mFingerprint);
+        EXPECT_FALSE(cache.write(mName, mStamp, *makeScene()));
+        EXPECT_EQ(cache.getSize(), 0u);
+    }
+
+    TEST_F(TestNifSceneCache, write_should_remove_least_recently_used_entries_past_max_size)
+    {
+        std::uint64_t entrySize = 0;
+        {
+            Resource::NifSceneCache cache(mPath, 1024 * 1024, mFingerprint);
+            ASSERT_TRUE(cache.write(mName, mStamp, *makeScene()));
+            entrySize = cache.getSize();
+        }
+
+        // Names of the same length give entries of the same size
+        Resource::NifSceneCache cache(mPath, entrySize * 2 + entrySize / 2, mFingerprint);
+        ASSERT_TRUE(cache.write("meshes/tes2.nif", mStamp, *makeScene()));
+
+        // Times are stored with a resolution of seconds, make the order of use unambiguous
+        for (const boost::filesystem::path& entry : getEntries())
+            boost::filesystem::last_write_time(entry, std::time(nullptr) - 100);
+        ASSERT_NE(cache.read(mName, mStamp, nullptr), nullptr);
+
+        ASSERT_TRUE(cache.write("meshes/tes3.nif", mStamp, *makeScene()));
+
+        EXPECT_EQ(cache.getSize(), entrySize * 2);
+        EXPECT_EQ(getEntries().size(), 2u);
+        EXPECT_NE(cache.read(mName, mStamp, nullptr), nullptr);
+        EXPECT_EQ(cache.read("meshes/tes2.nif", mStamp, nullptr), nullptr);
+        EXPECT_NE(cache.read("meshes/tes3.nif", mStamp, nullptr), nullptr);
+    }
+}
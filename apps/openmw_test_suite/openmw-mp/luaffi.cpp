@@ -0,0 +1,111 @@
+#include <apps/openmw-mp/Script/LangLua/LuaFFI.hpp>
+
+#include <LuaBridge.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    bool flag = false;
+
+    void SetFlag(bool value) noexcept
+    {
+        flag = value;
+    }
+
+    bool IsFlagSet() noexcept
+    {
+        return flag;
+    }
+
+    // Same marshalling as the wrapper<I> functions generated by LangLua
+    int SetFlagWrapper(lua_State* lua) noexcept
+    {
+        SetFlag(luabridge::Stack<bool>::get(lua, 1));
+        return 0;
+    }
+
+    int IsFlagSetWrapper(lua_State* lua) noexcept
+    {
+        luabridge::Stack<bool>::push(lua, IsFlagSet());
+        return 1;
+    }
+
+    struct LuaFFITest : Test
+    {
+        lua_State* mLua;
+        unsigned int mExported = 0;
+
+        LuaFFITest()
+            : mLua(luaL_newstate())
+        {
+            luaL_openlibs(mLua);
+
+            luabridge::getGlobalNamespace(mLua)
+                .beginNamespace("tes3mp")
+                    .addCFunction("SetFlag", SetFlagWrapper)
+                    .addCFunction("IsFlagSet", IsFlagSetWrapper)
+                .endNamespace();
+
+            const std::vector<LuaFFIBinding> bindings {
+                {"SetFlag", 'v', "b", reinterpret_cast<void*>(SetFlag)},
+                {"IsFlagSet", 'b', "", reinterpret_cast<void*>(IsFlagSet)},
+            };
+
+            lua_getglobal(mLua, "tes3mp");
+            mExported = LuaFFI::Export(mLua, bindings);
+            lua_pop(mLua, 1);
+        }
+
+        ~LuaFFITest()
+        {
+            lua_close(mLua);
+        }
+
+        void run(const std::string& script)
+        {
+            ASSERT_EQ(luaL_dostring(mLua, script.c_str()), 0) << lua_tostring(mLua, -1);
+        }
+    };
+
+    TEST(LuaFFIGetCDeclarationTest, should_support_numeric_arguments_and_return_values)
+    {
+        EXPECT_EQ(LuaFFI::GetCDeclaration('f', "iq"), "double (*)(unsigned int, int)");
+        EXPECT_EQ(LuaFFI::GetCDeclaration('b', "i"), "bool (*)(unsigned int)");
+        EXPECT_EQ(LuaFFI::GetCDeclaration('v', ""), "void (*)()");
+    }
+
+    TEST(LuaFFIGetCDeclarationTest, should_not_support_bool_and_string_arguments)
+    {
+        EXPECT_EQ(LuaFFI::GetCDeclaration('v', "b"), "");
+        EXPECT_EQ(LuaFFI::GetCDeclaration('v', "is"), "");
+        EXPECT_EQ(LuaFFI::GetCDeclaration('s', "i"), "");
+    }
+
+    TEST_F(LuaFFITest, bool_argument_should_be_true_for_zero)
+    {
+        flag = false;
+        run("tes3mp.SetFlag(0)");
+        EXPECT_TRUE(flag);
+    }
+
+    TEST_F(LuaFFITest, bool_argument_should_be_false_for_nil)
+    {
+        flag = true;
+        run("tes3mp.SetFlag(nil)");
+        EXPECT_FALSE(flag);
+    }
+
+    TEST_F(LuaFFITest, bool_return_value_should_be_lua_boolean)
+    {
+        flag = true;
+        run("assert(tes3mp.IsFlagSet() == true)");
+        flag = false;
+        run("assert(tes3mp.IsFlagSet() == false)");
+    }
+}
@@ -0,0 +1,81 @@
+#include <components/resource/objectcache.hpp>
+
+#include <osg/Object>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace
+{
+    using namespace testing;
+
+    struct TestObject : osg::Object
+    {
+        TestObject() = default;
+        TestObject(const TestObject& copy, const osg::CopyOp& copyop) : osg::Object(copy, copyop) {}
+
+        META_Object(ResourceTest, TestObject)
+    };
+
+    struct ResourceObjectCacheTest : Test
+    {
+        osg::ref_ptr<Resource::ObjectCache> mCache = new Resource::ObjectCache;
+    };
+
+    TEST_F(ResourceObjectCacheTest, memory_usage_should_follow_added_replaced_and_removed_objects)
+    {
+        mCache->addEntryToObjectCache("a", new TestObject, 0.0, 100);
+        mCache->addEntryToObjectCache("b", new TestObject, 0.0, 50);
+        EXPECT_EQ(mCache->getCacheMemoryUsage(), 150u);
+
+        mCache->addEntryToObjectCache("a", new TestObject, 0.0, 10);
+        EXPECT_EQ(mCache->getCacheMemoryUsage(), 60u);
+
+        mCache->removeFromObjectCache("b");
+        EXPECT_EQ(mCache->getCacheMemoryUsage(), 10u);
+
+        mCache->removeExpiredObjectsInCache(1.0);
+        EXPECT_EQ(mCache->getCacheMemoryUsage(), 0u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, get_should_count_hits_and_misses)
+    {
+        mCache->addEntryToObjectCache("a", new TestObject, 0.0, 1);
+        EXPECT_TRUE(mCache->getRefFromObjectCache("a"));
+        EXPECT_TRUE(mCache->getRefFromObjectCache("a"));
+        EXPECT_FALSE(mCache->getRefFromObjectCache("b"));
+
+        const Resource::CacheStats stats = mCache->getStats();
+        EXPECT_EQ(stats.mHits, 2u);
+        EXPECT_EQ(stats.mMisses, 1u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, unreferenced_entries_should_leave_out_objects_in_use_and_without_time_stamp)
+    {
+        osg::ref_ptr<TestObject> used = new TestObject;
+        mCache->addEntryToObjectCache("used", used, 1.0, 1);
+        mCache->addEntryToObjectCache("new", new TestObject, 0.0, 2);
+        mCache->addEntryToObjectCache("unused", new TestObject, 2.0, 3);
+
+        std::vector<Resource::CacheEntryUsage> entries;
+        mCache->getUnreferencedEntries(entries);
+        EXPECT_EQ(entries, (std::vector<Resource::CacheEntryUsage> {{2.0, 3}}));
+    }
+
+    TEST_F(ResourceObjectCacheTest, evict_should_remove_unused_objects_used_no_later_than_the_given_time)
+    {
+        osg::ref_ptr<TestObject> used = new TestObject;
+        mCache->addEntryToObjectCache("used", used, 1.0, 1);
+        mCache->addEntryToObjectCache("old", new TestObject, 1.0, 10);
+        mCache->addEntryToObjectCache("recent", new TestObject, 3.0, 100);
+
+        mCache->evictUnreferencedObjectsInCache(2.0);
+
+        EXPECT_TRUE(mCache->checkInObjectCache("used", 4.0));
+        EXPECT_FALSE(mCache->checkInObjectCache("old", 4.0));
+        EXPECT_TRUE(mCache->checkInObjectCache("recent", 4.0));
+        EXPECT_EQ(mCache->getCacheMemoryUsage(), 101u);
+        EXPECT_EQ(mCache->getStats().mEvictions, 1u);
+    }
+}
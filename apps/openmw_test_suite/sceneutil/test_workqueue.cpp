@@ -0,0 +1,132 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using SceneUtil::WorkItem;
+    using SceneUtil::WorkQueue;
+
+    struct History
+    {
+        std::mutex mMutex;
+        std::vector<std::string> mNames;
+
+        void add(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mNames.push_back(name);
+        }
+    };
+
+    struct NamedItem : WorkItem
+    {
+        History& mHistory;
+        std::string mName;
+
+        NamedItem(History& history, const std::string& name) : mHistory(history), mName(name) {}
+
+        void doWork() override { mHistory.add(mName); }
+    };
+
+    struct BlockingItem : WorkItem
+    {
+        std::promise<void> mStarted;
+        std::shared_future<void> mRelease;
+
+        explicit BlockingItem(std::shared_future<void> release) : mRelease(std::move(release)) {}
+
+        void doWork() override
+        {
+            mStarted.set_value();
+            mRelease.wait();
+        }
+    };
+
+    struct AddingItem : WorkItem
+    {
+        WorkQueue& mQueue;
+        osg::ref_ptr<WorkItem> mItem;
+
+        AddingItem(WorkQueue& queue, osg::ref_ptr<WorkItem> item) : mQueue(queue), mItem(std::move(item)) {}
+
+        void doWork() override { mQueue.addWorkItem(mItem); }
+    };
+
+    TEST(SceneUtilWorkQueueTest, should_do_all_added_items)
+    {
+        History history;
+        osg::ref_ptr<WorkQueue> queue = new WorkQueue(4);
+        std::vector<osg::ref_ptr<WorkItem>> items;
+        for (int i = 0; i < 100; ++i)
+        {
+            items.push_back(new NamedItem(history, std::to_string(i)));
+            queue->addWorkItem(items.back());
+        }
+        for (const auto& item : items)
+            item->waitTillDone();
+        EXPECT_EQ(history.mNames.size(), 100u);
+    }
+
+    TEST(SceneUtilWorkQueueTest, should_take_higher_priority_items_first)
+    {
+        History history;
+        osg::ref_ptr<WorkQueue> queue = new WorkQueue(1);
+        std::promise<void> release;
+        osg::ref_ptr<BlockingItem> blocking = new BlockingItem(release.get_future().share());
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        osg::ref_ptr<WorkItem> low = new NamedItem(history, "low");
+        osg::ref_ptr<WorkItem> normal = new NamedItem(history, "normal");
+        osg::ref_ptr<WorkItem> high = new NamedItem(history, "high");
+        queue->addWorkItem(low, WorkQueue::Priority::Low);
+        queue->addWorkItem(normal);
+        queue->addWorkItem(high, true);
+        EXPECT_EQ(queue->getNumItems(), 3u);
+
+        release.set_value();
+        low->waitTillDone();
+        EXPECT_EQ(history.mNames, (std::vector<std::string> {"high", "normal", "low"}));
+    }
+
+    TEST(SceneUtilWorkQueueTest, should_drop_cancelled_items_and_signal_them_done)
+    {
+        History history;
+        osg::ref_ptr<WorkQueue> queue = new WorkQueue(1);
+        std::promise<void> release;
+        osg::ref_ptr<BlockingItem> blocking = new BlockingItem(release.get_future().share());
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        osg::ref_ptr<WorkItem> cancelled = new NamedItem(history, "cancelled");
+        osg::ref_ptr<WorkItem> kept = new NamedItem(history, "kept");
+        queue->addWorkItem(cancelled);
+        queue->addWorkItem(kept);
+        cancelled->cancel();
+
+        release.set_value();
+        cancelled->waitTillDone();
+        kept->waitTillDone();
+        EXPECT_TRUE(cancelled->isCancelled());
+        EXPECT_EQ(history.mNames, std::vector<std::string> {"kept"});
+    }
+
+    TEST(SceneUtilWorkQueueTest, should_do_items_added_by_work_threads)
+    {
+        History history;
+        osg::ref_ptr<WorkQueue> queue = new WorkQueue(2);
+        osg::ref_ptr<WorkItem> nested = new NamedItem(history, "nested");
+        osg::ref_ptr<WorkItem> adding = new AddingItem(*queue, nested);
+        queue->addWorkItem(adding);
+        adding->waitTillDone();
+        nested->waitTillDone();
+        EXPECT_EQ(history.mNames, std::vector<std::string> {"nested"});
+    }
+}
@@ -0,0 +1,145 @@
+#include <components/vfs/archive.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+
+    struct TestFile : VFS::File
+    {
+        std::string mContent;
+        int mPrefetched = 0;
+
+        explicit TestFile(const std::string& content) : mContent(content) {}
+
+        Files::IStreamPtr open() override
+        {
+            return std::make_shared<std::istringstream>(mContent);
+        }
+
+        void prefetch() override
+        {
+            ++mPrefetched;
+        }
+    };
+
+    struct TestArchive : VFS::Archive
+    {
+        std::map<std::string, TestFile> mFiles;
+
+        void listResources(std::map<std::string, VFS::File*>& out, char (*normalize_function) (char)) override
+        {
+            for (auto& [name, file] : mFiles)
+            {
+                std::string normalized = name;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize_function);
+                out[normalized] = &file;
+            }
+        }
+
+        bool contains(const std::string& file, char (*normalize_function) (char)) const override
+        {
+            for (const auto& [name, value] : mFiles)
+            {
+                std::string normalized = name;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize_function);
+                if (normalized == file)
+                    return true;
+            }
+            return false;
+        }
+
+        std::string getDescription() const override
+        {
+            return "TestArchive";
+        }
+    };
+
+    std::string read(const Files::IStreamPtr& stream)
+    {
+        std::ostringstream result;
+        result << stream->rdbuf();
+        return result.str();
+    }
+
+    struct VFSManagerTest : Test
+    {
+        VFS::Manager mManager {false};
+        TestArchive* mFirst;
+        TestArchive* mSecond;
+
+        VFSManagerTest()
+        {
+            auto first = mFirst = new TestArchive;
+            first->mFiles.emplace("Meshes\\Base_Anim.nif", TestFile("first"));
+            first->mFiles.emplace("textures/tx_a.dds", TestFile("a"));
+            auto second = mSecond = new TestArchive;
+            second->mFiles.emplace("meshes/base_anim.nif", TestFile("second"));
+            for (int i = 0; i < 1000; ++i)
+                second->mFiles.emplace("textures/tx_" + std::to_string(i) + ".dds", TestFile(std::to_string(i)));
+
+            mManager.addArchive(first);
+            mManager.addArchive(second);
+            mManager.buildIndex();
+        }
+    };
+
+    TEST_F(VFSManagerTest, exists_should_normalize_the_name)
+    {
+        EXPECT_TRUE(mManager.exists("meshes/base_anim.nif"));
+        EXPECT_TRUE(mManager.exists("MESHES\\BASE_ANIM.NIF"));
+        EXPECT_TRUE(mManager.exists("Textures\\TX_999.dds"));
+        EXPECT_FALSE(mManager.exists("meshes/base_anim"));
+        EXPECT_FALSE(mManager.exists("meshes/base_anim.nif.nif"));
+        EXPECT_FALSE(mManager.exists(""));
+    }
+
+    TEST_F(VFSManagerTest, get_should_prefer_the_last_added_archive)
+    {
+        EXPECT_EQ(read(mManager.get("Meshes\\Base_Anim.nif")), "second");
+        EXPECT_EQ(read(mManager.getNormalized("meshes/base_anim.nif")), "second");
+    }
+
+    TEST_F(VFSManagerTest, get_should_find_every_indexed_file)
+    {
+        for (int i = 0; i < 1000; ++i)
+            EXPECT_EQ(read(mManager.get("TEXTURES/TX_" + std::to_string(i) + ".DDS")), std::to_string(i));
+        EXPECT_EQ(read(mManager.get("textures\\tx_a.dds")), "a");
+    }
+
+    TEST_F(VFSManagerTest, get_should_throw_for_missing_files)
+    {
+        EXPECT_THROW(mManager.get("meshes/missing.nif"), std::runtime_error);
+        EXPECT_THROW(mManager.getNormalized("Meshes/Base_Anim.nif"), std::runtime_error);
+    }
+
+    TEST_F(VFSManagerTest, index_should_stay_sorted_for_prefix_lookups)
+    {
+        const std::map<std::string, VFS::File*>& index = mManager.getIndex();
+        EXPECT_EQ(index.size(), 1002u);
+        auto it = index.lower_bound("meshes/");
+        ASSERT_NE(it, index.end());
+        EXPECT_EQ(it->first, "meshes/base_anim.nif");
+    }
+
+    TEST_F(VFSManagerTest, prefetch_should_prepare_the_files_that_would_be_opened)
+    {
+        mManager.prefetch({"Meshes\\Base_Anim.nif", "meshes/missing.nif", "textures/tx_1.dds"});
+        EXPECT_EQ(mFirst->mFiles.at("Meshes\\Base_Anim.nif").mPrefetched, 0);
+        EXPECT_EQ(mSecond->mFiles.at("meshes/base_anim.nif").mPrefetched, 1);
+        EXPECT_EQ(mSecond->mFiles.at("textures/tx_1.dds").mPrefetched, 1);
+        EXPECT_EQ(mSecond->mFiles.at("textures/tx_2.dds").mPrefetched, 0);
+    }
+
+    TEST_F(VFSManagerTest, reset_should_clear_the_index)
+    {
+        mManager.reset();
+        EXPECT_FALSE(mManager.exists("meshes/base_anim.nif"));
+        EXPECT_THROW(mManager.get("meshes/base_anim.nif"), std::runtime_error);
+    }
+}
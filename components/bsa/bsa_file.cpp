@@ -29,8 +29,34 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <components/misc/hash.hpp>
+
 using namespace Bsa;
 
+namespace
+{
+    uint64_t hashName(const char* name)
+    {
+        uint64_t hash = Misc::hashFnv1a(nullptr, 0);
+        for (; *name != '\0'; ++name)
+        {
+            const char ch = Misc::StringUtils::toLower(*name);
+            hash = Misc::hashFnv1a(&ch, 1, hash);
+        }
+        return hash;
+    }
+
+    bool equalNames(const char* left, const char* right)
+    {
+        for (; *left != '\0'; ++left, ++right)
+        {
+            if (Misc::StringUtils::toLower(*left) != Misc::StringUtils::toLower(*right))
+                return false;
+        }
+        return *right == '\0';
+    }
+}
+
 
 /// Error handling
 void BSAFile::fail(const std::string &msg)
@@ -189,12 +215,10 @@ void BSAFile::readHeader()
         return left.offset < right.offset;
     });
 
+    // Add the file names to the lookup
+    mLookup.reserve(filenum);
     for (size_t i = 0; i < filenum; i++)
-    {
-        FileStruct& fs = mFiles[i];
-        // Add the file name to the lookup
-        mLookup[fs.name()] = i;
-    }
+        addToLookup(i);
 
     mIsLoaded = true;
 }
@@ -237,14 +261,25 @@ void Bsa::BSAFile::writeHeader()
     output.write(reinterpret_cast<char*>(hashes.data()), sizeof(Hash)*hashes.size());
 }
 
+void BSAFile::addToLookup(size_t index)
+{
+    const char* name = mFiles[index].name();
+    mLookup.insert(hashName(name), static_cast<uint32_t>(index), [&] (uint32_t other)
+    {
+        return equalNames(name, mFiles[other].name());
+    });
+}
+
 /// Get the index of a given file name, or -1 if not found
 int BSAFile::getIndex(const char *str) const
 {
-    auto it = mLookup.find(str);
-    if(it == mLookup.end())
+    uint32_t res = mLookup.find(hashName(str), [&] (uint32_t index)
+    {
+        return equalNames(str, mFiles[index].name());
+    });
+    if(res == Misc::HashIndex::sNotFound)
         return -1;
 
-    size_t res = it->second;
     assert(res < mFiles.size());
     return static_cast<int>(res);
 }
@@ -343,7 +378,7 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
 
     mHasChanged = true;
 
-    mLookup[filename.c_str()] = mFiles.size() - 1;
+    addToLookup(mFiles.size() - 1);
 
     stream.seekp(0, std::ios::end);
     file.seekg(0, std::ios::beg);
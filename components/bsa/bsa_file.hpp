@@ -29,6 +29,7 @@
 #include <vector>
 #include <map>
 
+#include <components/misc/hashindex.hpp>
 #include <components/misc/stringops.hpp>
 
 #include <components/files/constrainedfilestream.hpp>
@@ -91,19 +92,14 @@ protected:
     /// Used for error messages
     std::string mFilename;
 
-    /// Case insensitive string comparison
-    struct iltstr
-    {
-        bool operator()(const std::string& s1, const std::string& s2) const
-        { return Misc::StringUtils::ciLess(s1, s2); }
-    };
-
-    /** A map used for fast file name lookup. The value is the index into
-        the files[] vector above. The iltstr ensures that file name
-        checks are case insensitive.
+    /** A hash table used for fast file name lookup. The value is the index
+        into the files[] vector above. File names are hashed and compared
+        case insensitively.
     */
-    typedef std::map<std::string, size_t, iltstr> Lookup;
-    Lookup mLookup;
+    Misc::HashIndex mLookup;
+
+    /// Add a file to the lookup, replacing the entry of any file with the same name
+    void addToLookup(size_t index);
 
     /// Error handling
     void fail(const std::string &msg);
@@ -156,6 +152,12 @@ public:
     */
     virtual Files::IStreamPtr getFile(const FileStruct* file);
 
+    /** Prepare a file, so that opening it later is cheap. Does nothing
+        for archives that store files uncompressed.
+     * @note Thread safe.
+    */
+    virtual void prefetch(const FileStruct*) {}
+
     virtual void addFile(const std::string& filename, std::istream& file);
 
     /// Get a list of all files
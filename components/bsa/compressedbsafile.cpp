@@ -26,6 +26,10 @@
 
 #include <stdexcept>
 #include <cassert>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
 
 #include <lz4frame.h>
 
@@ -47,6 +51,7 @@
 
 #include <boost/iostreams/device/array.hpp>
 #include <components/bsa/memorystream.hpp>
+#include <components/files/memorystream.hpp>
 
 namespace Bsa
 {
@@ -57,6 +62,63 @@ const uint32_t CompressedBSAFile::sInvalidOffset = std::numeric_limits<uint32_t>
 //bit marking compression on file size
 const uint32_t CompressedBSAFile::sCompressedFlag = 1u << 30u;
 
+namespace
+{
+    typedef std::shared_ptr<const std::vector<char> > Blob;
+
+    // Decompressed files of all compressed archives, so that a single budget covers them together
+    struct DecompressedCache
+    {
+        // Archive and offset of a file in it
+        typedef std::pair<const CompressedBSAFile*, std::uint32_t> Key;
+
+        struct Entry
+        {
+            std::shared_future<Blob> mBlob;
+            std::size_t mSize = 0;
+            std::list<Key>::iterator mUse; // mUse.end() of the cache while being inflated
+        };
+
+        std::map<Key, Entry> mEntries;
+        // Keys of the decompressed files in mEntries, most recently used first
+        std::list<Key> mUse;
+        std::size_t mSize = 0;
+        std::size_t mBudget = 64u << 20u;
+        std::mutex mMutex;
+
+        void trim()
+        {
+            // Files that are still being inflated are not in mUse and stay
+            while (mSize > mBudget && !mUse.empty())
+            {
+                auto entry = mEntries.find(mUse.back());
+                mSize -= entry->second.mSize;
+                mEntries.erase(entry);
+                mUse.pop_back();
+            }
+        }
+    };
+
+    DecompressedCache& getDecompressedCache()
+    {
+        static DecompressedCache cache;
+        return cache;
+    }
+
+    // Reads a decompressed file straight from its cached blob, which it keeps alive
+    struct BlobStream
+    {
+        Blob mBlob;
+        Files::IMemStream mStream;
+
+        explicit BlobStream(Blob blob)
+            : mBlob(std::move(blob))
+            , mStream(mBlob->data(), mBlob->size())
+        {
+        }
+    };
+}
+
 
 CompressedBSAFile::FileRecord::FileRecord() : size(0), offset(sInvalidOffset)
 { }
@@ -111,7 +173,22 @@ CompressedBSAFile::CompressedBSAFile()
     : mCompressedByDefault(false), mEmbeddedFileNames(false)
 { }
 
-CompressedBSAFile::~CompressedBSAFile() = default;
+CompressedBSAFile::~CompressedBSAFile()
+{
+    DecompressedCache& cache = getDecompressedCache();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+
+    auto it = cache.mEntries.lower_bound(DecompressedCache::Key(this, 0));
+    while (it != cache.mEntries.end() && it->first.first == this)
+    {
+        if (it->second.mUse != cache.mUse.end())
+        {
+            cache.mSize -= it->second.mSize;
+            cache.mUse.erase(it->second.mUse);
+        }
+        it = cache.mEntries.erase(it);
+    }
+}
 
 /// Read header information from the input source
 void CompressedBSAFile::readHeader()
@@ -286,7 +363,7 @@ void CompressedBSAFile::readHeader()
 
         mFiles[fileIndex].setNameInfos(mStringBuffOffset, &mStringBuf);
 
-        mLookup[reinterpret_cast<char*>(mStringBuf.data() + mStringBuffOffset)] = fileIndex;
+        addToLookup(fileIndex);
         mStringBuffOffset += stringLength + 1u;
     }
 
@@ -350,11 +427,99 @@ Files::IStreamPtr CompressedBSAFile::getFile(const char* file)
     return getFile(fileRec);
 }
 
+void CompressedBSAFile::prefetch(const FileStruct* file)
+{
+    FileRecord fileRec = getFileRecord(file->name());
+    if (fileRec.isValid() && fileRec.isCompressed(mCompressedByDefault))
+        getDecompressed(fileRec);
+}
+
+void CompressedBSAFile::setCacheBudget(std::size_t bytes)
+{
+    DecompressedCache& cache = getDecompressedCache();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+    cache.mBudget = bytes;
+    cache.trim();
+}
+
+std::size_t CompressedBSAFile::getCacheBudget()
+{
+    DecompressedCache& cache = getDecompressedCache();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+    return cache.mBudget;
+}
+
+std::size_t CompressedBSAFile::getCacheSize()
+{
+    DecompressedCache& cache = getDecompressedCache();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+    return cache.mSize;
+}
+
+CompressedBSAFile::Blob CompressedBSAFile::getDecompressed(const FileRecord& fileRecord)
+{
+    DecompressedCache& cache = getDecompressedCache();
+    const DecompressedCache::Key key(this, fileRecord.offset);
+
+    std::promise<Blob> promise;
+    std::shared_future<Blob> cached;
+    {
+        std::lock_guard<std::mutex> lock(cache.mMutex);
+        auto found = cache.mEntries.find(key);
+        if (found != cache.mEntries.end())
+        {
+            if (found->second.mUse != cache.mUse.end())
+                cache.mUse.splice(cache.mUse.begin(), cache.mUse, found->second.mUse);
+            cached = found->second.mBlob;
+        }
+        else
+        {
+            DecompressedCache::Entry& entry = cache.mEntries[key];
+            entry.mBlob = promise.get_future().share();
+            entry.mUse = cache.mUse.end();
+        }
+    }
+
+    if (cached.valid())
+        return cached.get();
+
+    Blob blob;
+    try
+    {
+        blob = decompress(fileRecord);
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(cache.mMutex);
+            cache.mEntries.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cache.mMutex);
+        DecompressedCache::Entry& entry = cache.mEntries[key];
+        entry.mSize = blob->size();
+        entry.mUse = cache.mUse.insert(cache.mUse.begin(), key);
+        cache.mSize += entry.mSize;
+        cache.trim();
+    }
+    promise.set_value(blob);
+    return blob;
+}
+
 Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
 {
+    if (fileRecord.isCompressed(mCompressedByDefault))
+    {
+        // Read from the cached file itself instead of a copy of it
+        auto stream = std::make_shared<BlobStream>(getDecompressed(fileRecord));
+        return Files::IStreamPtr(stream, &stream->mStream);
+    }
+
     size_t size = fileRecord.getSizeWithoutCompressionFlag();
-    size_t uncompressedSize = size;
-    bool compressed = fileRecord.isCompressed(mCompressedByDefault);
     Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, size);
     std::istream* fileStream = streamPtr.get();
     if (mEmbeddedFileNames)
@@ -365,45 +530,56 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
         fileStream->ignore(length);
         size -= length + sizeof(char);
     }
-    if (compressed)
+    std::shared_ptr<Bsa::MemoryInputStream> memoryStreamPtr = std::make_shared<MemoryInputStream>(size);
+    fileStream->read(memoryStreamPtr->getRawData(), size);
+
+    return std::shared_ptr<std::istream>(memoryStreamPtr, (std::istream*)memoryStreamPtr.get());
+}
+
+CompressedBSAFile::Blob CompressedBSAFile::decompress(const FileRecord& fileRecord)
+{
+    size_t size = fileRecord.getSizeWithoutCompressionFlag();
+    size_t uncompressedSize = 0;
+    Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, size);
+    std::istream* fileStream = streamPtr.get();
+    if (mEmbeddedFileNames)
     {
-        fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
-        size -= sizeof(uint32_t);
+        // Skip over the embedded file name
+        char length = 0;
+        fileStream->read(&length, 1);
+        fileStream->ignore(length);
+        size -= length + sizeof(char);
     }
-    std::shared_ptr<Bsa::MemoryInputStream> memoryStreamPtr = std::make_shared<MemoryInputStream>(uncompressedSize);
+    fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
+    size -= sizeof(uint32_t);
 
-    if (compressed)
+    std::shared_ptr<std::vector<char> > data = std::make_shared<std::vector<char> >(uncompressedSize);
+
+    if (mVersion != 0x69) // Non-SSE: zlib
     {
-        if (mVersion != 0x69) // Non-SSE: zlib
-        {
-            boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
-            inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-            inputStreamBuf.push(*fileStream);
+        boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
+        inputStreamBuf.push(boost::iostreams::zlib_decompressor());
+        inputStreamBuf.push(*fileStream);
 
-            boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), uncompressedSize);
-            boost::iostreams::copy(inputStreamBuf, sr);
-        }
-        else // SSE: lz4
-        {
-            boost::scoped_array<char> buffer(new char[size]);
-            fileStream->read(buffer.get(), size);
-            LZ4F_decompressionContext_t context = nullptr;
-            LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
-            LZ4F_decompressOptions_t options = {};
-            LZ4F_errorCode_t errorCode = LZ4F_decompress(context, memoryStreamPtr->getRawData(), &uncompressedSize, buffer.get(), &size, &options);
-            if (LZ4F_isError(errorCode))
-                fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
-            errorCode = LZ4F_freeDecompressionContext(context);
-            if (LZ4F_isError(errorCode))
-                fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
-        }
+        boost::iostreams::basic_array_sink<char> sr(data->data(), uncompressedSize);
+        boost::iostreams::copy(inputStreamBuf, sr);
     }
-    else
+    else // SSE: lz4
     {
-        fileStream->read(memoryStreamPtr->getRawData(), size);
+        boost::scoped_array<char> buffer(new char[size]);
+        fileStream->read(buffer.get(), size);
+        LZ4F_decompressionContext_t context = nullptr;
+        LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+        LZ4F_decompressOptions_t options = {};
+        LZ4F_errorCode_t errorCode = LZ4F_decompress(context, data->data(), &uncompressedSize, buffer.get(), &size, &options);
+        if (LZ4F_isError(errorCode))
+            fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
+        errorCode = LZ4F_freeDecompressionContext(context);
+        if (LZ4F_isError(errorCode))
+            fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
     }
 
-    return std::shared_ptr<std::istream>(memoryStreamPtr, (std::istream*)memoryStreamPtr.get());
+    return data;
 }
 
 BsaVersion CompressedBSAFile::detectVersion(std::string filePath)
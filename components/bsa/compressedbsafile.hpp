@@ -28,6 +28,8 @@
 
 #include <components/bsa/bsa_file.hpp>
 
+#include <memory>
+
 namespace Bsa
 {
     enum BsaVersion
@@ -82,10 +84,29 @@ namespace Bsa
         /// \brief Normalizes given filename or folder and generates format-compatible hash. See https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
         static std::uint64_t generateHash(std::string stem, std::string extension) ;
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+
+        typedef std::shared_ptr<const std::vector<char> > Blob;
+
+        /// Inflate a compressed file
+        Blob decompress(const FileRecord& fileRecord);
+        /// Inflate a compressed file or take it from the cache. If another thread is already
+        /// inflating the same file this waits for its result.
+        Blob getDecompressed(const FileRecord& fileRecord);
+
     public:
         CompressedBSAFile();
         virtual ~CompressedBSAFile();
 
+        /// Set the number of bytes of decompressed files that all compressed archives together keep
+        /// around for repeated requests
+        /// @note Thread safe.
+        static void setCacheBudget(std::size_t bytes);
+        /// @note Thread safe.
+        static std::size_t getCacheBudget();
+        /// Number of bytes of decompressed files currently kept by all compressed archives
+        /// @note Thread safe.
+        static std::size_t getCacheSize();
+
         //checks version of BSA from file header
         static BsaVersion detectVersion(std::string filePath);
 
@@ -94,6 +115,9 @@ namespace Bsa
        
         Files::IStreamPtr getFile(const char* filePath) override;
         Files::IStreamPtr getFile(const FileStruct* fileStruct) override;
+        /// Decompress the file into the cache, so that a later getFile() does not have to
+        /// @note Thread safe.
+        void prefetch(const FileStruct* fileStruct) override;
         void addFile(const std::string& filename, std::istream& file) override;
     };
 }
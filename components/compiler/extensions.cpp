@@ -3,6 +3,8 @@
 #include <cassert>
 #include <stdexcept>
 
+#include <components/misc/hash.hpp>
+
 #include "generator.hpp"
 #include "literals.hpp"
 
@@ -207,4 +209,42 @@ namespace Compiler
         for (const auto & mKeyword : mKeywords)
             keywords.push_back (mKeyword.first);
     }
+
+    std::uint64_t Extensions::getFingerprint() const
+    {
+        std::uint64_t hash = Misc::hashFnv1a (nullptr, 0);
+
+        auto hashValue = [&hash] (int value) { hash = Misc::hashFnv1a (&value, sizeof (value), hash); };
+        auto hashString = [&hash] (const std::string& value)
+        {
+            hash = Misc::hashFnv1a (value.data(), value.size() + 1, hash);
+        };
+
+        for (const auto& keyword : mKeywords)
+        {
+            hashString (keyword.first);
+            hashValue (keyword.second);
+        }
+
+        for (const auto& function : mFunctions)
+        {
+            hashValue (function.first);
+            hashValue (function.second.mReturn);
+            hashString (function.second.mArguments);
+            hashValue (function.second.mCode);
+            hashValue (function.second.mCodeExplicit);
+            hashValue (function.second.mSegment);
+        }
+
+        for (const auto& instruction : mInstructions)
+        {
+            hashValue (instruction.first);
+            hashString (instruction.second.mArguments);
+            hashValue (instruction.second.mCode);
+            hashValue (instruction.second.mCodeExplicit);
+            hashValue (instruction.second.mSegment);
+        }
+
+        return hash;
+    }
 }
@@ -24,6 +24,22 @@ namespace
         return std::abs(lhs.x() - rhs.x()) + std::abs(lhs.y() - rhs.y());
     }
 
+    // About 30 degrees between unit vectors
+    const float sMaxUnrankedTurn2 = 0.27f;
+
+    int getDistanceToPlayer(const TilePosition& tile, const TilePosition& playerTile, const osg::Vec2f& direction)
+    {
+        const int distance = getManhattanDistance(tile, playerTile);
+        // Neighbouring tiles are needed right away whichever way the player turns,
+        // further ones behind the player are needed later than the ones in front
+        if (distance <= 1)
+            return distance;
+        const osg::Vec2f offset(tile.x() - playerTile.x(), tile.y() - playerTile.y());
+        if (offset * direction < 0)
+            return distance + distance / 2;
+        return distance;
+    }
+
     int getMinDistanceTo(const TilePosition& position, int maxDistance,
                          const std::map<osg::Vec3f, std::set<TilePosition>>& tilesPerHalfExtents,
                          const std::set<std::tuple<osg::Vec3f, TilePosition>>& presentTiles)
@@ -73,6 +89,9 @@ namespace DetourNavigator
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
     {
+        if (!settings.mNavMeshDbPath.empty() && settings.mMaxNavMeshDbSize > 0)
+            mNavMeshDb = std::make_unique<NavMeshDb>(settings.mNavMeshDbPath, settings.mMaxNavMeshDbSize, settings);
+
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
             mThreads.emplace_back([&] { process(); });
     }
@@ -104,9 +123,8 @@ namespace DetourNavigator
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
-        if (playerTileChanged)
-            for (auto& job : mJobs)
-                job.mDistanceToPlayer = getManhattanDistance(job.mChangedTile, playerTile);
+        mPlayerView.mTile = playerTile;
+        const auto now = std::chrono::steady_clock::now();
 
         for (const auto& changedTile : changedTiles)
         {
@@ -119,11 +137,12 @@ namespace DetourNavigator
                 job.mChangedTile = changedTile.first;
                 job.mTryNumber = 0;
                 job.mChangeType = changedTile.second;
-                job.mDistanceToPlayer = getManhattanDistance(changedTile.first, playerTile);
+                job.mDistanceToPlayer = getDistanceToPlayer(changedTile.first, playerTile, mPlayerView.mDirection);
                 job.mDistanceToOrigin = getManhattanDistance(changedTile.first, TilePosition {0, 0});
                 job.mProcessTime = job.mChangeType == ChangeType::update
                     ? mLastUpdates[job.mAgentHalfExtents][job.mChangedTile] + mSettings.get().mMinUpdateInterval
                     : std::chrono::steady_clock::time_point();
+                job.mPostTime = now;
 
                 if (playerTileChanged)
                 {
@@ -138,7 +157,7 @@ namespace DetourNavigator
         }
 
         if (playerTileChanged)
-            std::sort(mJobs.begin(), mJobs.end());
+            rankJobs();
 
         Log(Debug::Debug) << "Posted " << mJobs.size() << " navigator jobs";
 
@@ -146,6 +165,66 @@ namespace DetourNavigator
             mHasJob.notify_all();
     }
 
+    void AsyncNavMeshUpdater::setPlayerView(const TilePosition& playerTile, const osg::Vec2f& direction)
+    {
+        osg::Vec2f normalizedDirection = direction;
+        normalizedDirection.normalize();
+
+        bool playerTileChanged = false;
+        {
+            auto locked = mPlayerTile.lock();
+            playerTileChanged = *locked != playerTile;
+            *locked = playerTile;
+        }
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        mPlayerView = PlayerView {playerTile, normalizedDirection};
+
+        // Turning a little does not change which tiles are in front of the player enough to reorder all jobs
+        if (!playerTileChanged && (normalizedDirection - mRankedDirection).length2() < sMaxUnrankedTurn2)
+            return;
+
+        rankJobs();
+
+        if (!mJobs.empty())
+            mHasJob.notify_all();
+    }
+
+    void AsyncNavMeshUpdater::rankJobs()
+    {
+        // Navmesh may allow less tiles than the settings, then updateNavMesh ignores some of the remaining jobs
+        const int maxTiles = mSettings.get().mMaxTilesNumber;
+        const auto isObsolete = [&] (const Job& job)
+        {
+            return job.mNavMeshCacheItem.expired()
+                || (job.mChangeType == ChangeType::add && !shouldAddTile(job.mChangedTile, mPlayerView.mTile, maxTiles));
+        };
+
+        Jobs ranked;
+        for (Job& job : mJobs)
+        {
+            if (isObsolete(job))
+            {
+                const auto it = mPushed.find(job.mAgentHalfExtents);
+                it->second.erase(job.mChangedTile);
+                if (it->second.empty())
+                    mPushed.erase(it);
+                ++mCancelledJobs;
+                continue;
+            }
+            job.mDistanceToPlayer = getDistanceToPlayer(job.mChangedTile, mPlayerView.mTile, mPlayerView.mDirection);
+            ranked.push_back(std::move(job));
+        }
+
+        std::sort(ranked.begin(), ranked.end());
+        mJobs = std::move(ranked);
+        mRankedDirection = mPlayerView.mDirection;
+
+        if (mJobs.empty() && getTotalThreadJobsUnsafe() == 0)
+            mDone.notify_all();
+    }
+
     void AsyncNavMeshUpdater::wait(Loading::Listener& listener, WaitConditionType waitConditionType)
     {
         if (mSettings.get().mWaitUntilMinDistanceToPlayer == 0)
@@ -226,15 +305,38 @@ namespace DetourNavigator
     void AsyncNavMeshUpdater::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         std::size_t jobs = 0;
+        std::size_t cancelledJobs = 0;
 
         {
             const std::lock_guard<std::mutex> lock(mMutex);
             jobs = mJobs.size() + getTotalThreadJobsUnsafe();
+            cancelledJobs = mCancelledJobs;
+        }
+
+        Latency latency;
+
+        {
+            const auto locked = mLatency.lock();
+            latency = *locked;
+            *locked = Latency();
         }
 
         stats.setAttribute(frameNumber, "NavMesh UpdateJobs", jobs);
+        stats.setAttribute(frameNumber, "NavMesh CancelledJobs", cancelledJobs);
+
+        if (latency.mJobs > 0)
+        {
+            using FloatMs = std::chrono::duration<double, std::milli>;
+            stats.setAttribute(frameNumber, "NavMesh JobLatency",
+                std::chrono::duration_cast<FloatMs>(latency.mTotal).count() / latency.mJobs);
+            stats.setAttribute(frameNumber, "NavMesh JobMaxLatency",
+                std::chrono::duration_cast<FloatMs>(latency.mMax).count());
+        }
 
         mNavMeshTilesCache.reportStats(frameNumber, stats);
+
+        if (mNavMeshDb)
+            mNavMeshDb->reportStats(frameNumber, stats);
     }
 
     void AsyncNavMeshUpdater::process() noexcept
@@ -272,6 +374,15 @@ namespace DetourNavigator
 
         const auto firstStart = setFirstStart(start);
 
+        const auto latency = start - job.mPostTime;
+
+        {
+            const auto locked = mLatency.lock();
+            locked->mTotal += latency;
+            locked->mMax = std::max(locked->mMax, latency);
+            ++locked->mJobs;
+        }
+
         const auto navMeshCacheItem = job.mNavMeshCacheItem.lock();
 
         if (!navMeshCacheItem)
@@ -282,7 +393,7 @@ namespace DetourNavigator
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
         const auto status = updateNavMesh(job.mAgentHalfExtents, recastMesh.get(), job.mChangedTile, playerTile,
-            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache);
+            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache, mNavMeshDb.get());
 
         if (recastMesh != nullptr)
         {
@@ -321,6 +432,7 @@ namespace DetourNavigator
             " status=" << status <<
             " generation=" << locked->getGeneration() <<
             " revision=" << locked->getNavMeshRevision() <<
+            " latency=" << std::chrono::duration_cast<FloatMs>(latency).count() << "ms" <<
             " time=" << std::chrono::duration_cast<FloatMs>(finish - start).count() << "ms" <<
             " total_time=" << std::chrono::duration_cast<FloatMs>(finish - firstStart).count() << "ms"
             " thread=" << std::this_thread::get_id();
@@ -6,8 +6,10 @@
 #include "tilecachedrecastmeshmanager.hpp"
 #include "tileposition.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdb.hpp"
 #include "waitconditiontype.hpp"
 
+#include <osg/Vec2f>
 #include <osg/Vec3f>
 
 #include <atomic>
@@ -62,6 +64,10 @@ namespace DetourNavigator
         void post(const osg::Vec3f& agentHalfExtents, const SharedNavMeshCacheItem& mNavMeshCacheItem,
             const TilePosition& playerTile, const std::map<TilePosition, ChangeType>& changedTiles);
 
+        /// Reorder queued jobs when the player moves to another tile or turns, and drop the ones adding tiles
+        /// that are too far from the player now
+        void setPlayerView(const TilePosition& playerTile, const osg::Vec2f& direction);
+
         void wait(Loading::Listener& listener, WaitConditionType waitConditionType);
 
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
@@ -77,6 +83,7 @@ namespace DetourNavigator
             int mDistanceToPlayer;
             int mDistanceToOrigin;
             std::chrono::steady_clock::time_point mProcessTime;
+            std::chrono::steady_clock::time_point mPostTime;
 
             std::tuple<std::chrono::steady_clock::time_point, unsigned, ChangeType, int, int> getPriority() const
             {
@@ -100,6 +107,19 @@ namespace DetourNavigator
             Queue() = default;
         };
 
+        struct PlayerView
+        {
+            TilePosition mTile;
+            osg::Vec2f mDirection;
+        };
+
+        struct Latency
+        {
+            std::chrono::steady_clock::duration mTotal {};
+            std::chrono::steady_clock::duration mMax {};
+            std::size_t mJobs = 0;
+        };
+
         std::reference_wrapper<const Settings> mSettings;
         std::reference_wrapper<TileCachedRecastMeshManager> mRecastMeshManager;
         std::reference_wrapper<OffMeshConnectionsManager> mOffMeshConnectionsManager;
@@ -111,8 +131,13 @@ namespace DetourNavigator
         Jobs mJobs;
         std::map<osg::Vec3f, std::set<TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
+        PlayerView mPlayerView {TilePosition(0, 0), osg::Vec2f()}; // guarded by mMutex
+        osg::Vec2f mRankedDirection; // the view direction the jobs were last ordered for
+        std::size_t mCancelledJobs = 0;
+        mutable Misc::ScopeGuarded<Latency> mLatency;
         Misc::ScopeGuarded<std::optional<std::chrono::steady_clock::time_point>> mFirstStart;
         NavMeshTilesCache mNavMeshTilesCache;
+        std::unique_ptr<NavMeshDb> mNavMeshDb;
         Misc::ScopeGuarded<std::map<osg::Vec3f, std::map<TilePosition, std::thread::id>>> mProcessingTiles;
         std::map<osg::Vec3f, std::map<TilePosition, std::chrono::steady_clock::time_point>> mLastUpdates;
         std::set<std::tuple<osg::Vec3f, TilePosition>> mPresentTiles;
@@ -129,6 +154,8 @@ namespace DetourNavigator
 
         void postThreadJob(Job&& job, Queue& queue);
 
+        void rankJobs();
+
         void writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const;
 
         std::chrono::steady_clock::time_point setFirstStart(const std::chrono::steady_clock::time_point& value);
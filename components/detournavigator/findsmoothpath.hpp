@@ -9,6 +9,7 @@
 #include "debug.hpp"
 #include "status.hpp"
 #include "areatype.hpp"
+#include "polygonpathcache.hpp"
 
 #include <DetourCommon.h>
 #include <DetourNavMesh.h>
@@ -253,15 +254,14 @@ namespace DetourNavigator
         return Status::Success;
     }
 
+    /// @param navMeshQuery initialized for navMesh, allows to reuse it for many paths
+    /// @param polygonPathCache polygon paths found over navMesh before, could be null
     template <class OutputIterator>
-    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
-            const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
-            const Settings& settings, OutputIterator& out)
+    Status findSmoothPath(const dtNavMesh& navMesh, const dtNavMeshQuery& navMeshQuery, const osg::Vec3f& halfExtents,
+            const float stepSize, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+            const AreaCosts& areaCosts, const Settings& settings, OutputIterator& out,
+            PolygonPathCache* polygonPathCache = nullptr)
     {
-        dtNavMeshQuery navMeshQuery;
-        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mMaxNavMeshQueryNodes))
-            return Status::InitNavMeshQueryFailed;
-
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
         queryFilter.setAreaCost(AreaType_water, areaCosts.mWater);
@@ -277,11 +277,23 @@ namespace DetourNavigator
         if (endRef == 0)
             return Status::EndPolygonNotFound;
 
-        const auto polygonPath = findPath(navMeshQuery, startRef, endRef, start, end, queryFilter,
-                                          settings.mMaxPolygonPathSize);
+        const PolygonPathKey key = makePolygonPathKey(startRef, endRef, start, end, includeFlags, areaCosts,
+                                                      settings.mCellSize);
+        std::optional<std::vector<dtPolyRef>> polygonPath;
+        if (polygonPathCache != nullptr)
+            polygonPath = polygonPathCache->get(key);
 
         if (!polygonPath)
-            return Status::FindPathOverPolygonsFailed;
+        {
+            polygonPath = findPath(navMeshQuery, startRef, endRef, start, end, queryFilter,
+                                   settings.mMaxPolygonPathSize);
+
+            if (!polygonPath)
+                return Status::FindPathOverPolygonsFailed;
+
+            if (polygonPathCache != nullptr)
+                polygonPathCache->set(key, *polygonPath);
+        }
 
         if (polygonPath->empty() || polygonPath->back() != endRef)
             return Status::Success;
@@ -290,6 +302,19 @@ namespace DetourNavigator
         return makeSmoothPath(navMesh, navMeshQuery, queryFilter, start, end, stepSize, std::move(*polygonPath),
             settings.mMaxSmoothPathSize, outTransform);
     }
+
+    template <class OutputIterator>
+    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
+            const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
+            const Settings& settings, OutputIterator& out, PolygonPathCache* polygonPathCache = nullptr)
+    {
+        dtNavMeshQuery navMeshQuery;
+        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mMaxNavMeshQueryNodes))
+            return Status::InitNavMeshQueryFailed;
+
+        return findSmoothPath(navMesh, navMeshQuery, halfExtents, stepSize, start, end, includeFlags, areaCosts,
+            settings, out, polygonPathCache);
+    }
 }
 
 #endif
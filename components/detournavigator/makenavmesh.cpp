@@ -7,6 +7,7 @@
 #include "sharednavmesh.hpp"
 #include "flags.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdb.hpp"
 
 #include <components/misc/convert.hpp>
 
@@ -481,7 +482,8 @@ namespace DetourNavigator
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache)
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache,
+        NavMeshDb* navMeshDb)
     {
         Log(Debug::Debug) << std::fixed << std::setprecision(2) <<
             "Update NavMesh with multiple tiles:" <<
@@ -527,17 +529,31 @@ namespace DetourNavigator
 
         if (!cachedNavMeshData)
         {
-            const auto tileBounds = makeTileBounds(settings, changedTile);
-            const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
-            const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
-
-            auto navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
-                tileBorderMin, tileBorderMax, settings);
+            // Tiles generated in earlier runs are on disk, only the ones never seen before are built
+            const std::string dbKey = navMeshDb != nullptr
+                ? navMeshDb->makeKey(agentHalfExtents, changedTile, *recastMesh, offMeshConnections) : std::string();
+            NavMeshData navMeshData;
+            if (navMeshDb != nullptr)
+                navMeshData = navMeshDb->get(dbKey);
+            cached = static_cast<bool>(navMeshData.mValue);
 
             if (!navMeshData.mValue)
             {
-                Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
-                return navMeshCacheItem->lock()->removeTile(changedTile);
+                const auto tileBounds = makeTileBounds(settings, changedTile);
+                const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
+                const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
+
+                navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
+                    tileBorderMin, tileBorderMax, settings);
+
+                if (!navMeshData.mValue)
+                {
+                    Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
+                    return navMeshCacheItem->lock()->removeTile(changedTile);
+                }
+
+                if (navMeshDb != nullptr)
+                    navMeshDb->put(dbKey, navMeshData.mValue.get(), navMeshData.mSize);
             }
 
             cachedNavMeshData = navMeshTilesCache.set(agentHalfExtents, changedTile, *recastMesh,
@@ -15,6 +15,7 @@ class dtNavMesh;
 
 namespace DetourNavigator
 {
+    class NavMeshDb;
     class RecastMesh;
     struct Settings;
 
@@ -39,7 +40,8 @@ namespace DetourNavigator
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache);
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache,
+        NavMeshDb* navMeshDb = nullptr);
 }
 
 #endif
@@ -2,6 +2,9 @@
 #include "navigator.hpp"
 #include "raycast.hpp"
 
+#include <future>
+#include <iterator>
+
 namespace DetourNavigator
 {
     std::optional<osg::Vec3f> Navigator::findRandomPointAroundCircle(const osg::Vec3f& agentHalfExtents,
@@ -33,4 +36,62 @@ namespace DetourNavigator
             return {};
         return fromNavMeshCoordinates(settings, *result);
     }
+
+    std::vector<PathResult> Navigator::findPaths(const std::vector<PathRequest>& requests) const
+    {
+        std::vector<PathResult> results(requests.size());
+        std::map<osg::Vec3f, std::vector<std::size_t>> requestsPerAgent;
+        for (std::size_t i = 0; i < requests.size(); ++i)
+            requestsPerAgent[requests[i].mAgentHalfExtents].push_back(i);
+
+        const auto settings = getSettings();
+
+        const auto solve = [&] (const SharedNavMeshCacheItem& navMesh, const std::vector<std::size_t>& indices)
+        {
+            const auto setStatus = [&] (Status status)
+            {
+                for (const std::size_t i : indices)
+                    results[i].mStatus = status;
+            };
+            if (!navMesh)
+                return setStatus(Status::NavMeshNotFound);
+            const auto locked = navMesh->lockConst();
+            dtNavMeshQuery navMeshQuery;
+            if (!initNavMeshQuery(navMeshQuery, locked->getImpl(), settings.mMaxNavMeshQueryNodes))
+                return setStatus(Status::InitNavMeshQueryFailed);
+            for (const std::size_t i : indices)
+            {
+                const PathRequest& request = requests[i];
+                auto out = std::back_inserter(results[i].mPath);
+                results[i].mStatus = findSmoothPath(locked->getImpl(), navMeshQuery,
+                    toNavMeshCoordinates(settings, request.mAgentHalfExtents),
+                    toNavMeshCoordinates(settings, request.mStepSize), toNavMeshCoordinates(settings, request.mStart),
+                    toNavMeshCoordinates(settings, request.mEnd), request.mIncludeFlags, request.mAreaCosts, settings,
+                    out, &locked->getPolygonPathCache());
+            }
+        };
+
+        // Navmeshes are looked up here, workers only lock and query them
+        std::vector<std::future<void>> workers;
+        const std::vector<std::size_t>* first = nullptr;
+        SharedNavMeshCacheItem firstNavMesh;
+        for (const auto& [agentHalfExtents, indices] : requestsPerAgent)
+        {
+            if (first == nullptr)
+            {
+                first = &indices;
+                firstNavMesh = getNavMesh(agentHalfExtents);
+                continue;
+            }
+            workers.push_back(std::async(std::launch::async, solve, getNavMesh(agentHalfExtents), std::cref(indices)));
+        }
+
+        if (first != nullptr)
+            solve(firstNavMesh, *first);
+
+        for (auto& worker : workers)
+            worker.get();
+
+        return results;
+    }
 }
@@ -24,6 +24,22 @@ namespace Loading
 
 namespace DetourNavigator
 {
+    struct PathRequest
+    {
+        osg::Vec3f mAgentHalfExtents;
+        float mStepSize;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+    };
+
+    struct PathResult
+    {
+        Status mStatus = Status::Success;
+        std::vector<osg::Vec3f> mPath;
+    };
+
     struct ObjectShapes
     {
         osg::ref_ptr<const Resource::BulletShapeInstance> mShapeInstance;
@@ -160,6 +176,13 @@ namespace DetourNavigator
          */
         virtual void updatePlayerPosition(const osg::Vec3f& playerPosition) = 0;
 
+        /**
+         * @brief setPlayerView reorders pending navmesh updates to build tiles around the player and in front of them first.
+         * @param playerPosition current player position.
+         * @param direction where the player is looking at, only horizontal part is used.
+         */
+        virtual void setPlayerView(const osg::Vec3f& playerPosition, const osg::Vec3f& direction) = 0;
+
         /**
          * @brief disable navigator updates
          */
@@ -197,11 +220,21 @@ namespace DetourNavigator
             if (!navMesh)
                 return Status::NavMeshNotFound;
             const auto settings = getSettings();
-            return findSmoothPath(navMesh->lockConst()->getImpl(), toNavMeshCoordinates(settings, agentHalfExtents),
+            const auto locked = navMesh->lockConst();
+            return findSmoothPath(locked->getImpl(), toNavMeshCoordinates(settings, agentHalfExtents),
                 toNavMeshCoordinates(settings, stepSize), toNavMeshCoordinates(settings, start),
-                toNavMeshCoordinates(settings, end), includeFlags, areaCosts, settings, out);
+                toNavMeshCoordinates(settings, end), includeFlags, areaCosts, settings, out,
+                &locked->getPolygonPathCache());
         }
 
+        /**
+         * @brief findPaths solves many path requests in one go.
+         * Requests for the same agent half extents share a navmesh lock and a navmesh query,
+         * requests for different agent half extents are solved in parallel.
+         * @return result for each request in the same order, path has the same points as findPath would produce.
+         */
+        std::vector<PathResult> findPaths(const std::vector<PathRequest>& requests) const;
+
         /**
          * @brief getNavMesh returns navmesh for specific agent half extents
          * @return navmesh
@@ -154,6 +154,13 @@ namespace DetourNavigator
         mLastPlayerPosition = tilePosition;
     }
 
+    void NavigatorImpl::setPlayerView(const osg::Vec3f& playerPosition, const osg::Vec3f& direction)
+    {
+        if (!mUpdatesEnabled)
+            return;
+        mNavMeshManager.setPlayerView(playerPosition, direction);
+    }
+
     void NavigatorImpl::setUpdatesEnabled(bool enabled)
     {
         mUpdatesEnabled = enabled;
@@ -47,6 +47,8 @@ namespace DetourNavigator
 
         void updatePlayerPosition(const osg::Vec3f& playerPosition) override;
 
+        void setPlayerView(const osg::Vec3f& playerPosition, const osg::Vec3f& direction) override;
+
         void setUpdatesEnabled(bool enabled) override;
 
         void wait(Loading::Listener& listener, WaitConditionType waitConditionType) override;
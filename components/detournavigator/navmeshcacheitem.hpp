@@ -6,6 +6,7 @@
 #include "navmeshtilescache.hpp"
 #include "dtstatus.hpp"
 #include "navmeshtileview.hpp"
+#include "polygonpathcache.hpp"
 
 #include <components/misc/guarded.hpp>
 
@@ -120,7 +121,7 @@ namespace DetourNavigator
     {
     public:
         NavMeshCacheItem(const NavMeshPtr& impl, std::size_t generation)
-            : mImpl(impl), mGeneration(generation), mNavMeshRevision(0)
+            : mImpl(impl), mGeneration(generation), mNavMeshRevision(0), mPolygonPathCache(sMaxPolygonPathCacheSize)
         {
         }
 
@@ -139,6 +140,12 @@ namespace DetourNavigator
             return mNavMeshRevision;
         }
 
+        /// Guarded by the same lock as the navmesh, so it can be used for path queries over the locked navmesh
+        PolygonPathCache& getPolygonPathCache() const
+        {
+            return mPolygonPathCache;
+        }
+
         template <class T>
         UpdateNavMeshStatus updateTile(const TilePosition& position, T&& navMeshData)
         {
@@ -172,27 +179,33 @@ namespace DetourNavigator
         }
 
     private:
+        static constexpr std::size_t sMaxPolygonPathCacheSize = 1024;
+
         NavMeshPtr mImpl;
         std::size_t mGeneration;
         std::size_t mNavMeshRevision;
         std::map<TilePosition, std::pair<NavMeshTilesCache::Value, NavMeshData>> mUsedTiles;
+        mutable PolygonPathCache mPolygonPathCache;
 
         void setUsedTile(const TilePosition& tilePosition, NavMeshTilesCache::Value value)
         {
             mUsedTiles[tilePosition] = std::make_pair(std::move(value), NavMeshData());
             ++mNavMeshRevision;
+            mPolygonPathCache.clear();
         }
 
         void setUsedTile(const TilePosition& tilePosition, NavMeshData value)
         {
             mUsedTiles[tilePosition] = std::make_pair(NavMeshTilesCache::Value(), std::move(value));
             ++mNavMeshRevision;
+            mPolygonPathCache.clear();
         }
 
         void removeUsedTile(const TilePosition& tilePosition)
         {
             mUsedTiles.erase(tilePosition);
             ++mNavMeshRevision;
+            mPolygonPathCache.clear();
         }
 
         dtStatus addTileImpl(unsigned char* data, int size)
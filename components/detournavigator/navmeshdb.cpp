@@ -0,0 +1,371 @@
+#include "navmeshdb.hpp"
+#include "recastmesh.hpp"
+#include "settings.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/hash.hpp>
+
+#include <DetourAlloc.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        const char sMagic[4] = {'O', 'M', 'N', 'T'};
+        const std::uint32_t sFormatVersion = 2;
+        const char* const sExtension = ".navtile";
+
+        /// Followed by the key and then the tile data
+        struct Header
+        {
+            char mMagic[4];
+            std::uint32_t mVersion;
+            std::uint32_t mKeySize;
+            std::uint32_t mSize;
+        };
+
+        template <class T>
+        void appendValue(std::string& out, const T& value)
+        {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <class T>
+        void appendArray(std::string& out, const std::vector<T>& values)
+        {
+            appendValue(out, static_cast<std::uint64_t>(values.size()));
+            out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+
+        void appendVector(std::string& out, const btVector3& value)
+        {
+            // btVector3 has a fourth padding component that is not always initialized
+            appendValue(out, value.x());
+            appendValue(out, value.y());
+            appendValue(out, value.z());
+        }
+
+        /// Everything in Settings that changes the generated tiles
+        std::string makeSettingsKey(const Settings& settings)
+        {
+            std::string result;
+            for (float value : {settings.mCellHeight, settings.mCellSize, settings.mDetailSampleDist,
+                    settings.mDetailSampleMaxError, settings.mMaxClimb, settings.mMaxSimplificationError,
+                    settings.mMaxSlope, settings.mRecastScaleFactor, settings.mSwimHeightScale})
+                appendValue(result, value);
+            for (int value : {settings.mBorderSize, settings.mMaxEdgeLen, settings.mMaxPolys,
+                    settings.mMaxVertsPerPoly, settings.mRegionMergeSize, settings.mRegionMinSize, settings.mTileSize})
+                appendValue(result, value);
+            return result;
+        }
+    }
+
+    NavMeshDb::NavMeshDb(const boost::filesystem::path& path, std::size_t maxSize, const Settings& settings)
+        : mPath(path)
+        , mMaxSize(maxSize)
+        , mSettingsKey(makeSettingsKey(settings))
+    {
+        scan();
+        mThread = std::thread([this] { run(); });
+    }
+
+    NavMeshDb::~NavMeshDb()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasWork.notify_all();
+        mThread.join();
+    }
+
+    std::string NavMeshDb::makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const
+    {
+        std::string result = mSettingsKey;
+        appendValue(result, agentHalfExtents);
+        appendValue(result, changedTile.x());
+        appendValue(result, changedTile.y());
+        appendArray(result, recastMesh.getIndices());
+        appendArray(result, recastMesh.getVertices());
+        appendArray(result, recastMesh.getAreaTypes());
+        appendValue(result, static_cast<std::uint64_t>(recastMesh.getWater().size()));
+        for (const RecastMesh::Water& water : recastMesh.getWater())
+        {
+            appendValue(result, water.mCellSize);
+            for (int i = 0; i < 3; ++i)
+                appendVector(result, water.mTransform.getBasis()[i]);
+            appendVector(result, water.mTransform.getOrigin());
+        }
+        appendValue(result, static_cast<std::uint64_t>(offMeshConnections.size()));
+        for (const OffMeshConnection& connection : offMeshConnections)
+        {
+            appendValue(result, connection.mStart);
+            appendValue(result, connection.mEnd);
+            appendValue(result, connection.mAreaType);
+        }
+        return result;
+    }
+
+    NavMeshData NavMeshDb::get(const std::string& key)
+    {
+        const std::uint64_t hash = getHash(key);
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            if (mEntries.find(hash) == mEntries.end())
+            {
+                ++mMisses;
+                return NavMeshData();
+            }
+        }
+
+        const boost::filesystem::path path = getTilePath(hash);
+        NavMeshData result;
+
+        try
+        {
+            boost::filesystem::ifstream stream(path, std::ios::binary);
+            Header header;
+            if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+                throw std::runtime_error("truncated header");
+            if (std::memcmp(header.mMagic, sMagic, sizeof(sMagic)) != 0 || header.mVersion != sFormatVersion)
+                throw std::runtime_error("unknown format");
+
+            // A tile built from a different input with the same hash stays for that input until the tile
+            // built for this one replaces it
+            std::string storedKey;
+            if (header.mKeySize == key.size())
+            {
+                storedKey.resize(key.size());
+                if (!stream.read(storedKey.data(), storedKey.size()))
+                    throw std::runtime_error("truncated key");
+            }
+            if (storedKey != key)
+            {
+                const std::lock_guard<std::mutex> lock(mMutex);
+                ++mMisses;
+                return NavMeshData();
+            }
+
+            if (header.mSize == 0)
+                throw std::runtime_error("empty tile");
+
+            if (header.mSize > static_cast<std::uint32_t>(std::numeric_limits<int>::max()))
+                throw std::runtime_error("invalid size");
+
+            result = NavMeshData(static_cast<unsigned char*>(dtAlloc(header.mSize, DT_ALLOC_PERM)),
+                                 static_cast<int>(header.mSize));
+            if (!result.mValue)
+                throw std::runtime_error("out of memory");
+            if (!stream.read(reinterpret_cast<char*>(result.mValue.get()), header.mSize))
+                throw std::runtime_error("truncated data");
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Ignoring navmesh tile " << path << ": " << e.what();
+            const std::lock_guard<std::mutex> lock(mMutex);
+            const auto entry = mEntries.find(hash);
+            if (entry != mEntries.end())
+            {
+                mTotalSize -= entry->second.mSize;
+                mEntries.erase(entry);
+            }
+            ++mMisses;
+            return NavMeshData();
+        }
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        const auto entry = mEntries.find(hash);
+        if (entry != mEntries.end())
+            entry->second.mLastUse = std::time(nullptr);
+        mUsed.push_back(hash);
+        ++mHits;
+        return result;
+    }
+
+    void NavMeshDb::put(const std::string& key, const unsigned char* data, int size)
+    {
+        if (size <= 0 || sizeof(Header) + key.size() + static_cast<std::size_t>(size) > mMaxSize)
+            return;
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mWrites.push_back(Write {getHash(key), key, std::vector<unsigned char>(data, data + size)});
+        }
+        mHasWork.notify_all();
+    }
+
+    NavMeshDb::Stats NavMeshDb::getStats() const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        return Stats {mTotalSize, mEntries.size(), mHits, mMisses, mWritten};
+    }
+
+    void NavMeshDb::reportStats(unsigned int frameNumber, osg::Stats& out) const
+    {
+        const Stats stats = getStats();
+        out.setAttribute(frameNumber, "NavMesh DbSize", stats.mSize);
+        out.setAttribute(frameNumber, "NavMesh DbTiles", stats.mTiles);
+        out.setAttribute(frameNumber, "NavMesh DbWrites", stats.mWrites);
+        if (stats.mHits + stats.mMisses > 0)
+            out.setAttribute(frameNumber, "NavMesh DbHitRate", static_cast<double>(stats.mHits) / (stats.mHits + stats.mMisses) * 100.0);
+    }
+
+    std::uint64_t NavMeshDb::getHash(const std::string& key)
+    {
+        return Misc::hashFnv1a(key.data(), key.size(), Misc::hashFnv1a(&sFormatVersion, sizeof(sFormatVersion)));
+    }
+
+    boost::filesystem::path NavMeshDb::getTilePath(std::uint64_t hash) const
+    {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << hash << sExtension;
+        return mPath / name.str();
+    }
+
+    void NavMeshDb::scan()
+    {
+        boost::system::error_code ec;
+        if (!boost::filesystem::is_directory(mPath, ec))
+            return;
+
+        for (boost::filesystem::directory_iterator it(mPath, ec), end; !ec && it != end; it.increment(ec))
+        {
+            const boost::filesystem::path& path = it->path();
+            boost::system::error_code fileError;
+            if (path.extension() == ".tmp")
+            {
+                // Left behind by a write that did not finish
+                boost::filesystem::remove(path, fileError);
+                continue;
+            }
+            if (path.extension() != sExtension)
+                continue;
+
+            std::uint64_t hash;
+            std::istringstream stem(path.stem().string());
+            if (!(stem >> std::hex >> hash))
+                continue;
+
+            const auto size = boost::filesystem::file_size(path, fileError);
+            const auto lastUse = boost::filesystem::last_write_time(path, fileError);
+            if (fileError)
+                continue;
+
+            mEntries[hash] = Entry {static_cast<std::size_t>(size), lastUse};
+            mTotalSize += static_cast<std::size_t>(size);
+        }
+
+        Log(Debug::Verbose) << "Found " << mEntries.size() << " navmesh tiles (" << mTotalSize << " bytes) in " << mPath;
+    }
+
+    void NavMeshDb::run()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            mHasWork.wait(lock, [&] { return mShouldStop || !mWrites.empty() || !mUsed.empty(); });
+
+            if (mWrites.empty() && mUsed.empty())
+                return;
+
+            std::deque<Write> writes;
+            std::vector<std::uint64_t> used;
+            writes.swap(mWrites);
+            used.swap(mUsed);
+            lock.unlock();
+
+            for (const Write& v : writes)
+                write(v);
+
+            // The file times keep the least recently used order for the next run
+            const std::time_t now = std::time(nullptr);
+            for (std::uint64_t hash : used)
+            {
+                boost::system::error_code ec;
+                boost::filesystem::last_write_time(getTilePath(hash), now, ec);
+            }
+
+            lock.lock();
+            if (mTotalSize > mMaxSize)
+                removeLeastRecentlyUsed();
+        }
+    }
+
+    void NavMeshDb::write(const Write& write)
+    {
+        const boost::filesystem::path path = getTilePath(write.mHash);
+        boost::filesystem::path temp = path;
+        temp += "." + boost::filesystem::unique_path().string() + ".tmp";
+
+        Header header;
+        std::memcpy(header.mMagic, sMagic, sizeof(sMagic));
+        header.mVersion = sFormatVersion;
+        header.mKeySize = static_cast<std::uint32_t>(write.mKey.size());
+        header.mSize = static_cast<std::uint32_t>(write.mData.size());
+
+        try
+        {
+            boost::filesystem::create_directories(mPath);
+
+            {
+                boost::filesystem::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+                stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                stream.write(write.mKey.data(), write.mKey.size());
+                stream.write(reinterpret_cast<const char*>(write.mData.data()), write.mData.size());
+                if (!stream)
+                    throw std::runtime_error("write failed");
+            }
+
+            boost::filesystem::rename(temp, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save navmesh tile " << path << ": " << e.what();
+            boost::system::error_code ec;
+            boost::filesystem::remove(temp, ec);
+            return;
+        }
+
+        const std::size_t size = sizeof(header) + write.mKey.size() + write.mData.size();
+        const std::lock_guard<std::mutex> lock(mMutex);
+        Entry& entry = mEntries[write.mHash];
+        mTotalSize = mTotalSize - entry.mSize + size;
+        entry = Entry {size, std::time(nullptr)};
+        ++mWritten;
+    }
+
+    void NavMeshDb::removeLeastRecentlyUsed()
+    {
+        std::vector<std::pair<std::time_t, std::uint64_t>> byLastUse;
+        byLastUse.reserve(mEntries.size());
+        for (const auto& [hash, entry] : mEntries)
+            byLastUse.emplace_back(entry.mLastUse, hash);
+        std::sort(byLastUse.begin(), byLastUse.end());
+
+        // Go a bit below the limit so that the next few writes don't have to remove tiles again
+        const std::size_t targetSize = mMaxSize / 10 * 9;
+        for (const auto& [lastUse, hash] : byLastUse)
+        {
+            if (mTotalSize <= targetSize)
+                break;
+            boost::system::error_code ec;
+            boost::filesystem::remove(getTilePath(hash), ec);
+            const auto entry = mEntries.find(hash);
+            mTotalSize -= entry->second.mSize;
+            mEntries.erase(entry);
+        }
+    }
+}
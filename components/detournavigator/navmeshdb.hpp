@@ -0,0 +1,111 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
+
+#include "navmeshdata.hpp"
+#include "offmeshconnection.hpp"
+#include "tileposition.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <osg/Vec3f>
+
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    class RecastMesh;
+    struct Settings;
+
+    /// @brief Navmesh tiles kept on disk between runs, one file per tile.
+    /// @par Tiles are keyed by everything they are generated from: the agent half extents, the tile position, the
+    /// recast mesh, the off mesh connections and the settings. Files are named by a hash of the key and store the
+    /// whole key, so a tile is only loaded for exactly the input it was built from. Files are written by a
+    /// background thread. When the files take more than the size limit, the least recently used ones are removed.
+    class NavMeshDb
+    {
+    public:
+        struct Stats
+        {
+            std::size_t mSize;
+            std::size_t mTiles;
+            std::size_t mHits;
+            std::size_t mMisses;
+            std::size_t mWrites;
+        };
+
+        NavMeshDb(const boost::filesystem::path& path, std::size_t maxSize, const Settings& settings);
+
+        /// Writes the tiles that are still queued
+        ~NavMeshDb();
+
+        /// @return The serialized input of the tile
+        std::string makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const;
+
+        /// @return The stored tile, or empty data when there is none for the key
+        NavMeshData get(const std::string& key);
+
+        /// Queue a copy of the tile data to be written
+        void put(const std::string& key, const unsigned char* data, int size);
+
+        Stats getStats() const;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Entry
+        {
+            std::size_t mSize;
+            std::time_t mLastUse;
+        };
+
+        struct Write
+        {
+            std::uint64_t mHash;
+            std::string mKey;
+            std::vector<unsigned char> mData;
+        };
+
+        const boost::filesystem::path mPath;
+        const std::size_t mMaxSize;
+        const std::string mSettingsKey;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasWork;
+        std::unordered_map<std::uint64_t, Entry> mEntries; // by key hash
+        std::deque<Write> mWrites;
+        std::vector<std::uint64_t> mUsed; // read since the last write back, their files get a new time
+        std::size_t mTotalSize = 0;
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+        std::size_t mWritten = 0;
+        bool mShouldStop = false;
+        std::thread mThread;
+
+        static std::uint64_t getHash(const std::string& key);
+
+        boost::filesystem::path getTilePath(std::uint64_t hash) const;
+
+        void scan();
+
+        void run();
+
+        void write(const Write& write);
+
+        void removeLeastRecentlyUsed();
+    };
+}
+
+#endif
@@ -194,6 +194,13 @@ namespace DetourNavigator
             " recastMeshManagerRevision=" << lastRevision;
     }
 
+    void NavMeshManager::setPlayerView(const osg::Vec3f& playerPosition, const osg::Vec3f& direction)
+    {
+        const auto playerTile = getTilePosition(mSettings, toNavMeshCoordinates(mSettings, playerPosition));
+        // Tiles are laid out over the horizontal plane, that is x and y in world coordinates
+        mAsyncNavMeshUpdater.setPlayerView(playerTile, osg::Vec2f(direction.x(), direction.y()));
+    }
+
     void NavMeshManager::wait(Loading::Listener& listener, WaitConditionType waitConditionType)
     {
         mAsyncNavMeshUpdater.wait(listener, waitConditionType);
@@ -45,6 +45,8 @@ namespace DetourNavigator
 
         void update(osg::Vec3f playerPosition, const osg::Vec3f& agentHalfExtents);
 
+        void setPlayerView(const osg::Vec3f& playerPosition, const osg::Vec3f& direction);
+
         void wait(Loading::Listener& listener, WaitConditionType waitConditionType);
 
         SharedNavMeshCacheItem getNavMesh(const osg::Vec3f& agentHalfExtents) const;
@@ -1,7 +1,10 @@
 #include "navmeshtilescache.hpp"
 
+#include <components/misc/hash.hpp>
+
 #include <osg/Stats>
 
+#include <algorithm>
 #include <cstring>
 
 namespace DetourNavigator
@@ -18,6 +21,68 @@ namespace DetourNavigator
             const std::size_t offMeshConnectionsSize = offMeshConnections.size() * sizeof(OffMeshConnection);
             return indicesSize + verticesSize + areaTypesSize + waterSize + offMeshConnectionsSize;
         }
+
+        template <class T>
+        std::uint64_t hashValue(const T& value, std::uint64_t seed)
+        {
+            return Misc::hashFnv1a(&value, sizeof(value), seed);
+        }
+
+        std::uint64_t hashOffMeshConnection(const OffMeshConnection& value, std::uint64_t seed)
+        {
+            seed = hashValue(value.mStart, seed);
+            seed = hashValue(value.mEnd, seed);
+            return hashValue(value.mAreaType, seed);
+        }
+
+        std::uint64_t hashKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
+        {
+            std::uint64_t seed = hashValue(agentHalfExtents, recastMesh.getHash());
+            seed = hashValue(changedTile.x(), seed);
+            seed = hashValue(changedTile.y(), seed);
+            seed = hashValue(offMeshConnections.size(), seed);
+            // Off mesh connections are not hashed once like the recast mesh, so only a few of them go into
+            // the hash to keep it cheap. Matching hashes are compared in full anyway.
+            const std::size_t sampled = std::min<std::size_t>(offMeshConnections.size(), 4);
+            for (std::size_t i = 0; i < sampled; ++i)
+            {
+                seed = hashOffMeshConnection(offMeshConnections[i], seed);
+                seed = hashOffMeshConnection(offMeshConnections[offMeshConnections.size() - 1 - i], seed);
+            }
+            return seed;
+        }
+
+        bool isEqual(const RecastMesh::Water& lhs, const RecastMesh::Water& rhs)
+        {
+            return lhs.mCellSize == rhs.mCellSize && lhs.mTransform == rhs.mTransform;
+        }
+
+        bool isEqual(const OffMeshConnection& lhs, const OffMeshConnection& rhs)
+        {
+            return lhs.mStart == rhs.mStart && lhs.mEnd == rhs.mEnd && lhs.mAreaType == rhs.mAreaType;
+        }
+
+        template <class T>
+        bool isEqual(const std::vector<T>& lhs, const std::vector<T>& rhs)
+        {
+            return lhs.size() == rhs.size()
+                && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [] (const T& l, const T& r) { return isEqual(l, r); });
+        }
+
+        bool isEqual(const NavMeshTilesCache::Item& item, const osg::Vec3f& agentHalfExtents,
+            const TilePosition& changedTile, const RecastMesh& recastMesh,
+            const std::vector<OffMeshConnection>& offMeshConnections)
+        {
+            const RecastMeshData& data = item.mNavMeshKey.mRecastMesh;
+            return item.mAgentHalfExtents == agentHalfExtents
+                && item.mChangedTile == changedTile
+                && data.mIndices == recastMesh.getIndices()
+                && data.mVertices == recastMesh.getVertices()
+                && data.mAreaTypes == recastMesh.getAreaTypes()
+                && isEqual(data.mWater, recastMesh.getWater())
+                && isEqual(item.mNavMeshKey.mOffMeshConnections, offMeshConnections);
+        }
     }
 
     NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize)
@@ -27,19 +92,21 @@ namespace DetourNavigator
     NavMeshTilesCache::Value NavMeshTilesCache::get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
         const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
     {
+        const auto hash = hashKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+
         const std::lock_guard<std::mutex> lock(mMutex);
 
         ++mGetCount;
 
-        const auto tile = mValues.find(std::make_tuple(agentHalfExtents, changedTile, NavMeshKeyView(recastMesh, offMeshConnections)));
-        if (tile == mValues.end())
+        const auto tile = findUnsafe(hash, agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+        if (tile == mFreeItems.end())
             return Value();
 
-        acquireItemUnsafe(tile->second);
+        acquireItemUnsafe(tile);
 
         ++mHitCount;
 
-        return Value(*this, tile->second);
+        return Value(*this, tile);
     }
 
     NavMeshTilesCache::Value NavMeshTilesCache::set(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
@@ -47,12 +114,22 @@ namespace DetourNavigator
         NavMeshData&& value)
     {
         const auto itemSize = static_cast<std::size_t>(value.mSize) + getSize(recastMesh, offMeshConnections);
+        const auto hash = hashKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
         if (itemSize > mFreeNavMeshDataSize + (mMaxNavMeshDataSize - mUsedNavMeshDataSize))
             return Value();
 
+        const auto existing = findUnsafe(hash, agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+        if (existing != mFreeItems.end())
+        {
+            acquireItemUnsafe(existing);
+            ++mGetCount;
+            ++mHitCount;
+            return Value(*this, existing);
+        }
+
         while (!mFreeItems.empty() && mUsedNavMeshDataSize + itemSize > mMaxNavMeshDataSize)
             removeLeastRecentlyUsed();
 
@@ -61,17 +138,8 @@ namespace DetourNavigator
             offMeshConnections
         };
 
-        const auto iterator = mFreeItems.emplace(mFreeItems.end(), agentHalfExtents, changedTile, std::move(navMeshKey), itemSize);
-        const auto emplaced = mValues.emplace(std::make_tuple(agentHalfExtents, changedTile, NavMeshKeyRef(iterator->mNavMeshKey)), iterator);
-
-        if (!emplaced.second)
-        {
-            mFreeItems.erase(iterator);
-            acquireItemUnsafe(emplaced.first->second);
-            ++mGetCount;
-            ++mHitCount;
-            return Value(*this, emplaced.first->second);
-        }
+        const auto iterator = mFreeItems.emplace(mFreeItems.end(), hash, agentHalfExtents, changedTile, std::move(navMeshKey), itemSize);
+        mValues.emplace(hash, iterator);
 
         iterator->mNavMeshData = std::move(value);
         ++iterator->mUseCount;
@@ -104,12 +172,24 @@ namespace DetourNavigator
         out.setAttribute(frameNumber, "NavMesh CacheHitRate", static_cast<double>(stats.mHitCount) / stats.mGetCount * 100.0);
     }
 
+    NavMeshTilesCache::ItemIterator NavMeshTilesCache::findUnsafe(std::uint64_t hash, const osg::Vec3f& agentHalfExtents,
+        const TilePosition& changedTile, const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
+    {
+        const auto range = mValues.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+            if (isEqual(*it->second, agentHalfExtents, changedTile, recastMesh, offMeshConnections))
+                return it->second;
+        return mFreeItems.end();
+    }
+
     void NavMeshTilesCache::removeLeastRecentlyUsed()
     {
         const auto& item = mFreeItems.back();
 
-        const auto value = mValues.find(std::make_tuple(item.mAgentHalfExtents, item.mChangedTile, NavMeshKeyRef(item.mNavMeshKey)));
-        if (value == mValues.end())
+        const auto range = mValues.equal_range(item.mHash);
+        const auto value = std::find_if(range.first, range.second,
+            [&] (const auto& v) { return &*v.second == &item; });
+        if (value == range.second)
             return;
 
         mUsedNavMeshDataSize -= item.mSize;
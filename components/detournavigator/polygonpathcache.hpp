@@ -0,0 +1,108 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_POLYGONPATHCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_POLYGONPATHCACHE_H
+
+#include "areatype.hpp"
+#include "flags.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <osg/Vec3f>
+#include <osg/Vec3i>
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct PolygonPathKey
+    {
+        dtPolyRef mStart;
+        dtPolyRef mEnd;
+        osg::Vec3i mStartCell;
+        osg::Vec3i mEndCell;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+
+        friend inline bool operator <(const PolygonPathKey& lhs, const PolygonPathKey& rhs)
+        {
+            return std::tie(lhs.mStart, lhs.mEnd, lhs.mStartCell, lhs.mEndCell, lhs.mIncludeFlags,
+                    lhs.mAreaCosts.mWater, lhs.mAreaCosts.mDoor, lhs.mAreaCosts.mPathgrid, lhs.mAreaCosts.mGround)
+                < std::tie(rhs.mStart, rhs.mEnd, rhs.mStartCell, rhs.mEndCell, rhs.mIncludeFlags,
+                    rhs.mAreaCosts.mWater, rhs.mAreaCosts.mDoor, rhs.mAreaCosts.mPathgrid, rhs.mAreaCosts.mGround);
+        }
+    };
+
+    inline osg::Vec3i getPolygonPathCell(const osg::Vec3f& position, float cellSize)
+    {
+        return osg::Vec3i(static_cast<int>(std::floor(position.x() / cellSize)),
+                          static_cast<int>(std::floor(position.y() / cellSize)),
+                          static_cast<int>(std::floor(position.z() / cellSize)));
+    }
+
+    /// @brief Detour uses the start and end positions to cost the first and last polygons, so the found polygon
+    /// path depends on them as well. Positions are quantized to navmesh cells, the navmesh can't tell points within
+    /// one cell apart.
+    inline PolygonPathKey makePolygonPathKey(dtPolyRef startRef, dtPolyRef endRef, const osg::Vec3f& start,
+        const osg::Vec3f& end, Flags includeFlags, const AreaCosts& areaCosts, float cellSize)
+    {
+        return PolygonPathKey {startRef, endRef, getPolygonPathCell(start, cellSize), getPolygonPathCell(end, cellSize),
+                               includeFlags, areaCosts};
+    }
+
+    /// @brief Polygon paths found over one navmesh, so that actors repeatedly going between the same navmesh cells
+    /// do not search the navmesh again. Only the polygon path is cached, string pulling still uses exact positions.
+    /// @par Polygon references become invalid when the navmesh tiles change, so the owner clears the cache on each
+    /// navmesh change. Not thread safe, the owner guards it together with the navmesh.
+    class PolygonPathCache
+    {
+    public:
+        explicit PolygonPathCache(std::size_t maxSize)
+            : mMaxSize(maxSize)
+        {}
+
+        std::optional<std::vector<dtPolyRef>> get(const PolygonPathKey& key)
+        {
+            const auto it = mPaths.find(key);
+            if (it == mPaths.end())
+            {
+                ++mMisses;
+                return std::nullopt;
+            }
+            ++mHits;
+            return it->second;
+        }
+
+        void set(const PolygonPathKey& key, const std::vector<dtPolyRef>& path)
+        {
+            if (mMaxSize == 0)
+                return;
+            // Entries live until the next navmesh change anyway, dropping all of them is enough to bound the size
+            if (mPaths.size() >= mMaxSize)
+                mPaths.clear();
+            mPaths[key] = path;
+        }
+
+        void clear()
+        {
+            mPaths.clear();
+        }
+
+        std::size_t size() const { return mPaths.size(); }
+
+        std::size_t getHits() const { return mHits; }
+
+        std::size_t getMisses() const { return mMisses; }
+
+    private:
+        std::size_t mMaxSize;
+        std::map<PolygonPathKey, std::vector<dtPolyRef>> mPaths;
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+    };
+}
+
+#endif
@@ -1,10 +1,52 @@
 #include "recastmesh.hpp"
 #include "exceptions.hpp"
 
+#include <components/misc/hash.hpp>
+
 #include <Recast.h>
 
 namespace DetourNavigator
 {
+    namespace
+    {
+        template <class T>
+        std::uint64_t hashArray(const std::vector<T>& values, std::uint64_t seed)
+        {
+            const std::uint64_t size = values.size();
+            seed = Misc::hashFnv1a(&size, sizeof(size), seed);
+            return Misc::hashFnv1a(values.data(), values.size() * sizeof(T), seed);
+        }
+
+        std::uint64_t hashValue(btScalar value, std::uint64_t seed)
+        {
+            return Misc::hashFnv1a(&value, sizeof(value), seed);
+        }
+
+        std::uint64_t hashVector(const btVector3& value, std::uint64_t seed)
+        {
+            // btVector3 has a fourth padding component that is not always initialized
+            seed = hashValue(value.x(), seed);
+            seed = hashValue(value.y(), seed);
+            return hashValue(value.z(), seed);
+        }
+
+        std::uint64_t hashRecastMesh(const std::vector<int>& indices, const std::vector<float>& vertices,
+            const std::vector<AreaType>& areaTypes, const std::vector<RecastMesh::Water>& water)
+        {
+            std::uint64_t seed = hashArray(indices, Misc::hashFnv1a(nullptr, 0));
+            seed = hashArray(vertices, seed);
+            seed = hashArray(areaTypes, seed);
+            for (const RecastMesh::Water& v : water)
+            {
+                seed = Misc::hashFnv1a(&v.mCellSize, sizeof(v.mCellSize), seed);
+                for (int i = 0; i < 3; ++i)
+                    seed = hashVector(v.mTransform.getBasis()[i], seed);
+                seed = hashVector(v.mTransform.getOrigin(), seed);
+            }
+            return seed;
+        }
+    }
+
     RecastMesh::RecastMesh(std::size_t generation, std::size_t revision, std::vector<int> indices, std::vector<float> vertices,
             std::vector<AreaType> areaTypes, std::vector<Water> water)
         : mGeneration(generation)
@@ -23,5 +65,6 @@ namespace DetourNavigator
         mVertices.shrink_to_fit();
         mAreaTypes.shrink_to_fit();
         mWater.shrink_to_fit();
+        mHash = hashRecastMesh(mIndices, mVertices, mAreaTypes, mWater);
     }
 }
@@ -6,6 +6,7 @@
 
 #include <components/bullethelpers/operators.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -72,6 +73,12 @@ namespace DetourNavigator
             return mBounds;
         }
 
+        /// Hash of indices, vertices, area types and water, computed once on construction
+        std::uint64_t getHash() const
+        {
+            return mHash;
+        }
+
     private:
         std::size_t mGeneration;
         std::size_t mRevision;
@@ -80,6 +87,7 @@ namespace DetourNavigator
         std::vector<AreaType> mAreaTypes;
         std::vector<Water> mWater;
         Bounds mBounds;
+        std::uint64_t mHash;
     };
 
     inline bool operator<(const RecastMesh::Water& lhs, const RecastMesh::Water& rhs)
@@ -36,6 +36,8 @@ namespace DetourNavigator
         std::size_t mMaxNavMeshTilesCacheSize = 0;
         std::size_t mMaxPolygonPathSize = 0;
         std::size_t mMaxSmoothPathSize = 0;
+        std::size_t mMaxNavMeshDbSize = 0;
+        std::string mNavMeshDbPath; // no tiles are kept on disk when empty
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
@@ -1,12 +1,65 @@
 #include "esmreader.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 namespace ESM
 {
 
 using namespace Misc;
 
+struct ESMReader::MappedFile
+{
+    boost::iostreams::mapped_file_source mFile;
+
+    /// Map \a filename, or return the mapping another reader already holds. Returns nullptr if
+    /// the file cannot be mapped, in which case it is read through a stream instead.
+    static std::shared_ptr<const MappedFile> open(const std::string& filename)
+    {
+        static std::mutex mutex;
+        static std::map<std::string, std::weak_ptr<const MappedFile>> files;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto found = files.find(filename);
+        if (found != files.end())
+        {
+            if (std::shared_ptr<const MappedFile> file = found->second.lock())
+                return file;
+        }
+
+        std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+        try
+        {
+            file->mFile.open(filename);
+        }
+        catch (const std::exception&)
+        {
+            // Empty files cannot be mapped, for example
+            return nullptr;
+        }
+
+        if (!file->mFile.is_open())
+            return nullptr;
+
+        for (auto it = files.begin(); it != files.end();)
+        {
+            if (it->second.expired())
+                it = files.erase(it);
+            else
+                ++it;
+        }
+
+        files[filename] = file;
+        return file;
+    }
+};
+
     std::string ESMReader::getName() const
     {
         return mCtx.filename;
@@ -15,12 +68,14 @@ using namespace Misc;
 ESM_Context ESMReader::getContext()
 {
     // Update the file position before returning
-    mCtx.filePos = mEsm->tellg();
+    mCtx.filePos = getFileOffset();
     return mCtx;
 }
 
 ESMReader::ESMReader()
-    : mRecordFlags(0)
+    : mData(nullptr)
+    , mPos(0)
+    , mRecordFlags(0)
     , mBuffer(50*1024)
     , mGlobalReaderList(nullptr)
     , mEncoder(nullptr)
@@ -44,12 +99,18 @@ void ESMReader::restoreContext(const ESM_Context &rc)
     mCtx = rc;
 
     // Make sure we seek to the right place
-    mEsm->seekg(mCtx.filePos);
+    if (mData)
+        mPos = mCtx.filePos;
+    else
+        mEsm->seekg(mCtx.filePos);
 }
 
 void ESMReader::close()
 {
     mEsm.reset();
+    mMappedFile.reset();
+    mData = nullptr;
+    mPos = 0;
     clearCtx();
     mHeader.blank();
 }
@@ -77,13 +138,21 @@ void ESMReader::openRaw(Files::IStreamPtr _esm, const std::string& name)
 
 void ESMReader::openRaw(const std::string& filename)
 {
+    if (std::shared_ptr<const MappedFile> file = MappedFile::open(filename))
+    {
+        close();
+        mMappedFile = file;
+        mData = file->mFile.data();
+        mCtx.filename = filename;
+        mCtx.leftFile = mFileSize = file->mFile.size();
+        return;
+    }
+
     openRaw(Files::openConstrainedFileStream(filename.c_str()), filename);
 }
 
-void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
+void ESMReader::loadHeader()
 {
-    openRaw(_esm, name);
-
     if (getRecName() != "TES3")
         fail("Not a valid Morrowind file");
 
@@ -92,9 +161,16 @@ void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
     mHeader.load (*this);
 }
 
+void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
+{
+    openRaw(_esm, name);
+    loadHeader();
+}
+
 void ESMReader::open(const std::string &file)
 {
-    open (Files::openConstrainedFileStream (file.c_str ()), file);
+    openRaw(file);
+    loadHeader();
 }
 
 std::string ESMReader::getHNOString(const char* name)
@@ -119,7 +195,7 @@ std::string ESMReader::getHString()
     // them. For some reason, they break the rules, and contain a byte
     // (value 0) even if the header says there is no data. If
     // Morrowind accepts it, so should we.
-    if (mCtx.leftSub == 0 && !mEsm->peek())
+    if (mCtx.leftSub == 0 && (mData ? mPos < mFileSize && mData[mPos] == 0 : !mEsm->peek()))
     {
         // Skip the following zero byte
         mCtx.leftRec--;
@@ -131,6 +207,12 @@ std::string ESMReader::getHString()
     return getString(mCtx.leftSub);
 }
 
+std::string_view ESMReader::getHView()
+{
+    getSubHeader();
+    return getView(mCtx.leftSub);
+}
+
 void ESMReader::getHExact(void*p, int size)
 {
     getSubHeader();
@@ -302,6 +384,15 @@ void ESMReader::getRecHeader(uint32_t &flags)
 
 void ESMReader::getExact(void*x, int size)
 {
+    if (mData)
+    {
+        if (size < 0 || mFileSize - mPos < static_cast<size_t>(size))
+            fail("Read error: unexpected end of file");
+        std::memcpy(x, mData + mPos, size);
+        mPos += size;
+        return;
+    }
+
     try
     {
         mEsm->read((char*)x, size);
@@ -314,6 +405,25 @@ void ESMReader::getExact(void*x, int size)
 
 std::string ESMReader::getString(int size)
 {
+    if (mData)
+    {
+        std::string_view view = getView(size);
+        size_t length = strnlen(view.data(), view.size());
+
+        if (!mEncoder)
+            return std::string (view.data(), length);
+
+        // The encoder needs a zero terminated string, which the mapped file does not have to
+        // contain, so convert from a terminated copy
+        if (mBuffer.size() <= length)
+            mBuffer.resize(3*length + 1);
+
+        std::memcpy(mBuffer.data(), view.data(), length);
+        mBuffer[length] = 0;
+
+        return mEncoder->getUtf8(mBuffer.data(), length);
+    }
+
     size_t s = size;
     if (mBuffer.size() <= s)
         // Add some extra padding to reduce the chance of having to resize
@@ -344,8 +454,8 @@ void ESMReader::fail(const std::string &msg)
     ss << "\n  File: " << mCtx.filename;
     ss << "\n  Record: " << mCtx.recName.toString();
     ss << "\n  Subrecord: " << mCtx.subName.toString();
-    if (mEsm.get())
-        ss << "\n  Offset: 0x" << std::hex << mEsm->tellg();
+    if (mData || mEsm.get())
+        ss << "\n  Offset: 0x" << std::hex << getFileOffset();
     throw std::runtime_error(ss.str());
 }
 
@@ -354,13 +464,37 @@ void ESMReader::setEncoder(ToUTF8::Utf8Encoder* encoder)
     mEncoder = encoder;
 }
 
+std::string_view ESMReader::getView(int size)
+{
+    if (mData)
+    {
+        if (size < 0 || mFileSize - mPos < static_cast<size_t>(size))
+            fail("Read error: unexpected end of file");
+        std::string_view view(mData + mPos, size);
+        mPos += size;
+        return view;
+    }
+
+    if (mBuffer.size() < static_cast<size_t>(size))
+        mBuffer.resize(size);
+    getExact(mBuffer.data(), size);
+    return std::string_view(mBuffer.data(), size);
+}
+
 size_t ESMReader::getFileOffset() const
 {
+    if (mData)
+        return mPos;
     return mEsm->tellg();
 }
 
 void ESMReader::skip(int bytes)
 {
+    if (mData)
+    {
+        mPos = std::min(mPos + bytes, mFileSize);
+        return;
+    }
     mEsm->seekg(getFileOffset()+bytes);
 }
 
@@ -3,8 +3,10 @@
 
 #include <cstdint>
 #include <cassert>
+#include <memory>
 #include <vector>
 #include <sstream>
+#include <string_view>
 
 #include <components/files/constrainedfilestream.hpp>
 
@@ -68,10 +70,15 @@ public:
   /// currently open file first, if any.
   void open(Files::IStreamPtr _esm, const std::string &name);
 
+  /// Open a file by name, memory mapping it if possible. Files that are already
+  /// mapped by another reader share the mapping.
   void open(const std::string &file);
 
   void openRaw(const std::string &filename);
 
+  /// Is the file memory mapped rather than read through a stream?
+  bool isMapped() const { return mData != nullptr; }
+
   /// Get the current position in the file. Make sure that the file has been opened!
   size_t getFileOffset() const;
 
@@ -160,6 +167,11 @@ public:
   // Read a string, including the sub-record header (but not the name)
   std::string getHString();
 
+  // Read a subrecord, including the sub-record header, without converting or copying it. For
+  // memory mapped files the view points into the file itself and stays valid while the file is
+  // open, otherwise it is only valid until the next read.
+  std::string_view getHView();
+
   // Read the given number of bytes from a subrecord
   void getHExact(void*p, int size);
 
@@ -251,6 +263,9 @@ public:
   // them from native encoding to UTF8 in the process.
   std::string getString(int size);
 
+  // Read the next 'size' bytes without copying them if the file is memory mapped
+  std::string_view getView(int size);
+
   void skip(int bytes);
 
   /// Used for error handling
@@ -265,10 +280,19 @@ public:
   size_t getFileSize() const { return mFileSize; }
 
 private:
+  struct MappedFile;
+
   void clearCtx();
 
+  void loadHeader();
+
   Files::IStreamPtr mEsm;
 
+  // Set instead of mEsm when the file is memory mapped
+  std::shared_ptr<const MappedFile> mMappedFile;
+  const char* mData;
+  size_t mPos;
+
   ESM_Context mCtx;
 
   unsigned int mRecordFlags;
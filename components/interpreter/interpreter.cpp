@@ -18,12 +18,12 @@ namespace Interpreter
                 int opcode = code>>24;
                 unsigned int arg0 = code & 0xffffff;
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment0.find (opcode);
+                Opcode1 *handler = mSegment0.find (opcode);
 
-                if (iter==mSegment0.end())
+                if (!handler)
                     abortUnknownCode (0, opcode);
 
-                iter->second->execute (mRuntime, arg0);
+                handler->execute (mRuntime, arg0);
 
                 return;
             }
@@ -33,12 +33,12 @@ namespace Interpreter
                 int opcode = (code>>20) & 0x3ff;
                 unsigned int arg0 = code & 0xfffff;
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment2.find (opcode);
+                Opcode1 *handler = mSegment2.find (opcode);
 
-                if (iter==mSegment2.end())
+                if (!handler)
                     abortUnknownCode (2, opcode);
 
-                iter->second->execute (mRuntime, arg0);
+                handler->execute (mRuntime, arg0);
 
                 return;
             }
@@ -53,12 +53,12 @@ namespace Interpreter
                 int opcode = (code>>8) & 0x3ffff;
                 unsigned int arg0 = code & 0xff;
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment3.find (opcode);
+                Opcode1 *handler = mSegment3.find (opcode);
 
-                if (iter==mSegment3.end())
+                if (!handler)
                     abortUnknownCode (3, opcode);
 
-                iter->second->execute (mRuntime, arg0);
+                handler->execute (mRuntime, arg0);
 
                 return;
             }
@@ -67,12 +67,12 @@ namespace Interpreter
             {
                 int opcode = code & 0x3ffffff;
 
-                std::map<int, Opcode0 *>::iterator iter = mSegment5.find (opcode);
+                Opcode0 *handler = mSegment5.find (opcode);
 
-                if (iter==mSegment5.end())
+                if (!handler)
                     abortUnknownCode (5, opcode);
 
-                iter->second->execute (mRuntime);
+                handler->execute (mRuntime);
 
                 return;
             }
@@ -120,50 +120,88 @@ namespace Interpreter
         }
     }
 
-    Interpreter::Interpreter() : mRunning (false)
+    // Extension ranges as documented in docs/vmformat.txt
+    Interpreter::Interpreter() : mRunning (false), mSegment0 (32), mSegment2 (512), mSegment3 (0x20000),
+        mSegment5 (0x2000000)
     {}
 
     Interpreter::~Interpreter()
-    {
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment0.begin());
-            iter!=mSegment0.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment2.begin());
-            iter!=mSegment2.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment3.begin());
-            iter!=mSegment3.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode0 *>::iterator iter (mSegment5.begin());
-            iter!=mSegment5.end(); ++iter)
-            delete iter->second;
-    }
+    {}
 
     void Interpreter::installSegment0 (int code, Opcode1 *opcode)
     {
-        assert(mSegment0.find(code) == mSegment0.end());
-        mSegment0.insert (std::make_pair (code, opcode));
+        mSegment0.insert (code, opcode);
     }
 
     void Interpreter::installSegment2 (int code, Opcode1 *opcode)
     {
-        assert(mSegment2.find(code) == mSegment2.end());
-        mSegment2.insert (std::make_pair (code, opcode));
+        mSegment2.insert (code, opcode);
     }
 
     void Interpreter::installSegment3 (int code, Opcode1 *opcode)
     {
-        assert(mSegment3.find(code) == mSegment3.end());
-        mSegment3.insert (std::make_pair (code, opcode));
+        mSegment3.insert (code, opcode);
     }
 
     void Interpreter::installSegment5 (int code, Opcode0 *opcode)
     {
-        assert(mSegment5.find(code) == mSegment5.end());
-        mSegment5.insert (std::make_pair (code, opcode));
+        mSegment5.insert (code, opcode);
+    }
+
+    void Interpreter::decode (const Type_Code *code, int codeSize, std::vector<DecodedInstruction>& decoded) const
+    {
+        assert (codeSize>=4);
+
+        int opcodes = static_cast<int> (code[0]);
+
+        const Type_Code *codeBlock = code + 4;
+
+        decoded.clear();
+        decoded.reserve (opcodes);
+
+        for (int i=0; i<opcodes; ++i)
+        {
+            Type_Code instruction = codeBlock[i];
+
+            DecodedInstruction entry;
+            entry.mOpcode1 = nullptr;
+            entry.mOpcode0 = nullptr;
+            entry.mArg0 = 0;
+            entry.mCode = instruction;
+
+            switch (instruction>>30)
+            {
+                case 0:
+
+                    entry.mOpcode1 = mSegment0.find (instruction>>24);
+                    entry.mArg0 = instruction & 0xffffff;
+                    break;
+
+                case 2:
+
+                    entry.mOpcode1 = mSegment2.find ((instruction>>20) & 0x3ff);
+                    entry.mArg0 = instruction & 0xfffff;
+                    break;
+
+                default:
+
+                    switch (instruction>>26)
+                    {
+                        case 0x30:
+
+                            entry.mOpcode1 = mSegment3.find ((instruction>>8) & 0x3ffff);
+                            entry.mArg0 = instruction & 0xff;
+                            break;
+
+                        case 0x32:
+
+                            entry.mOpcode0 = mSegment5.find (instruction & 0x3ffffff);
+                            break;
+                    }
+            }
+
+            decoded.push_back (entry);
+        }
     }
 
     void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
@@ -195,4 +233,42 @@ namespace Interpreter
 
         end();
     }
+
+    void Interpreter::run (const Type_Code *code, int codeSize,
+        const std::vector<DecodedInstruction>& decoded, Context& context)
+    {
+        assert (codeSize>=4);
+        assert (decoded.size()==code[0]);
+
+        begin();
+
+        try
+        {
+            mRuntime.configure (code, codeSize, context);
+
+            int opcodes = static_cast<int> (decoded.size());
+
+            const DecodedInstruction *instructions = decoded.data();
+
+            while (mRuntime.getPC()>=0 && mRuntime.getPC()<opcodes)
+            {
+                const DecodedInstruction& instruction = instructions[mRuntime.getPC()];
+                mRuntime.setPC (mRuntime.getPC()+1);
+
+                if (instruction.mOpcode1)
+                    instruction.mOpcode1->execute (mRuntime, instruction.mArg0);
+                else if (instruction.mOpcode0)
+                    instruction.mOpcode0->execute (mRuntime);
+                else
+                    execute (instruction.mCode); // reports the unknown opcode or segment
+            }
+        }
+        catch (...)
+        {
+            end();
+            throw;
+        }
+
+        end();
+    }
 }
@@ -1,8 +1,9 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <map>
+#include <cassert>
 #include <stack>
+#include <vector>
 
 #include "runtime.hpp"
 #include "types.hpp"
@@ -12,15 +13,76 @@ namespace Interpreter
     class Opcode0;
     class Opcode1;
 
+    /// Handlers of a segment, stored as flat arrays indexed by opcode.
+    ///
+    /// Opcodes are either built in and numbered from 0, or extensions numbered from a fixed
+    /// base per segment, so two dense arrays are kept instead of one spanning the gap.
+    template<typename T>
+    class OpcodeTable
+    {
+            std::vector<T *> mBuiltIn;
+            std::vector<T *> mExtensions;
+            unsigned int mExtensionBase;
+
+            // not implemented
+            OpcodeTable (const OpcodeTable&);
+            OpcodeTable& operator= (const OpcodeTable&);
+
+        public:
+
+            explicit OpcodeTable (unsigned int extensionBase) : mExtensionBase (extensionBase) {}
+
+            ~OpcodeTable()
+            {
+                for (T *opcode : mBuiltIn)
+                    delete opcode;
+
+                for (T *opcode : mExtensions)
+                    delete opcode;
+            }
+
+            void insert (unsigned int code, T *opcode)
+            ///< ownership of \a opcode is transferred to *this.
+            {
+                std::vector<T *>& table = code<mExtensionBase ? mBuiltIn : mExtensions;
+                unsigned int index = code<mExtensionBase ? code : code - mExtensionBase;
+
+                if (index>=table.size())
+                    table.resize (index+1, nullptr);
+
+                assert (table[index]==nullptr);
+                table[index] = opcode;
+            }
+
+            T *find (unsigned int code) const
+            ///< \return nullptr if \a code is not installed.
+            {
+                if (code<mExtensionBase)
+                    return code<mBuiltIn.size() ? mBuiltIn[code] : nullptr;
+
+                code -= mExtensionBase;
+                return code<mExtensions.size() ? mExtensions[code] : nullptr;
+            }
+    };
+
+    /// Instruction with its handler already looked up, see Interpreter::decode.
+    struct DecodedInstruction
+    {
+        Opcode1 *mOpcode1;
+        Opcode0 *mOpcode0;
+        unsigned int mArg0;
+        Type_Code mCode; ///< Original code, for reporting instructions without a handler
+    };
+
     class Interpreter
     {
             std::stack<Runtime> mCallstack;
             bool mRunning;
             Runtime mRuntime;
-            std::map<int, Opcode1 *> mSegment0;
-            std::map<int, Opcode1 *> mSegment2;
-            std::map<int, Opcode1 *> mSegment3;
-            std::map<int, Opcode0 *> mSegment5;
+            OpcodeTable<Opcode1> mSegment0;
+            OpcodeTable<Opcode1> mSegment2;
+            OpcodeTable<Opcode1> mSegment3;
+            OpcodeTable<Opcode0> mSegment5;
 
             // not implemented
             Interpreter (const Interpreter&);
@@ -54,7 +116,16 @@ namespace Interpreter
             void installSegment5 (int code, Opcode0 *opcode);
             ///< ownership of \a opcode is transferred to *this.
 
+            void decode (const Type_Code *code, int codeSize, std::vector<DecodedInstruction>& decoded) const;
+            ///< Look up the handlers of all instructions in \a code ahead of time, so that scripts
+            /// which are run repeatedly only pay for it once. Must be called after all opcodes have
+            /// been installed; instructions without a handler only fail once they are executed.
+
             void run (const Type_Code *code, int codeSize, Context& context);
+
+            void run (const Type_Code *code, int codeSize, const std::vector<DecodedInstruction>& decoded,
+                Context& context);
+            ///< \a decoded must have been created by decode from the same \a code.
     };
 }
 
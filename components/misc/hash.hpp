@@ -1,6 +1,10 @@
 #ifndef MISC_HASH_H
 #define MISC_HASH_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
 namespace Misc
 {
     /// Implemented similar to the boost::hash_combine
@@ -10,6 +14,18 @@ namespace Misc
         std::hash<T> hasher;
         seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
     }
+
+    /// 64-bit FNV-1a. Unlike std::hash the result is the same for every build, so it can be written to disk.
+    inline std::uint64_t hashFnv1a(const void* data, std::size_t size, std::uint64_t seed = 14695981039346656037ull)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            seed ^= bytes[i];
+            seed *= 1099511628211ull;
+        }
+        return seed;
+    }
 }
 
 #endif
\ No newline at end of file
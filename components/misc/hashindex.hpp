@@ -0,0 +1,108 @@
+#ifndef MISC_HASHINDEX_H
+#define MISC_HASHINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Open addressing hash table from precomputed hashes to indices into a container owned by the caller.
+    /// @par The keys themselves are not stored. Lookups compare the stored hash first and only call the given
+    /// predicate with the index of a candidate when the hashes match, so the caller decides how keys compare.
+    class HashIndex
+    {
+        public:
+            static constexpr std::uint32_t sNotFound = std::numeric_limits<std::uint32_t>::max();
+
+            void clear()
+            {
+                mSlots.clear();
+                mSize = 0;
+            }
+
+            std::size_t size() const { return mSize; }
+
+            void reserve(std::size_t count)
+            {
+                std::size_t capacity = 16;
+                while (capacity < count * 2)
+                    capacity *= 2;
+                if (capacity > mSlots.size())
+                    rehash(capacity);
+            }
+
+            /// Add \a value for \a hash, or replace the value of the entry \a equal returns true for.
+            template <class Equal>
+            void insert(std::uint64_t hash, std::uint32_t value, Equal&& equal)
+            {
+                if ((mSize + 1) * 2 > mSlots.size())
+                    rehash(mSlots.empty() ? 16 : mSlots.size() * 2);
+
+                Slot& slot = mSlots[findSlot(hash, equal)];
+                if (slot.mValue == sNotFound)
+                {
+                    slot.mHash = hash;
+                    ++mSize;
+                }
+                slot.mValue = value;
+            }
+
+            /// @return The value of the entry \a equal returns true for, or sNotFound.
+            template <class Equal>
+            std::uint32_t find(std::uint64_t hash, Equal&& equal) const
+            {
+                if (mSlots.empty())
+                    return sNotFound;
+                return mSlots[findSlot(hash, equal)].mValue;
+            }
+
+        private:
+            struct Slot
+            {
+                std::uint64_t mHash;
+                std::uint32_t mValue;
+            };
+
+            std::vector<Slot> mSlots;
+            std::size_t mSize = 0;
+
+            /// Fold the high bits in, the low bits of FNV style hashes only depend on the low bits of the input
+            static std::size_t getHome(std::uint64_t hash, std::size_t mask)
+            {
+                return static_cast<std::size_t>(hash ^ (hash >> 32)) & mask;
+            }
+
+            /// @return The slot holding the entry or the empty slot it would go to
+            template <class Equal>
+            std::size_t findSlot(std::uint64_t hash, Equal& equal) const
+            {
+                const std::size_t mask = mSlots.size() - 1;
+                for (std::size_t i = getHome(hash, mask); ; i = (i + 1) & mask)
+                {
+                    const Slot& slot = mSlots[i];
+                    if (slot.mValue == sNotFound || (slot.mHash == hash && equal(slot.mValue)))
+                        return i;
+                }
+            }
+
+            void rehash(std::size_t capacity)
+            {
+                std::vector<Slot> slots(capacity, Slot {0, sNotFound});
+                const std::size_t mask = capacity - 1;
+                for (const Slot& slot : mSlots)
+                {
+                    if (slot.mValue == sNotFound)
+                        continue;
+                    std::size_t i = getHome(slot.mHash, mask);
+                    while (slots[i].mValue != sNotFound)
+                        i = (i + 1) & mask;
+                    slots[i] = slot;
+                }
+                mSlots.swap(slots);
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+#define OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+
+#include <osg/Vec3f>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Uniform grid over positions in the XY plane, to find the values added near a position
+    /// without testing all of them.
+    /// @par Only cells that values were added to are stored. Cells are kept when the grid is cleared,
+    /// so rebuilding it every frame for values that move a little does not allocate.
+    template <class T>
+    class SpatialGrid
+    {
+        public:
+            explicit SpatialGrid(float cellSize) : mCellSize(cellSize) {}
+
+            void clear()
+            {
+                // Drop the cells when most of them went unused, e.g. after a cell change
+                if (mCells.size() > 4 * mSize + 64)
+                    mCells.clear();
+                else
+                    for (auto& cell : mCells)
+                        cell.second.mEntries.clear();
+                mSize = 0;
+            }
+
+            std::size_t size() const { return mSize; }
+
+            void add(const osg::Vec3f& position, const T& value)
+            {
+                const int x = getCellIndex(position.x());
+                const int y = getCellIndex(position.y());
+                Cell& cell = mCells[getKey(x, y)];
+                cell.mX = x;
+                cell.mY = y;
+                cell.mEntries.push_back(Entry {position, value});
+                ++mSize;
+            }
+
+            /// Call \a function with each value that was added at most \a radius away from \a position.
+            /// @note Values are visited in no particular order.
+            template <class Function>
+            void forEachInRange(const osg::Vec3f& position, float radius, Function&& function) const
+            {
+                const float radius2 = radius * radius;
+                const int minX = getCellIndex(position.x() - radius);
+                const int maxX = getCellIndex(position.x() + radius);
+                const int minY = getCellIndex(position.y() - radius);
+                const int maxY = getCellIndex(position.y() + radius);
+
+                const auto visit = [&] (const Cell& cell)
+                {
+                    for (const Entry& entry : cell.mEntries)
+                        if ((entry.mPosition - position).length2() <= radius2)
+                            function(entry.mValue);
+                };
+
+                // Large radii cover more cells than there are values, then walking the stored cells is cheaper
+                const std::uint64_t numCells = static_cast<std::uint64_t>(maxX - minX + 1) * static_cast<std::uint64_t>(maxY - minY + 1);
+                if (numCells > mCells.size())
+                {
+                    for (const auto& cell : mCells)
+                        if (cell.second.mX >= minX && cell.second.mX <= maxX && cell.second.mY >= minY && cell.second.mY <= maxY)
+                            visit(cell.second);
+                    return;
+                }
+
+                for (int x = minX; x <= maxX; ++x)
+                {
+                    for (int y = minY; y <= maxY; ++y)
+                    {
+                        const auto cell = mCells.find(getKey(x, y));
+                        if (cell != mCells.end())
+                            visit(cell->second);
+                    }
+                }
+            }
+
+        private:
+            struct Entry
+            {
+                osg::Vec3f mPosition;
+                T mValue;
+            };
+
+            struct Cell
+            {
+                int mX = 0;
+                int mY = 0;
+                std::vector<Entry> mEntries;
+            };
+
+            float mCellSize;
+            std::size_t mSize = 0;
+            std::unordered_map<std::uint64_t, Cell> mCells;
+
+            int getCellIndex(float coordinate) const
+            {
+                return static_cast<int>(std::floor(coordinate / mCellSize));
+            }
+
+            static std::uint64_t getKey(int x, int y)
+            {
+                return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+            }
+    };
+}
+
+#endif
@@ -85,6 +85,7 @@ namespace mwmp
         std::vector<ClientVariable> clientLocals;
         std::vector<ContainerItem> containerItems;
         unsigned int containerItemCount;
+        unsigned int containerRevision = 0; // 0 - Unversioned, otherwise the revision the container changes are based on
 
         RakNet::RakNetGUID guid; // only for object lists that can also include players
         bool isPlayer;
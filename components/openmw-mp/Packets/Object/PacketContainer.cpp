@@ -32,6 +32,7 @@ void PacketContainer::Packet(RakNet::BitStream *newBitstream, bool send)
         Object(baseObject, send);
 
         RW(baseObject.containerItemCount, send);
+        RW(baseObject.containerRevision, send, true);
 
         if (baseObject.containerItemCount > maxObjects || baseObject.refId.empty() || (baseObject.refNum != 0 && baseObject.mpNum != 0))
         {
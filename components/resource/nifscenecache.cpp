@@ -0,0 +1,414 @@
+#include "nifscenecache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <osg/Drawable>
+#include <osg/Node>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/UserDataContainer>
+#include <osg/Version>
+
+#include <osgDB/Options>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+
+#include <components/misc/hash.hpp>
+
+#include <components/nifosg/nifloader.hpp>
+
+#include <components/sceneutil/serialize.hpp>
+
+#include <components/vfs/archive.hpp>
+
+namespace
+{
+    const char sMagic[4] = { 'O', 'M', 'N', 'S' };
+
+    // Bump when NifOsg::Loader output or the header layout changes in a way the build fingerprint would not catch
+    const std::uint32_t sFormatVersion = 1;
+
+    const std::uint32_t sOsgVersion = OPENSCENEGRAPH_MAJOR_VERSION * 10000 + OPENSCENEGRAPH_MINOR_VERSION * 100
+        + OPENSCENEGRAPH_PATCH_VERSION;
+
+    const char sEntryExtension[] = ".bin";
+
+    template<typename T>
+    void append(std::string& buffer, const T& value)
+    {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /// Everything an entry has to match to be read, in the order it is written
+    std::string makeHeader(std::uint64_t fingerprint, const std::string& normalizedName, const VFS::FileStamp& stamp)
+    {
+        std::string buffer(sMagic, sizeof(sMagic));
+        append(buffer, sFormatVersion);
+        append(buffer, fingerprint);
+        append(buffer, sOsgVersion);
+        append(buffer, static_cast<std::uint8_t>(NifOsg::Loader::getShowMarkers()));
+        append(buffer, static_cast<std::uint32_t>(NifOsg::Loader::getHiddenNodeMask()));
+        append(buffer, static_cast<std::uint32_t>(NifOsg::Loader::getIntersectionDisabledNodeMask()));
+        append(buffer, stamp.mSize);
+        append(buffer, stamp.mTime);
+        append(buffer, static_cast<std::uint32_t>(normalizedName.size()));
+        buffer.append(normalizedName);
+        return buffer;
+    }
+
+    osgDB::ReaderWriter* getReaderWriter()
+    {
+        return osgDB::Registry::instance()->getReaderWriterForExtension("osgb");
+    }
+
+    bool isOsgClass(const osg::Object& object)
+    {
+        return std::strcmp(object.libraryName(), "osg") == 0;
+    }
+
+    bool isCacheableUserData(const osg::Object& object)
+    {
+        const osg::UserDataContainer* container = object.getUserDataContainer();
+        if (!container)
+            return true;
+
+        if (!isOsgClass(*container) || container->getUserData())
+            return false;
+
+        for (unsigned int i = 0; i < container->getNumUserObjects(); ++i)
+        {
+            const osg::Object* userObject = container->getUserObject(i);
+            if (userObject && !isOsgClass(*userObject))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool isCacheableAttribute(const osg::StateAttribute& attribute)
+    {
+        if (!isOsgClass(attribute) || attribute.getUpdateCallback() || attribute.getEventCallback()
+            || !isCacheableUserData(attribute))
+            return false;
+
+        // Images are written by name only, so they have to come from a file that can be read again
+        if (const osg::Texture* texture = attribute.asTexture())
+        {
+            for (unsigned int i = 0; i < texture->getNumImages(); ++i)
+            {
+                const osg::Image* image = texture->getImage(i);
+                if (!image || image->getFileName().empty())
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool isCacheableStateSet(const osg::StateSet* stateSet)
+    {
+        if (!stateSet)
+            return true;
+
+        if (!isOsgClass(*stateSet) || stateSet->getUpdateCallback() || stateSet->getEventCallback()
+            || !isCacheableUserData(*stateSet))
+            return false;
+
+        for (const auto& attribute : stateSet->getAttributeList())
+            if (!isCacheableAttribute(*attribute.second.first))
+                return false;
+
+        for (const auto& unit : stateSet->getTextureAttributeList())
+            for (const auto& attribute : unit)
+                if (!isCacheableAttribute(*attribute.second.first))
+                    return false;
+
+        for (const auto& uniform : stateSet->getUniformList())
+        {
+            const osg::Uniform& value = *uniform.second.first;
+            if (!isOsgClass(value) || value.getUpdateCallback() || value.getEventCallback())
+                return false;
+        }
+
+        return true;
+    }
+
+    bool isCacheableNode(const osg::Node& node)
+    {
+        const bool matrixTransform = std::strcmp(node.libraryName(), "NifOsg") == 0
+            && std::strcmp(node.className(), "MatrixTransform") == 0;
+
+        if ((!isOsgClass(node) && !matrixTransform)
+            || node.getUpdateCallback() || node.getCullCallback() || node.getEventCallback()
+            || node.getComputeBoundingSphereCallback())
+            return false;
+
+        if (const osg::Drawable* drawable = node.asDrawable())
+            if (drawable->getComputeBoundingBoxCallback() || drawable->getDrawCallback())
+                return false;
+
+        return isCacheableStateSet(node.getStateSet()) && isCacheableUserData(node);
+    }
+
+    class CacheableVisitor : public osg::NodeVisitor
+    {
+    public:
+        bool mCacheable = true;
+
+        CacheableVisitor()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+        {
+            // Hidden nodes are written too
+            setNodeMaskOverride(~0u);
+        }
+
+        void apply(osg::Node& node) override
+        {
+            if (!isCacheableNode(node))
+            {
+                mCacheable = false;
+                return;
+            }
+
+            traverse(node);
+        }
+    };
+}
+
+namespace Resource
+{
+
+    NifSceneCache::NifSceneCache(const boost::filesystem::path& path, std::uint64_t maxSize, std::uint64_t fingerprint)
+        : mPath(path)
+        , mMaxSize(maxSize)
+        , mFingerprint(fingerprint)
+        , mSize(0)
+    {
+        SceneUtil::registerCompleteSerializers();
+
+        try
+        {
+            boost::filesystem::create_directories(mPath);
+
+            for (boost::filesystem::directory_iterator it(mPath), end; it != end; ++it)
+            {
+                if (!boost::filesystem::is_regular_file(it->status()))
+                    continue;
+
+                // Left over by a run that did not finish writing
+                if (it->path().extension() == ".tmp")
+                    boost::filesystem::remove(it->path());
+                else if (it->path().extension() == sEntryExtension)
+                    mSize += boost::filesystem::file_size(it->path());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to open NIF scene cache " << mPath << ": " << e.what();
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mSize > mMaxSize)
+            evict();
+    }
+
+    boost::filesystem::path NifSceneCache::getEntryPath(const std::string& normalizedName) const
+    {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << Misc::hashFnv1a(normalizedName.data(), normalizedName.size())
+            << sEntryExtension;
+        return mPath / name.str();
+    }
+
+    osg::ref_ptr<osg::Node> NifSceneCache::read(const std::string& normalizedName, const VFS::FileStamp& stamp, const osgDB::Options* options)
+    {
+        // Scenes can not be read back with the stubs used for exporting them
+        if (SceneUtil::hasExportSerializers())
+            return nullptr;
+
+        osgDB::ReaderWriter* rw = getReaderWriter();
+        if (!rw)
+            return nullptr;
+
+        const boost::filesystem::path path = getEntryPath(normalizedName);
+        boost::iostreams::mapped_file_source file;
+
+        try
+        {
+            boost::system::error_code ec;
+            if (!boost::filesystem::exists(path, ec))
+                return nullptr;
+
+            file.open(path.string());
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Verbose) << "Failed to open cached scene " << path << ": " << e.what();
+            return nullptr;
+        }
+
+        // Also covers hash collisions, as the header holds the full name
+        const std::string header = makeHeader(mFingerprint, normalizedName, stamp);
+        std::uint64_t payloadSize;
+        if (file.size() < header.size() + sizeof(payloadSize) || std::memcmp(file.data(), header.data(), header.size()) != 0)
+            return nullptr;
+
+        std::memcpy(&payloadSize, file.data() + header.size(), sizeof(payloadSize));
+        const char* payload = file.data() + header.size() + sizeof(payloadSize);
+        if (payloadSize != static_cast<std::uint64_t>(file.data() + file.size() - payload))
+            return nullptr;
+
+        boost::iostreams::stream<boost::iostreams::array_source> stream(payload, static_cast<std::size_t>(payloadSize));
+        osgDB::ReaderWriter::ReadResult result = rw->readNode(stream, options);
+        if (!result.success() || !result.getNode())
+        {
+            Log(Debug::Warning) << "Failed to read cached scene " << path << " of " << normalizedName << ": " << result.message();
+            return nullptr;
+        }
+
+        osg::ref_ptr<osg::Node> node = result.getNode();
+
+        // Textures whose images could not be read again, the NIF loader has to decide what to use instead
+        if (!isCacheable(*node))
+            return nullptr;
+
+        // Mark the entry as recently used for evict()
+        boost::system::error_code ec;
+        boost::filesystem::last_write_time(path, std::time(nullptr), ec);
+
+        return node;
+    }
+
+    bool NifSceneCache::write(const std::string& normalizedName, const VFS::FileStamp& stamp, const osg::Node& node)
+    {
+        if (SceneUtil::hasExportSerializers() || !isCacheable(node))
+            return false;
+
+        osgDB::ReaderWriter* rw = getReaderWriter();
+        if (!rw)
+            return false;
+
+        osg::ref_ptr<osgDB::Options> options = new osgDB::Options;
+        options->setPluginStringData("fileType", "Binary");
+        options->setPluginStringData("WriteImageHint", "UseExternal");
+
+        std::ostringstream payload(std::ios::binary);
+        osgDB::ReaderWriter::WriteResult result = rw->writeNode(node, payload, options);
+        if (!result.success())
+        {
+            Log(Debug::Warning) << "Failed to write scene of " << normalizedName << " to cache: " << result.message();
+            return false;
+        }
+
+        std::string buffer = makeHeader(mFingerprint, normalizedName, stamp);
+        const std::string data = payload.str();
+        append(buffer, static_cast<std::uint64_t>(data.size()));
+        buffer.append(data);
+
+        if (buffer.size() > mMaxSize)
+            return false;
+
+        const boost::filesystem::path path = getEntryPath(normalizedName);
+        const boost::filesystem::path temp = mPath / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+
+        try
+        {
+            {
+                boost::filesystem::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+                stream.write(buffer.data(), buffer.size());
+                if (!stream)
+                    throw std::runtime_error("write failed");
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            boost::system::error_code ec;
+            std::uint64_t replaced = boost::filesystem::file_size(path, ec);
+            if (ec)
+                replaced = 0;
+
+            // Readers that still map the old file keep seeing it, the new one is only visible once complete
+            boost::filesystem::rename(temp, path);
+
+            mSize -= std::min(replaced, mSize);
+            mSize += buffer.size();
+            if (mSize > mMaxSize)
+                evict();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write scene of " << normalizedName << " to cache " << path << ": " << e.what();
+            boost::system::error_code ec;
+            boost::filesystem::remove(temp, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool NifSceneCache::isCacheable(const osg::Node& node)
+    {
+        CacheableVisitor visitor;
+        const_cast<osg::Node&>(node).accept(visitor);
+        return visitor.mCacheable;
+    }
+
+    std::uint64_t NifSceneCache::getSize() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSize;
+    }
+
+    void NifSceneCache::evict()
+    {
+        std::vector<std::tuple<std::time_t, std::uint64_t, boost::filesystem::path>> entries;
+        std::uint64_t size = 0;
+        boost::system::error_code ec;
+
+        for (boost::filesystem::directory_iterator it(mPath, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if (it->path().extension() != sEntryExtension)
+                continue;
+
+            boost::system::error_code entryEc;
+            const std::uint64_t entrySize = boost::filesystem::file_size(it->path(), entryEc);
+            const std::time_t time = boost::filesystem::last_write_time(it->path(), entryEc);
+            if (entryEc)
+                continue;
+
+            entries.emplace_back(time, entrySize, it->path());
+            size += entrySize;
+        }
+
+        std::sort(entries.begin(), entries.end());
+
+        for (const auto& entry : entries)
+        {
+            if (size <= mMaxSize)
+                break;
+
+            // Fails while another thread has the file mapped on some systems, it is tried again on the next eviction
+            boost::system::error_code removeEc;
+            if (boost::filesystem::remove(std::get<2>(entry), removeEc))
+                size -= std::get<1>(entry);
+        }
+
+        mSize = size;
+    }
+
+}
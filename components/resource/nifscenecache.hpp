@@ -0,0 +1,78 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_NIFSCENECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_NIFSCENECACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class Node;
+}
+
+namespace osgDB
+{
+    class Options;
+}
+
+namespace VFS
+{
+    struct FileStamp;
+}
+
+namespace Resource
+{
+
+    /// @brief Scene graphs converted from static NIF files, kept on disk between runs
+    /// @par Each NIF file gets one cache file holding the graph NifOsg::Loader made of it, in the osgb format.
+    /// The header in front of it names the NIF file and holds its size and modification time, the
+    /// loader settings and the build and OSG versions it was written with. An entry is only read
+    /// when all of them match, otherwise the NIF file has to be converted again.
+    /// @par Only graphs that the osg serializers can write completely are kept, i.e. no callbacks,
+    /// controllers, particles, skinning or OpenMW specific classes other than NifOsg::MatrixTransform,
+    /// and only textures that are loaded from a file. Images are referenced by name and read
+    /// through the given osgDB::Options.
+    /// @par The files are memory mapped for reading. When they take up more than the maximum size,
+    /// the least recently used ones are removed.
+    /// @note read() and write() may be called from any thread.
+    class NifSceneCache
+    {
+    public:
+        /// @param fingerprint Identifies the build, entries written by other builds are ignored.
+        NifSceneCache(const boost::filesystem::path& path, std::uint64_t maxSize, std::uint64_t fingerprint);
+
+        /// Read the graph converted from \a normalizedName, if it was written for a file with the same \a stamp.
+        /// @return nullptr if there is no usable entry.
+        osg::ref_ptr<osg::Node> read(const std::string& normalizedName, const VFS::FileStamp& stamp, const osgDB::Options* options);
+
+        /// Keep the graph converted from \a normalizedName, if it is cacheable.
+        /// @return Was an entry written?
+        bool write(const std::string& normalizedName, const VFS::FileStamp& stamp, const osg::Node& node);
+
+        /// Can \a node be written and read back without losing anything?
+        static bool isCacheable(const osg::Node& node);
+
+        /// Total size of the cache files in bytes.
+        std::uint64_t getSize() const;
+
+    private:
+        boost::filesystem::path mPath;
+        std::uint64_t mMaxSize;
+        std::uint64_t mFingerprint;
+
+        mutable std::mutex mMutex;
+        std::uint64_t mSize;
+
+        boost::filesystem::path getEntryPath(const std::string& normalizedName) const;
+
+        /// Remove the least recently used entries until they fit into mMaxSize. Called with mMutex locked.
+        void evict();
+    };
+
+}
+
+#endif
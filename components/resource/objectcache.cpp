@@ -0,0 +1,61 @@
+#include "objectcache.hpp"
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+
+namespace Resource
+{
+
+    namespace
+    {
+        // For objects we know nothing about, e.g. NIF files, keyframes and collision shapes
+        const std::size_t sDefaultObjectSize = 4096;
+
+        class SizeVisitor : public osg::NodeVisitor
+        {
+        public:
+            std::size_t mSize = 0;
+
+            SizeVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                mSize += sizeof(osg::Node);
+                traverse(node);
+            }
+
+            void apply(osg::Geometry& geometry) override
+            {
+                mSize += sizeof(osg::Geometry);
+
+                osg::Geometry::ArrayList arrays;
+                geometry.getArrayList(arrays);
+                for (const osg::ref_ptr<osg::Array>& array : arrays)
+                    mSize += array->getTotalDataSize();
+
+                for (unsigned int i = 0; i < geometry.getNumPrimitiveSets(); ++i)
+                    mSize += geometry.getPrimitiveSet(i)->getTotalDataSize();
+            }
+        };
+    }
+
+    std::size_t estimateObjectSize(const osg::Object* object)
+    {
+        if (const osg::Image* image = dynamic_cast<const osg::Image*>(object))
+            return image->getTotalSizeInBytesIncludingMipmaps();
+
+        if (const osg::Node* node = dynamic_cast<const osg::Node*>(object))
+        {
+            SizeVisitor visitor;
+            const_cast<osg::Node*>(node)->accept(visitor);
+            return visitor.mSize;
+        }
+
+        return sDefaultObjectSize;
+    }
+
+}
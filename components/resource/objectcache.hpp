@@ -3,6 +3,8 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - entries keep an estimated size, and unreferenced objects can be evicted oldest first to stay within a memory budget.
+// - hits, misses and evictions are counted.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -24,9 +26,13 @@
 #include <osg/ref_ptr>
 #include <osg/Node>
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace osg
 {
@@ -37,6 +43,22 @@ namespace osg
 
 namespace Resource {
 
+/// Rough number of bytes held by an object, used to keep the caches within a memory budget.
+/// @par Images count their pixel data and nodes the vertex and index data of their geometry. Textures
+/// referenced by nodes are left out, they are accounted for by the image cache.
+std::size_t estimateObjectSize(const osg::Object* object);
+
+struct CacheStats
+{
+    std::size_t mMemoryUsage = 0;
+    std::uint64_t mHits = 0;
+    std::uint64_t mMisses = 0;
+    std::uint64_t mEvictions = 0;
+};
+
+/// Time stamp and size of a cached object
+using CacheEntryUsage = std::pair<double, std::size_t>;
+
 template <typename KeyType>
 class GenericObjectCache : public osg::Referenced
 {
@@ -59,8 +81,8 @@ class GenericObjectCache : public osg::Referenced
             {
                 // If ref count is greater than 1, the object has an external reference.
                 // If the timestamp is yet to be initialized, it needs to be updated too.
-                if (itr->second.first->referenceCount()>1 || itr->second.second == 0.0)
-                    itr->second.second = referenceTime;
+                if (itr->second.object->referenceCount()>1 || itr->second.timeStamp == 0.0)
+                    itr->second.timeStamp = referenceTime;
             }
         }
 
@@ -77,9 +99,10 @@ class GenericObjectCache : public osg::Referenced
                 typename ObjectCacheMap::iterator oitr = _objectCache.begin();
                 while(oitr != _objectCache.end())
                 {
-                    if (oitr->second.second<=expiryTime)
+                    if (oitr->second.timeStamp<=expiryTime)
                     {
-                        objectsToRemove.push_back(oitr->second.first);
+                        objectsToRemove.push_back(oitr->second.object);
+                        _totalSize -= oitr->second.size;
                         _objectCache.erase(oitr++);
                     }
                     else
@@ -95,13 +118,22 @@ class GenericObjectCache : public osg::Referenced
         {
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             _objectCache.clear();
+            _totalSize = 0;
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
+        {
+            addEntryToObjectCache(key, object, timestamp, estimateObjectSize(object));
+        }
+
+        /** Add an object with a known size in bytes.*/
+        void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp, std::size_t size)
         {
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache[key]=ObjectTimeStampPair(object,timestamp);
+            CacheEntry& entry = _objectCache[key];
+            _totalSize += size - entry.size;
+            entry = CacheEntry {object, timestamp, size};
         }
 
         /** Remove Object from cache.*/
@@ -109,7 +141,11 @@ class GenericObjectCache : public osg::Referenced
         {
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end()) _objectCache.erase(itr);
+            if (itr!=_objectCache.end())
+            {
+                _totalSize -= itr->second.size;
+                _objectCache.erase(itr);
+            }
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
@@ -118,8 +154,12 @@ class GenericObjectCache : public osg::Referenced
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             typename ObjectCacheMap::iterator itr = _objectCache.find(key);
             if (itr!=_objectCache.end())
-                return itr->second.first;
-            else return nullptr;
+            {
+                ++_numHits;
+                return itr->second.object;
+            }
+            ++_numMisses;
+            return nullptr;
         }
 
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
@@ -129,7 +169,7 @@ class GenericObjectCache : public osg::Referenced
             typename ObjectCacheMap::iterator itr = _objectCache.find(key);
             if (itr!=_objectCache.end())
             {
-                itr->second.second = timeStamp;
+                itr->second.timeStamp = timeStamp;
                 return true;
             }
             else return false;
@@ -141,7 +181,7 @@ class GenericObjectCache : public osg::Referenced
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
             {
-                osg::Object* object = itr->second.first.get();
+                osg::Object* object = itr->second.object.get();
                 object->releaseGLObjects(state);
             }
         }
@@ -152,7 +192,7 @@ class GenericObjectCache : public osg::Referenced
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
             {
-                osg::Object* object = itr->second.first.get();
+                osg::Object* object = itr->second.object.get();
                 if (object)
                 {
                     osg::Node* node = dynamic_cast<osg::Node*>(object);
@@ -168,7 +208,7 @@ class GenericObjectCache : public osg::Referenced
         {
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             for (typename ObjectCacheMap::iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
-                f(it->first, it->second.first.get());
+                f(it->first, it->second.object.get());
         }
 
         /** Get the number of objects in the cache. */
@@ -178,16 +218,83 @@ class GenericObjectCache : public osg::Referenced
             return _objectCache.size();
         }
 
+        /** Get the estimated number of bytes held by the objects in the cache. */
+        std::size_t getCacheMemoryUsage() const
+        {
+            std::lock_guard<std::mutex> lock(_objectCacheMutex);
+            return _totalSize;
+        }
+
+        /** Add the time stamp and size of every object that nothing outside the cache references.
+          * Objects with uninitialized time stamp are left out. */
+        void getUnreferencedEntries(std::vector<CacheEntryUsage>& entries) const
+        {
+            std::lock_guard<std::mutex> lock(_objectCacheMutex);
+            for (typename ObjectCacheMap::const_iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
+            {
+                if (it->second.object->referenceCount() == 1 && it->second.timeStamp != 0.0)
+                    entries.emplace_back(it->second.timeStamp, it->second.size);
+            }
+        }
+
+        /** Remove objects that nothing outside the cache references and have a time stamp at or before the specified time,
+          * regardless of the expiry delay. Used to evict the least recently used objects when over the memory budget. */
+        void evictUnreferencedObjectsInCache(double maxTimeStamp)
+        {
+            std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            {
+                std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                typename ObjectCacheMap::iterator oitr = _objectCache.begin();
+                while(oitr != _objectCache.end())
+                {
+                    if (oitr->second.object->referenceCount() == 1 && oitr->second.timeStamp != 0.0
+                        && oitr->second.timeStamp <= maxTimeStamp)
+                    {
+                        objectsToRemove.push_back(oitr->second.object);
+                        _totalSize -= oitr->second.size;
+                        ++_numEvictions;
+                        _objectCache.erase(oitr++);
+                    }
+                    else
+                        ++oitr;
+                }
+            }
+            // note, actual unref happens outside of the lock
+            objectsToRemove.clear();
+        }
+
+        CacheStats getStats() const
+        {
+            std::lock_guard<std::mutex> lock(_objectCacheMutex);
+            CacheStats stats;
+            stats.mMemoryUsage = _totalSize;
+            stats.mHits = _numHits;
+            stats.mMisses = _numMisses;
+            stats.mEvictions = _numEvictions;
+            return stats;
+        }
+
     protected:
 
         virtual ~GenericObjectCache() {}
 
-        typedef std::pair<osg::ref_ptr<osg::Object>, double >           ObjectTimeStampPair;
-        typedef std::map<KeyType, ObjectTimeStampPair >             ObjectCacheMap;
+        struct CacheEntry
+        {
+            osg::ref_ptr<osg::Object> object;
+            double timeStamp = 0.0;
+            std::size_t size = 0;
+        };
+
+        typedef std::map<KeyType, CacheEntry >             ObjectCacheMap;
 
         ObjectCacheMap                          _objectCache;
         mutable std::mutex                      _objectCacheMutex;
 
+        std::size_t                             _totalSize = 0;
+        std::uint64_t                           _numHits = 0;
+        std::uint64_t                           _numMisses = 0;
+        std::uint64_t                           _numEvictions = 0;
+
 };
 
 class ObjectCache : public GenericObjectCache<std::string>
@@ -28,6 +28,12 @@ namespace Resource
         virtual void setExpiryDelay(double expiryDelay) {}
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const {}
         virtual void releaseGLObjects(osg::State* state) {}
+
+        /// Add the time stamp and size of every cached object that is not in use, see GenericObjectCache.
+        virtual void getUnreferencedCacheEntries(std::vector<CacheEntryUsage>& entries) const {}
+        /// Drop cached objects that are not in use and were last used at or before \a maxTimeStamp.
+        virtual void evictUnreferenced(double maxTimeStamp) {}
+        virtual CacheStats getCacheStats() const { return CacheStats(); }
     };
 
     /// @brief Base class for managers that require a virtual file system and object cache.
@@ -66,6 +72,12 @@ namespace Resource
 
         void releaseGLObjects(osg::State* state) override { mCache->releaseGLObjects(state); }
 
+        void getUnreferencedCacheEntries(std::vector<CacheEntryUsage>& entries) const override { mCache->getUnreferencedEntries(entries); }
+
+        void evictUnreferenced(double maxTimeStamp) override { mCache->evictUnreferencedObjectsInCache(maxTimeStamp); }
+
+        CacheStats getCacheStats() const override { return mCache->getStats(); }
+
     protected:
         const VFS::Manager* mVFS;
         osg::ref_ptr<CacheType> mCache;
@@ -2,6 +2,10 @@
 
 #include <algorithm>
 
+#include <osg/Stats>
+
+#include <components/bsa/compressedbsafile.hpp>
+
 #include "scenemanager.hpp"
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
@@ -12,6 +16,8 @@ namespace Resource
 
     ResourceSystem::ResourceSystem(const VFS::Manager *vfs)
         : mVFS(vfs)
+        , mMemoryBudget(0)
+        , mArchiveCacheBudget(Bsa::CompressedBSAFile::getCacheBudget())
     {
         mNifFileManager.reset(new NifFileManager(vfs));
         mImageManager.reset(new ImageManager(vfs));
@@ -62,10 +68,62 @@ namespace Resource
         mNifFileManager->setExpiryDelay(0.0);
     }
 
+    void ResourceSystem::setMemoryBudget(std::size_t bytes)
+    {
+        mMemoryBudget = bytes;
+        applyArchiveCacheBudget();
+    }
+
+    void ResourceSystem::setArchiveCacheBudget(std::size_t bytes)
+    {
+        mArchiveCacheBudget = bytes;
+        applyArchiveCacheBudget();
+    }
+
+    void ResourceSystem::applyArchiveCacheBudget()
+    {
+        // The decompressed files count against the memory budget too, so they may never use more than all of it
+        Bsa::CompressedBSAFile::setCacheBudget(mMemoryBudget != 0 ? std::min(mArchiveCacheBudget, mMemoryBudget) : mArchiveCacheBudget);
+    }
+
     void ResourceSystem::updateCache(double referenceTime)
     {
         for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end(); ++it)
             (*it)->updateCache(referenceTime);
+
+        if (mMemoryBudget != 0)
+            evictOverBudget();
+    }
+
+    void ResourceSystem::evictOverBudget()
+    {
+        // Decompressed archive files can't be evicted from here, their own budget keeps them in check
+        std::size_t usage = Bsa::CompressedBSAFile::getCacheSize();
+        for (const BaseResourceManager* manager : mResourceManagers)
+            usage += manager->getCacheStats().mMemoryUsage;
+        if (usage <= mMemoryBudget)
+            return;
+
+        std::vector<CacheEntryUsage> entries;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            manager->getUnreferencedCacheEntries(entries);
+        std::sort(entries.begin(), entries.end());
+
+        // Find the newest time stamp to evict, so that evicting everything used no later than it frees enough
+        double maxTimeStamp = 0.0;
+        for (const CacheEntryUsage& entry : entries)
+        {
+            if (usage <= mMemoryBudget)
+                break;
+            maxTimeStamp = entry.first;
+            usage -= std::min(usage, entry.second);
+        }
+
+        if (maxTimeStamp == 0.0)
+            return;
+
+        for (BaseResourceManager* manager : mResourceManagers)
+            manager->evictUnreferenced(maxTimeStamp);
     }
 
     void ResourceSystem::clearCache()
@@ -93,8 +151,24 @@ namespace Resource
 
     void ResourceSystem::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
+        CacheStats total;
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin(); it != mResourceManagers.end(); ++it)
+        {
             (*it)->reportStats(frameNumber, stats);
+
+            const CacheStats cacheStats = (*it)->getCacheStats();
+            total.mMemoryUsage += cacheStats.mMemoryUsage;
+            total.mHits += cacheStats.mHits;
+            total.mMisses += cacheStats.mMisses;
+            total.mEvictions += cacheStats.mEvictions;
+        }
+
+        total.mMemoryUsage += Bsa::CompressedBSAFile::getCacheSize();
+
+        stats->setAttribute(frameNumber, "Cache Memory", total.mMemoryUsage / double(1024 * 1024));
+        const std::uint64_t lookups = total.mHits + total.mMisses;
+        stats->setAttribute(frameNumber, "Cache HitRate", lookups == 0 ? 0.0 : 100.0 * total.mHits / lookups);
+        stats->setAttribute(frameNumber, "Cache Evictions", total.mEvictions);
     }
 
     void ResourceSystem::releaseGLObjects(osg::State *state)
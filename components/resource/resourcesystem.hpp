@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -56,6 +57,15 @@ namespace Resource
         /// How long to keep objects in cache after no longer being referenced.
         void setExpiryDelay(double expiryDelay);
 
+        /// Estimated number of bytes all resource managers together may keep cached. When updateCache() finds the
+        /// caches over budget, it drops the least recently used objects that are not in use, even if they have not
+        /// expired yet. 0 means no limit.
+        void setMemoryBudget(std::size_t bytes);
+
+        /// Number of bytes of decompressed files that compressed BSA archives keep around for repeated requests.
+        /// They count against the memory budget, which also caps them.
+        void setArchiveCacheBudget(std::size_t bytes);
+
         /// @note May be called from any thread.
         const VFS::Manager* getVFS() const;
 
@@ -76,6 +86,12 @@ namespace Resource
 
         const VFS::Manager* mVFS;
 
+        std::size_t mMemoryBudget;
+        std::size_t mArchiveCacheBudget;
+
+        void evictOverBudget();
+        void applyArchiveCacheBudget();
+
         ResourceSystem(const ResourceSystem&);
         void operator = (const ResourceSystem&);
     };
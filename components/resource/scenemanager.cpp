@@ -1,6 +1,7 @@
 #include "scenemanager.hpp"
 
 #include <cstdlib>
+#include <optional>
 
 #include <osg/Node>
 #include <osg/UserDataContainer>
@@ -19,6 +20,7 @@
 
 #include <components/misc/stringops.hpp>
 
+#include <components/vfs/archive.hpp>
 #include <components/vfs/manager.hpp>
 
 #include <components/sceneutil/clone.hpp>
@@ -32,6 +34,7 @@
 
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
+#include "nifscenecache.hpp"
 #include "objectcache.hpp"
 #include "multiobjectcache.hpp"
 
@@ -378,11 +381,33 @@ namespace Resource
         Resource::ImageManager* mImageManager;
     };
 
-    osg::ref_ptr<osg::Node> load (const std::string& normalizedFilename, const VFS::Manager* vfs, Resource::ImageManager* imageManager, Resource::NifFileManager* nifFileManager)
+    osg::ref_ptr<osg::Node> loadNif (const std::string& normalizedFilename, const VFS::Manager* vfs, Resource::ImageManager* imageManager, Resource::NifFileManager* nifFileManager,
+                                     Resource::NifSceneCache* nifSceneCache)
+    {
+        std::optional<VFS::FileStamp> stamp;
+        if (nifSceneCache)
+            stamp = vfs->getStamp(normalizedFilename);
+
+        if (stamp)
+        {
+            osg::ref_ptr<osgDB::Options> options (new osgDB::Options);
+            options->setReadFileCallback(new ImageReadCallback(imageManager));
+            if (osg::ref_ptr<osg::Node> cached = nifSceneCache->read(normalizedFilename, *stamp, options))
+                return cached;
+        }
+
+        osg::ref_ptr<osg::Node> loaded = NifOsg::Loader::load(nifFileManager->get(normalizedFilename), imageManager);
+        if (stamp)
+            nifSceneCache->write(normalizedFilename, *stamp, *loaded);
+        return loaded;
+    }
+
+    osg::ref_ptr<osg::Node> load (const std::string& normalizedFilename, const VFS::Manager* vfs, Resource::ImageManager* imageManager, Resource::NifFileManager* nifFileManager,
+                                  Resource::NifSceneCache* nifSceneCache)
     {
         std::string ext = Resource::getFileExtension(normalizedFilename);
         if (ext == "nif")
-            return NifOsg::Loader::load(nifFileManager->get(normalizedFilename), imageManager);
+            return loadNif(normalizedFilename, vfs, imageManager, nifFileManager, nifSceneCache);
         else
         {
             osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
@@ -533,7 +558,7 @@ namespace Resource
             osg::ref_ptr<osg::Node> loaded;
             try
             {
-                loaded = load(normalized, mVFS, mImageManager, mNifFileManager);
+                loaded = load(normalized, mVFS, mImageManager, mNifFileManager, mNifSceneCache.get());
             }
             catch (std::exception& e)
             {
@@ -545,7 +570,7 @@ namespace Resource
                     if (mVFS->exists(normalized))
                     {
                         Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error." << sMeshTypes[i] << " instead";
-                        loaded = load(normalized, mVFS, mImageManager, mNifFileManager);
+                        loaded = load(normalized, mVFS, mImageManager, mNifFileManager, mNifSceneCache.get());
                         break;
                     }
                 }
@@ -680,6 +705,11 @@ namespace Resource
         return mImageManager;
     }
 
+    void SceneManager::setNifSceneCache(std::unique_ptr<NifSceneCache> cache)
+    {
+        mNifSceneCache = std::move(cache);
+    }
+
     void SceneManager::setParticleSystemMask(unsigned int mask)
     {
         mParticleSystemMask = mask;
@@ -18,6 +18,7 @@ namespace Resource
 {
     class ImageManager;
     class NifFileManager;
+    class NifSceneCache;
     class SharedStateManager;
 }
 
@@ -164,6 +165,10 @@ namespace Resource
 
         Resource::ImageManager* getImageManager();
 
+        /// Keep scenes converted from static NIF files in \a cache and read them from it instead of converting them again.
+        /// @note Has to be called before any scenes are loaded.
+        void setNifSceneCache(std::unique_ptr<NifSceneCache> cache);
+
         /// @param mask The node mask to apply to loaded particle system nodes.
         void setParticleSystemMask(unsigned int mask);
 
@@ -210,6 +215,7 @@ namespace Resource
 
         Resource::ImageManager* mImageManager;
         Resource::NifFileManager* mNifFileManager;
+        std::unique_ptr<Resource::NifSceneCache> mNifSceneCache;
 
         osg::Texture::FilterMode mMinFilter;
         osg::Texture::FilterMode mMagFilter;
@@ -371,6 +371,11 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Compiling",
             "UnrefQueue",
             "WorkQueue",
+            "WorkQueue High",
+            "WorkQueue Wait",
+            "WorkQueue MaxWait",
+            "WorkQueue Stolen",
+            "WorkQueue Cancelled",
             "WorkThread",
             "",
             "Texture",
@@ -382,6 +387,9 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Image",
             "Nif",
             "Keyframe",
+            "Cache Memory",
+            "Cache HitRate",
+            "Cache Evictions",
             "",
             "Groundcover Chunk",
             "Object Chunk",
@@ -391,17 +399,31 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Composite",
             "",
             "NavMesh UpdateJobs",
+            "NavMesh CancelledJobs",
+            "NavMesh JobLatency",
+            "NavMesh JobMaxLatency",
             "NavMesh CacheSize",
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
             "NavMesh CacheHitRate",
+            "NavMesh DbSize",
+            "NavMesh DbTiles",
+            "NavMesh DbWrites",
+            "NavMesh DbHitRate",
             "",
             "Mechanics Actors",
             "Mechanics Objects",
+            "Mechanics FullRateActors",
+            "Mechanics ReducedRateActors",
+            "Mechanics HiddenActors",
             "",
             "Physics Actors",
             "Physics Objects",
             "Physics HeightFields",
+            "Physics LOS Cache",
+            "Physics LOS Hits",
+            "Physics LOS Misses",
+            "Physics LOS Raycasts",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
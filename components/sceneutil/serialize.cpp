@@ -1,6 +1,10 @@
 #include "serialize.hpp"
 
+#include <atomic>
+
+#include <osgDB/InputStream>
 #include <osgDB/ObjectWrapper>
+#include <osgDB/OutputStream>
 #include <osgDB/Registry>
 
 #include <components/nifosg/matrixtransform.hpp>
@@ -76,12 +80,57 @@ public:
     }
 };
 
+static bool checkMatrixTransformScale(const NifOsg::MatrixTransform&)
+{
+    return true;
+}
+
+static bool readMatrixTransformScale(osgDB::InputStream& is, NifOsg::MatrixTransform& node)
+{
+    is >> node.mScale;
+    return true;
+}
+
+static bool writeMatrixTransformScale(osgDB::OutputStream& os, const NifOsg::MatrixTransform& node)
+{
+    os << node.mScale << std::endl;
+    return true;
+}
+
+static bool checkMatrixTransformRotationScale(const NifOsg::MatrixTransform&)
+{
+    return true;
+}
+
+static bool readMatrixTransformRotationScale(osgDB::InputStream& is, NifOsg::MatrixTransform& node)
+{
+    is >> is.BEGIN_BRACKET;
+    for (int i = 0; i < 3; ++i)
+        is >> node.mRotationScale.mValues[i][0] >> node.mRotationScale.mValues[i][1] >> node.mRotationScale.mValues[i][2];
+    is >> is.END_BRACKET;
+    return true;
+}
+
+static bool writeMatrixTransformRotationScale(osgDB::OutputStream& os, const NifOsg::MatrixTransform& node)
+{
+    os << os.BEGIN_BRACKET << std::endl;
+    for (int i = 0; i < 3; ++i)
+        os << node.mRotationScale.mValues[i][0] << node.mRotationScale.mValues[i][1] << node.mRotationScale.mValues[i][2] << std::endl;
+    os << os.END_BRACKET << std::endl;
+    return true;
+}
+
 class MatrixTransformSerializer : public osgDB::ObjectWrapper
 {
 public:
     MatrixTransformSerializer()
-        : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::MatrixTransform>, "NifOsg::MatrixTransform", "osg::Object osg::Node osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
+        : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::MatrixTransform>, "NifOsg::MatrixTransform", "osg::Object osg::Node osg::Group osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
     {
+        // The separate scale and rotation are what keyframe controllers change, the matrix alone can not give them back
+        addSerializer( new osgDB::UserSerializer<NifOsg::MatrixTransform>(
+            "Scale", &checkMatrixTransformScale, &readMatrixTransformScale, &writeMatrixTransformScale), osgDB::BaseSerializer::RW_USER );
+        addSerializer( new osgDB::UserSerializer<NifOsg::MatrixTransform>(
+            "RotationScale", &checkMatrixTransformRotationScale, &readMatrixTransformRotationScale, &writeMatrixTransformRotationScale), osgDB::BaseSerializer::RW_USER );
     }
 };
 
@@ -99,19 +148,33 @@ public:
     }
 };
 
-void registerSerializers()
+static std::atomic<bool> sExportSerializers(false);
+
+void registerCompleteSerializers()
 {
     static bool done = false;
     if (!done)
     {
         osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
         mgr->addWrapper(new PositionAttitudeTransformSerializer);
+        mgr->addWrapper(new MatrixTransformSerializer);
+
+        done = true;
+    }
+}
+
+void registerSerializers()
+{
+    if (!sExportSerializers)
+    {
+        registerCompleteSerializers();
+
+        osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
         mgr->addWrapper(new SkeletonSerializer);
         mgr->addWrapper(new RigGeometrySerializer);
         mgr->addWrapper(new MorphGeometrySerializer);
         mgr->addWrapper(new LightManagerSerializer);
         mgr->addWrapper(new CameraRelativeTransformSerializer);
-        mgr->addWrapper(new MatrixTransformSerializer);
 
         // Don't serialize Geometry data as we are more interested in the overall structure rather than tons of vertex data that would make the file large and hard to read.
         mgr->removeWrapper(mgr->findWrapper("osg::Geometry"));
@@ -160,8 +223,13 @@ void registerSerializers()
         }
 
 
-        done = true;
+        sExportSerializers = true;
     }
 }
 
+bool hasExportSerializers()
+{
+    return sExportSerializers;
+}
+
 }
@@ -4,9 +4,17 @@
 namespace SceneUtil
 {
 
+    /// Register osg node serializers that write everything needed to read the node back, if not already done so
+    void registerCompleteSerializers();
+
     /// Register osg node serializers for certain SceneUtil classes if not already done so
+    /// @note Also registers stubs that leave out geometry data and unknown classes, so scenes written
+    /// afterwards can no longer be read back.
     void registerSerializers();
 
+    /// Have the stubs of registerSerializers() been registered?
+    bool hasExportSerializers();
+
 }
 
 #endif
@@ -1,12 +1,22 @@
 #include "workqueue.hpp"
 
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace SceneUtil
 {
 
+namespace
+{
+    // The queue of the work thread running on this thread, so items it adds stay with it
+    thread_local const WorkQueue* sCurrentQueue = nullptr;
+    thread_local std::size_t sCurrentThreadIndex = 0;
+}
+
 void WorkItem::waitTillDone()
 {
     if (mDone)
@@ -33,19 +43,39 @@ bool WorkItem::isDone() const
     return mDone;
 }
 
+void WorkItem::cancel()
+{
+    mCancelled = true;
+    abort();
+}
+
+bool WorkItem::isCancelled() const
+{
+    return mCancelled;
+}
+
 WorkQueue::WorkQueue(int workerThreads)
     : mIsReleased(false)
 {
+    const std::size_t numQueues = static_cast<std::size_t>(std::max(workerThreads, 1));
+    for (std::size_t i=0; i<numQueues; ++i)
+        mQueues.emplace_back(std::make_unique<Queue>());
+
     for (int i=0; i<workerThreads; ++i)
-        mThreads.emplace_back(std::make_unique<WorkThread>(*this));
+        mThreads.emplace_back(std::make_unique<WorkThread>(*this, i));
 }
 
 WorkQueue::~WorkQueue()
 {
+    for (const auto& queue : mQueues)
+    {
+        std::unique_lock<std::mutex> lock(queue->mMutex);
+        for (auto& items : queue->mItems)
+            items.clear();
+    }
+
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        while (!mQueue.empty())
-            mQueue.pop_back();
         mIsReleased = true;
         mCondition.notify_all();
     }
@@ -53,7 +83,7 @@ WorkQueue::~WorkQueue()
     mThreads.clear();
 }
 
-void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
+void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, Priority priority)
 {
     if (item->isDone())
     {
@@ -61,35 +91,111 @@ void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
         return;
     }
 
-    std::unique_lock<std::mutex> lock(mMutex);
-    if (front)
-        mQueue.push_front(item);
-    else
-        mQueue.push_back(item);
+    item->mQueued = std::chrono::steady_clock::now();
+
+    const std::size_t queueIndex = sCurrentQueue == this
+        ? sCurrentThreadIndex
+        : mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+    const std::size_t priorityIndex = static_cast<std::size_t>(priority);
+
+    {
+        Queue& queue = *mQueues[queueIndex];
+        std::unique_lock<std::mutex> lock(queue.mMutex);
+        queue.mItems[priorityIndex].push_back(std::move(item));
+        ++mNumItems[priorityIndex];
+    }
+
+    // Taking the lock orders this with a thread that just found no items and is about to wait
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+    }
     mCondition.notify_one();
 }
 
-osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
+void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
 {
-    std::unique_lock<std::mutex> lock(mMutex);
-    while (mQueue.empty() && !mIsReleased)
+    addWorkItem(std::move(item), front ? Priority::High : Priority::Normal);
+}
+
+osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem(std::size_t threadIndex)
+{
+    while (true)
     {
-        mCondition.wait(lock);
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (getTotalNumItems() == 0 && !mIsReleased)
+            {
+                mCondition.wait(lock);
+            }
+            if (mIsReleased)
+                return nullptr;
+        }
+
+        osg::ref_ptr<WorkItem> item = takeWorkItem(threadIndex);
+        if (!item)
+            continue; // another thread was faster
+
+        if (item->isCancelled())
+        {
+            ++mNumCancelled;
+            item->signalDone();
+            continue;
+        }
+
+        recordWait(*item);
+        return item;
     }
-    if (!mQueue.empty())
+}
+
+osg::ref_ptr<WorkItem> WorkQueue::takeWorkItem(std::size_t threadIndex)
+{
+    const std::size_t ownIndex = threadIndex % mQueues.size();
+    for (std::size_t priority = 0; priority < sNumPriorities; ++priority)
     {
-        osg::ref_ptr<WorkItem> item = mQueue.front();
-        mQueue.pop_front();
-        return item;
+        if (mNumItems[priority] == 0)
+            continue;
+
+        // Own queue first, then steal from the others
+        for (std::size_t i = 0; i < mQueues.size(); ++i)
+        {
+            Queue& queue = *mQueues[(ownIndex + i) % mQueues.size()];
+            std::unique_lock<std::mutex> lock(queue.mMutex);
+            auto& items = queue.mItems[priority];
+            if (items.empty())
+                continue;
+
+            osg::ref_ptr<WorkItem> item = std::move(items.front());
+            items.pop_front();
+            --mNumItems[priority];
+            if (i != 0)
+                ++mNumStolen;
+            return item;
+        }
     }
-    else
-        return nullptr;
+    return nullptr;
+}
+
+void WorkQueue::recordWait(const WorkItem& item)
+{
+    const std::uint64_t wait = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - item.mQueued).count();
+
+    ++mNumStarted;
+    mTotalWait += wait;
+
+    std::uint64_t max = mMaxWait;
+    while (wait > max && !mMaxWait.compare_exchange_weak(max, wait))
+        ;
+}
+
+std::size_t WorkQueue::getTotalNumItems() const
+{
+    return std::accumulate(mNumItems.begin(), mNumItems.end(), std::size_t(0));
 }
 
 unsigned int WorkQueue::getNumItems() const
 {
-    std::unique_lock<std::mutex> lock(mMutex);
-    return mQueue.size();
+    return static_cast<unsigned int>(getTotalNumItems());
 }
 
 unsigned int WorkQueue::getNumActiveThreads() const
@@ -98,8 +204,23 @@ unsigned int WorkQueue::getNumActiveThreads() const
         [] (auto r, const auto& t) { return r + t->isActive(); });
 }
 
-WorkThread::WorkThread(WorkQueue& workQueue)
+void WorkQueue::reportStats(unsigned int frameNumber, osg::Stats& stats)
+{
+    stats.setAttribute(frameNumber, "WorkQueue", getNumItems());
+    stats.setAttribute(frameNumber, "WorkQueue High", mNumItems[static_cast<std::size_t>(Priority::High)]);
+    stats.setAttribute(frameNumber, "WorkThread", getNumActiveThreads());
+
+    const std::uint64_t started = mNumStarted.exchange(0);
+    const std::uint64_t totalWait = mTotalWait.exchange(0);
+    stats.setAttribute(frameNumber, "WorkQueue Wait", started == 0 ? 0.0 : totalWait / 1000.0 / started);
+    stats.setAttribute(frameNumber, "WorkQueue MaxWait", mMaxWait.exchange(0) / 1000.0);
+    stats.setAttribute(frameNumber, "WorkQueue Stolen", mNumStolen.exchange(0));
+    stats.setAttribute(frameNumber, "WorkQueue Cancelled", mNumCancelled.exchange(0));
+}
+
+WorkThread::WorkThread(WorkQueue& workQueue, std::size_t index)
     : mWorkQueue(&workQueue)
+    , mIndex(index)
     , mActive(false)
     , mThread([this] { run(); })
 {
@@ -112,9 +233,12 @@ WorkThread::~WorkThread()
 
 void WorkThread::run()
 {
+    sCurrentQueue = mWorkQueue;
+    sCurrentThreadIndex = mIndex;
+
     while (true)
     {
-        osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
+        osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem(mIndex);
         if (!item)
             return;
         mActive = true;
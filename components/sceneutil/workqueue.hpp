@@ -4,11 +4,21 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
-#include <queue>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
 
 namespace SceneUtil
 {
@@ -30,52 +40,98 @@ namespace SceneUtil
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// Mark the work as no longer needed. If the item has not been started yet, the WorkQueue drops it
+        /// without calling doWork(), otherwise it is abort()ed. The item is signalled done either way.
+        void cancel();
+
+        bool isCancelled() const;
+
     private:
+        friend class WorkQueue;
+
         std::atomic_bool mDone {false};
+        std::atomic_bool mCancelled {false};
         std::mutex mMutex;
         std::condition_variable mCondition;
+        std::chrono::steady_clock::time_point mQueued;
     };
 
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @par Each thread has its own queue that added items are spread over, and threads that run out of work take
+    /// items from the others. Items are taken by priority first, and within a priority in the order they were added
+    /// to each queue, but since multiple queues and threads are involved a later item may start or complete first.
     class WorkQueue : public osg::Referenced
     {
     public:
+        enum class Priority
+        {
+            High,
+            Normal,
+            Low
+        };
+
         WorkQueue(int numWorkerThreads=1);
         ~WorkQueue();
 
         /// Add a new work item to the back of the queue.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
-        /// @param front If true, add item to the front of the queue. If false (default), add to the back.
-        void addWorkItem(osg::ref_ptr<WorkItem> item, bool front=false);
+        void addWorkItem(osg::ref_ptr<WorkItem> item, Priority priority=Priority::Normal);
+
+        /// @param front If true, add item with high priority, ahead of all normal and low priority items.
+        void addWorkItem(osg::ref_ptr<WorkItem> item, bool front);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
+        /// Get the next work item for the given thread, from its own queue or from another one.
+        /// If all queues are empty, waits until a new item is added.
         /// If the workqueue is in the process of being destroyed, may return nullptr.
         /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
+        osg::ref_ptr<WorkItem> removeWorkItem(std::size_t threadIndex);
 
         unsigned int getNumItems() const;
 
         unsigned int getNumActiveThreads() const;
 
+        /// Report queue depth and how long items waited to be started since the last report.
+        void reportStats(unsigned int frameNumber, osg::Stats& stats);
+
     private:
+        static constexpr std::size_t sNumPriorities = 3;
+
+        struct Queue
+        {
+            std::mutex mMutex;
+            std::array<std::deque<osg::ref_ptr<WorkItem>>, sNumPriorities> mItems;
+        };
+
         bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem> > mQueue;
+        std::vector<std::unique_ptr<Queue>> mQueues;
+        std::atomic<std::size_t> mNextQueue {0};
+
+        std::array<std::atomic<unsigned int>, sNumPriorities> mNumItems {};
+        std::atomic<unsigned int> mNumStolen {0};
+        std::atomic<unsigned int> mNumCancelled {0};
+        std::atomic<std::uint64_t> mNumStarted {0};
+        std::atomic<std::uint64_t> mTotalWait {0}; // microseconds
+        std::atomic<std::uint64_t> mMaxWait {0}; // microseconds
 
         mutable std::mutex mMutex;
         std::condition_variable mCondition;
 
         std::vector<std::unique_ptr<WorkThread>> mThreads;
+
+        std::size_t getTotalNumItems() const;
+
+        osg::ref_ptr<WorkItem> takeWorkItem(std::size_t threadIndex);
+
+        void recordWait(const WorkItem& item);
     };
 
     /// Internally used by WorkQueue.
     class WorkThread
     {
     public:
-        WorkThread(WorkQueue& workQueue);
+        WorkThread(WorkQueue& workQueue, std::size_t index);
 
         ~WorkThread();
 
@@ -83,6 +139,7 @@ namespace SceneUtil
 
     private:
         WorkQueue* mWorkQueue;
+        std::size_t mIndex;
         std::atomic<bool> mActive;
         std::thread mThread;
 
@@ -1,19 +1,39 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_ARCHIVE_H
 #define OPENMW_COMPONENTS_RESOURCE_ARCHIVE_H
 
+#include <cstdint>
 #include <map>
+#include <optional>
 
 #include <components/files/constrainedfilestream.hpp>
 
 namespace VFS
 {
 
+    /// Size and modification time of a file, for telling whether data derived from it is still current
+    struct FileStamp
+    {
+        std::uint64_t mSize;
+        std::int64_t mTime;
+    };
+
+    inline bool operator==(const FileStamp& lhs, const FileStamp& rhs)
+    {
+        return lhs.mSize == rhs.mSize && lhs.mTime == rhs.mTime;
+    }
+
     class File
     {
     public:
         virtual ~File() {}
 
         virtual Files::IStreamPtr open() = 0;
+
+        /// Do the expensive part of open() ahead of time, e.g. decompression. Does nothing by default.
+        virtual void prefetch() {}
+
+        /// Return the stamp of this file, if the archive can tell it cheaply.
+        virtual std::optional<FileStamp> getStamp() const { return std::nullopt; }
     };
 
     class Archive
@@ -2,6 +2,8 @@
 #include <components/bsa/compressedbsafile.hpp>
 #include <memory>
 
+#include <boost/filesystem/operations.hpp>
+
 namespace VFS
 {
 
@@ -10,7 +12,7 @@ BsaArchive::BsaArchive(const std::string &filename)
     Bsa::BsaVersion bsaVersion = Bsa::CompressedBSAFile::detectVersion(filename);
 
     if (bsaVersion == Bsa::BSAVER_COMPRESSED) {
-        mFile = std::make_unique<Bsa::CompressedBSAFile>(Bsa::CompressedBSAFile());
+        mFile = std::make_unique<Bsa::CompressedBSAFile>();
     }
     else {
         mFile = std::make_unique<Bsa::BSAFile>(Bsa::BSAFile());
@@ -70,4 +72,19 @@ Files::IStreamPtr BsaArchiveFile::open()
     return mFile->getFile(mInfo);
 }
 
+void BsaArchiveFile::prefetch()
+{
+    mFile->prefetch(mInfo);
+}
+
+std::optional<FileStamp> BsaArchiveFile::getStamp() const
+{
+    // Files inside an archive have no time of their own, any change to the archive counts
+    boost::system::error_code ec;
+    const std::time_t time = boost::filesystem::last_write_time(mFile->getFilename(), ec);
+    if (ec)
+        return std::nullopt;
+    return FileStamp {mInfo->fileSize, static_cast<std::int64_t>(time)};
+}
+
 }
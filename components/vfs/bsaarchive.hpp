@@ -14,6 +14,10 @@ namespace VFS
 
         Files::IStreamPtr open() override;
 
+        void prefetch() override;
+
+        std::optional<FileStamp> getStamp() const override;
+
         const Bsa::BSAFile::FileStruct* mInfo;
         Bsa::BSAFile* mFile;
     };
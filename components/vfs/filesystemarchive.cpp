@@ -75,4 +75,16 @@ namespace VFS
         return Files::openConstrainedFileStream(mPath.c_str());
     }
 
+    std::optional<FileStamp> FileSystemArchiveFile::getStamp() const
+    {
+        boost::system::error_code ec;
+        const boost::uintmax_t size = boost::filesystem::file_size(mPath, ec);
+        if (ec)
+            return std::nullopt;
+        const std::time_t time = boost::filesystem::last_write_time(mPath, ec);
+        if (ec)
+            return std::nullopt;
+        return FileStamp {static_cast<std::uint64_t>(size), static_cast<std::int64_t>(time)};
+    }
+
 }
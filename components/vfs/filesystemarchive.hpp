@@ -13,6 +13,8 @@ namespace VFS
 
         Files::IStreamPtr open() override;
 
+        std::optional<FileStamp> getStamp() const override;
+
     private:
         std::string mPath;
 
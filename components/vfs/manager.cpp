@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 
+#include <components/misc/hash.hpp>
 #include <components/misc/stringops.hpp>
 
 #include "archive.hpp"
@@ -19,12 +20,28 @@ namespace
         return ch == '\\' ? '/' : Misc::StringUtils::toLower(ch);
     }
 
+    char normalized_char(char ch)
+    {
+        return ch;
+    }
+
     void normalize_path(std::string& path, bool strict)
     {
         char (*normalize_char)(char) = strict ? &strict_normalize_char : &nonstrict_normalize_char;
         std::transform(path.begin(), path.end(), path.begin(), normalize_char);
     }
 
+    std::uint64_t hash_path(const std::string& path, char (*normalize_char)(char))
+    {
+        std::uint64_t hash = Misc::hashFnv1a(nullptr, 0);
+        for (char ch : path)
+        {
+            const char normalized = normalize_char(ch);
+            hash = Misc::hashFnv1a(&normalized, 1, hash);
+        }
+        return hash;
+    }
+
 }
 
 namespace VFS
@@ -44,6 +61,8 @@ namespace VFS
     void Manager::reset()
     {
         mIndex.clear();
+        mLookup.clear();
+        mLookupEntries.clear();
         for (std::vector<Archive*>::iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             delete *it;
         mArchives.clear();
@@ -60,30 +79,62 @@ namespace VFS
 
         for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             (*it)->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+
+        mLookup.clear();
+        mLookupEntries.clear();
+        mLookup.reserve(mIndex.size());
+        mLookupEntries.reserve(mIndex.size());
+
+        // The names in mIndex are unique and already normalized
+        for (auto it = mIndex.cbegin(); it != mIndex.cend(); ++it)
+        {
+            mLookup.insert(hash_path(it->first, &normalized_char), static_cast<std::uint32_t>(mLookupEntries.size()),
+                [] (std::uint32_t) { return false; });
+            mLookupEntries.push_back(it);
+        }
     }
 
-    Files::IStreamPtr Manager::get(const std::string &name) const
+    File* Manager::find(const std::string& name, char (*normalize)(char)) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        const std::uint32_t found = mLookup.find(hash_path(name, normalize), [&] (std::uint32_t index)
+        {
+            const std::string& key = mLookupEntries[index]->first;
+            if (key.size() != name.size())
+                return false;
+            for (std::size_t i = 0; i < name.size(); ++i)
+                if (key[i] != normalize(name[i]))
+                    return false;
+            return true;
+        });
+
+        if (found == Misc::HashIndex::sNotFound)
+            return nullptr;
+        return mLookupEntries[found]->second;
+    }
 
-        return getNormalized(normalized);
+    Files::IStreamPtr Manager::get(const std::string &name) const
+    {
+        File* file = find(name, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+        if (!file)
+        {
+            std::string normalized = name;
+            normalize_path(normalized, mStrict);
+            throw std::runtime_error("Resource '" + normalized + "' not found");
+        }
+        return file->open();
     }
 
     Files::IStreamPtr Manager::getNormalized(const std::string &normalizedName) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
+        File* file = find(normalizedName, &normalized_char);
+        if (!file)
             throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        return file->open();
     }
 
     bool Manager::exists(const std::string &name) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
-
-        return mIndex.find(normalized) != mIndex.end();
+        return find(name, mStrict ? &strict_normalize_char : &nonstrict_normalize_char) != nullptr;
     }
 
     const std::map<std::string, File*>& Manager::getIndex() const
@@ -96,6 +147,33 @@ namespace VFS
         normalize_path(name, mStrict);
     }
 
+    void Manager::prefetch(const std::vector<std::string>& names) const
+    {
+        for (const std::string& name : names)
+        {
+            File* file = find(name, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+            if (!file)
+                continue;
+
+            try
+            {
+                file->prefetch();
+            }
+            catch (const std::exception&)
+            {
+                // Reported when the file is actually opened
+            }
+        }
+    }
+
+    std::optional<FileStamp> Manager::getStamp(const std::string& normalizedName) const
+    {
+        File* file = find(normalizedName, &normalized_char);
+        if (!file)
+            return std::nullopt;
+        return file->getStamp();
+    }
+
     std::string Manager::getArchive(const std::string& name) const
     {
         std::string normalized = name;
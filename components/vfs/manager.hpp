@@ -3,14 +3,18 @@
 
 #include <components/files/constrainedfilestream.hpp>
 
+#include <components/misc/hashindex.hpp>
+
 #include <vector>
 #include <map>
+#include <optional>
 
 namespace VFS
 {
 
     class Archive;
     class File;
+    struct FileStamp;
 
     /// @brief The main class responsible for loading files from a virtual file system.
     /// @par Various archive types (e.g. directories on the filesystem, or compressed archives)
@@ -40,7 +44,7 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         bool exists(const std::string& name) const;
 
-        /// Get a complete list of files from all archives
+        /// Get a complete list of files from all archives, sorted by name for prefix enumeration
         /// @note May be called from any thread once the index has been built.
         const std::map<std::string, File*>& getIndex() const;
 
@@ -58,6 +62,15 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         Files::IStreamPtr getNormalized(const std::string& normalizedName) const;
 
+        /// Prepare the given files so that opening them later is cheap, e.g. by decompressing them
+        /// into the cache of a compressed archive. Files that can not be found are skipped.
+        /// @note May be called from any thread once the index has been built.
+        void prefetch(const std::vector<std::string>& names) const;
+
+        /// Get the stamp of a file (name is already normalized), if it exists and its archive can tell it.
+        /// @note May be called from any thread once the index has been built.
+        std::optional<FileStamp> getStamp(const std::string& normalizedName) const;
+
         std::string getArchive(const std::string& name) const;
     private:
         bool mStrict;
@@ -65,6 +78,13 @@ namespace VFS
         std::vector<Archive*> mArchives;
 
         std::map<std::string, File*> mIndex;
+
+        /// Hashes of the normalized names in mIndex, for lookups that neither copy nor compare whole names
+        Misc::HashIndex mLookup;
+        std::vector<std::map<std::string, File*>::const_iterator> mLookupEntries;
+
+        /// Find a file by name, normalizing it on the fly with \a normalize
+        File* find(const std::string& name, char (*normalize) (char)) const;
     };
 
 }